@@ -204,6 +204,16 @@ public:
      */
     ErrCode HeartBeatValueChanged(const std::string &tag, int32_t timesTamp);
 
+    /**
+     * @brief Get time spent in every standby state during a window of wall time.
+     *
+     * @param beginTime begin of the window, wall time in ms.
+     * @param endTime end of the window, wall time in ms.
+     * @param residency time spent in every state in ms, indexed by StandbyState.
+     * @return ErrCode ERR_OK if success, else fail.
+     */
+    ErrCode GetStateResidency(int64_t beginTime, int64_t endTime, std::vector<int64_t>& residency);
+
 private:
     bool GetStandbyServiceProxy();
     void ResetStandbyServiceClient();
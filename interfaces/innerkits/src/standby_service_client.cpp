@@ -241,6 +241,19 @@ ErrCode StandbyServiceClient::HeartBeatValueChanged(const std::string &tag, int3
     return standbyServiceProxy_->HeartBeatValueChanged(tag, timesTamp);
 }
 
+ErrCode StandbyServiceClient::GetStateResidency(int64_t beginTime, int64_t endTime, std::vector<int64_t>& residency)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!GetStandbyServiceProxy()) {
+        STANDBYSERVICE_LOGE("get standby service proxy failed");
+        return ERR_STANDBY_SERVICE_NOT_CONNECTED;
+    }
+    if (!residency.empty()) {
+        residency.clear();
+    }
+    return standbyServiceProxy_->GetStateResidency(beginTime, endTime, residency);
+}
+
 bool StandbyServiceClient::GetStandbyServiceProxy()
 {
     if (standbyServiceProxy_ != nullptr) {
@@ -29,6 +29,7 @@
 #include "standby_service_proxy.h"
 #include "standby_service_subscriber_stub.h"
 #include "standby_service_subscriber_proxy.h"
+#include "standby_state.h"
 
 using namespace testing::ext;
 
@@ -343,5 +344,18 @@ HWTEST_F(StandbyServiceClientUnitTest, StandbyServiceClientUnitTest_018, TestSiz
     EXPECT_EQ(subscriber->HandleOnRestrictListChanged(restrictListData), ERR_OK);
 }
 
+/**
+ * @tc.name: StandbyServiceClientUnitTest_019
+ * @tc.desc: test GetStateResidency.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyServiceClientUnitTest, StandbyServiceClientUnitTest_019, TestSize.Level1)
+{
+    std::vector<int64_t> residency {0};
+    EXPECT_EQ(StandbyServiceClient::GetInstance().GetStateResidency(0, INT64_MAX, residency), ERR_OK);
+    EXPECT_EQ(residency.size(), StandbyState::SLEEP + 1);
+}
+
 }  // namespace DevStandbyMgr
 }  // namespace OHOS
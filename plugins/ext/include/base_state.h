@@ -74,7 +74,8 @@ public:
     virtual ErrCode BeginState() = 0;
     virtual ErrCode EndState() = 0;
 
-    virtual bool CheckTransitionValid(uint32_t nextState) = 0;
+    // transitions allowed by STATE_TRANSITION_TABLE
+    virtual bool CheckTransitionValid(uint32_t nextState);
     virtual void EndEvalCurrentState(bool evalResult) = 0;
     virtual void StartTransitNextState(const std::shared_ptr<BaseState>& statePtr);
     virtual void TransitToPhase(uint32_t curPhase, uint32_t nextPhase);
@@ -84,7 +85,8 @@ public:
     virtual void ShellDump(const std::vector<std::string>& argsInStr, std::string& result);
 
     virtual void SetTimedTask(const std::string& timedTaskName, uint64_t timedTaskId);
-    virtual ErrCode StartStateTransitionTimer(int64_t triggerTime);
+    // the transition may be delayed by up to lateTolerance ms to share a wakeup with other timers
+    virtual ErrCode StartStateTransitionTimer(int64_t triggerTime, int64_t lateTolerance = 0);
     virtual ErrCode StopTimedTask(const std::string& timedTaskName);
     virtual void DestroyAllTimedTask();
 
@@ -109,6 +111,8 @@ class StateWithMaint {
 protected:
     virtual int64_t CalculateMaintTimeOut(const std::shared_ptr<IStateManagerAdapter>&
         stateManagerPtr, bool isFirstInterval);
+    // how late maintenance may start, a fraction of the interval before it
+    static int64_t GetMaintLateTolerance(int64_t maintIntervalTimeOut);
 protected:
     int32_t maintIntervalIndex_ {0};
     std::vector<int32_t> maintInterval_ {};
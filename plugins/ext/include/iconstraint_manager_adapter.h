@@ -19,6 +19,7 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "standby_messsage.h"
@@ -30,6 +31,27 @@ namespace OHOS {
 namespace DevStandbyMgr {
 struct ConstraintEvalParam;
 class IStateManagerAdapter;
+
+// how the results of the monitors registered for one transition make the result of the evaluation
+enum class ConstraintCombination : uint32_t {
+    // pass if every monitor passes, the evaluation ends at the first failure
+    ALL_PASS = 0,
+    // pass if any monitor passes, the evaluation ends at the first pass
+    ANY_PASS,
+};
+
+struct ConstraintMonitorEntry {
+    std::shared_ptr<IConstraintMonitor> monitor_ {nullptr};
+    // the monitor fails if it has not ended in timeout_ ms after it started, 0 for no timeout
+    int64_t timeout_ {0};
+};
+
+// monitors of one transition, which run at the same time
+struct ConstraintGroup {
+    ConstraintCombination combination_ {ConstraintCombination::ALL_PASS};
+    std::vector<ConstraintMonitorEntry> entries_ {};
+};
+
 class IConstraintManagerAdapter {
 public:
     virtual bool Init() = 0;
@@ -38,13 +60,30 @@ public:
     virtual ErrCode StopEvalution() = 0;
     virtual void RegisterConstraintCallback(const ConstraintEvalParam& params,
         const std::shared_ptr<IConstraintMonitor>& monitor) = 0;
+
+    /**
+     * @brief add a monitor to the transition of params, monitors of a transition are evaluated together.
+     *
+     * @param timeout in ms, the monitor fails if it has not ended in time, 0 for no timeout.
+     */
+    virtual void RegisterConstraintCallback(const ConstraintEvalParam& params,
+        const std::shared_ptr<IConstraintMonitor>& monitor, int64_t timeout) = 0;
+    virtual void SetConstraintCombination(const ConstraintEvalParam& params,
+        ConstraintCombination combination) = 0;
+
+    /**
+     * @brief called by a monitor of the current evaluation when it has a result, the monitor is stopped then.
+     * results of monitors which are not running are ignored.
+     */
+    virtual void EndEvalConstraint(const std::shared_ptr<IConstraintMonitor>& monitor, bool evalResult) = 0;
     virtual void ShellDump(const std::vector<std::string>& argsInStr, std::string& result) = 0;
     virtual ~IConstraintManagerAdapter() = default;
 protected:
     std::vector<std::shared_ptr<IConstraintMonitor>> constraintMonitorList_ {};
-    std::map<uint32_t, std::shared_ptr<IConstraintMonitor>> constraintMap_ {};
+    std::map<uint32_t, ConstraintGroup> constraintMap_ {};
     std::weak_ptr<IStateManagerAdapter> stateManager_ {};
-    std::shared_ptr<IConstraintMonitor> curMonitor_ {nullptr};
+    // monitors of the current evaluation which have started, monitor_ is reset once the monitor has ended
+    std::vector<ConstraintMonitorEntry> curMonitors_ {};
 };
 }  // namespace DevStandbyMgr
 }  // namespace OHOS
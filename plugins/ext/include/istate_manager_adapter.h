@@ -17,7 +17,6 @@
 
 #include <vector>
 #include <memory>
-#include <list>
 #include <utility>
 
 #include "event_handler.h"
@@ -25,12 +24,14 @@
 #include "standby_service_errors.h"
 #include "base_state.h"
 #include "istrategy_manager_adapter.h"
+#include "state_transition_table.h"
 
 namespace OHOS {
 namespace DevStandbyMgr {
 class IConstraintManagerAdapter;
 class BaseState;
 struct ConstraintEvalParam;
+
 class IStateManagerAdapter {
 public:
     virtual ~IStateManagerAdapter() = default;
@@ -56,6 +57,18 @@ public:
     bool IsScreenOn();
     virtual int64_t GetScreenOffTimeStamp();
     virtual bool IsScrOffHalfHourCtrl();
+
+    /**
+     * @brief set the event which starts the coming transition, it is recorded with the transition.
+     */
+    void SetTransitionTrigger(TransitionTrigger trigger);
+
+    /**
+     * @brief get time spent in every standby state during [beginTime, endTime) of wall time, in ms.
+     *
+     * @param residency indexed by StandbyState.
+     */
+    virtual ErrCode GetStateResidency(int64_t beginTime, int64_t endTime, std::vector<int64_t>& residency);
 protected:
     bool isEvalution_ {false};
     bool isBlocked_ {false};
@@ -68,10 +81,7 @@ protected:
     uint64_t scrOffHalfHourTimerId_ {0};
     bool isScreenOn_ {false};
     bool scrOffHalfHourCtrl_ {false};
-
-    // record the history of state transition, the element of stateRecordList_ is (state, timestamp of exit)
-    const uint32_t MAX_RECORD_SIZE = 10;
-    std::list<std::pair<uint32_t, int64_t>> stateRecordList_ {};
+    TransitionTrigger transitionTrigger_ {TransitionTrigger::UNKNOWN};
 };
 }  // namespace DevStandbyMgr
 }  // namespace OHOS
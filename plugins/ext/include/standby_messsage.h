@@ -59,6 +59,7 @@ struct StandbyMessageType {
         HEART_BEAT_VALUE_CHANGE, // heart beat value change
         AUDIO_RENDERER_CHANGE,
         AUDIO_CAPTURER_CHANGE,
+        APP_FOREGROUND_STATE_CHANGED, // application switch between foreground and background
     };
 };
 
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_PLUGINS_EXT_INCLUDE_STATE_TRANSITION_TABLE_H
+#define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_PLUGINS_EXT_INCLUDE_STATE_TRANSITION_TABLE_H
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "standby_state.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+enum class TransitionAction : uint8_t {
+    INVALID = 0,
+    // stay in current state, which is unblocked
+    UNBLOCK,
+    // enter or leave maintenance, no constraint is evaluated
+    WITH_MAINT,
+    // go to a deeper state after constraints are evaluated
+    ENTER_STANDBY,
+    // go back to a lighter state immediately
+    EXIT_STANDBY,
+};
+
+// event which started a state transition
+enum class TransitionTrigger : uint8_t {
+    UNKNOWN = 0,
+    // the service starts in working, the state recorded before it stopped lasted an unknown time
+    SERVICE_START,
+    // timer of the current state
+    TIMEOUT,
+    SCREEN_ON,
+    SCREEN_OFF,
+    CHARGING,
+    DISCHARGING,
+    USB_ATTACHED,
+    USB_DETACHED,
+    LID_OPEN,
+    USER_SLEEP,
+    FORCE_SLEEP,
+    DUMP,
+};
+
+constexpr uint32_t STANDBY_STATE_NUM = StandbyState::SLEEP + 1;
+
+constexpr std::array<std::string_view, STANDBY_STATE_NUM> STATE_NAMES = {
+    "working", "dark", "nap", "maintenance", "sleep"
+};
+
+constexpr std::array<std::string_view, NapStatePhase::END + 1> NAP_PHASE_NAMES = {
+    "connection", "sys_res_light", "app_res_light", "end"
+};
+
+constexpr std::array<std::string_view, SleepStatePhase::END + 1> SLEEP_PHASE_NAMES = {
+    "sys_res_deep", "app_res_deep", "app_res_hardware", "end"
+};
+
+constexpr std::array<std::string_view, static_cast<uint32_t>(TransitionAction::EXIT_STANDBY) + 1>
+    TRANSITION_ACTION_NAMES = {"invalid", "unblock", "with_maint", "enter_standby", "exit_standby"};
+
+constexpr std::array<std::string_view, static_cast<uint32_t>(TransitionTrigger::DUMP) + 1>
+    TRANSITION_TRIGGER_NAMES = {"unknown", "service_start", "timeout", "screen_on", "screen_off", "charging",
+        "discharging", "usb_attached", "usb_detached", "lid_open", "user_sleep", "force_sleep", "dump"};
+
+// row is the current state, column is the next state
+constexpr std::array<std::array<TransitionAction, STANDBY_STATE_NUM>, STANDBY_STATE_NUM> STATE_TRANSITION_TABLE = {{
+    // working
+    {{TransitionAction::UNBLOCK, TransitionAction::ENTER_STANDBY, TransitionAction::ENTER_STANDBY,
+        TransitionAction::INVALID, TransitionAction::ENTER_STANDBY}},
+    // dark
+    {{TransitionAction::EXIT_STANDBY, TransitionAction::UNBLOCK, TransitionAction::ENTER_STANDBY,
+        TransitionAction::INVALID, TransitionAction::ENTER_STANDBY}},
+    // nap
+    {{TransitionAction::EXIT_STANDBY, TransitionAction::EXIT_STANDBY, TransitionAction::UNBLOCK,
+        TransitionAction::WITH_MAINT, TransitionAction::ENTER_STANDBY}},
+    // maintenance
+    {{TransitionAction::WITH_MAINT, TransitionAction::INVALID, TransitionAction::WITH_MAINT,
+        TransitionAction::UNBLOCK, TransitionAction::WITH_MAINT}},
+    // sleep
+    {{TransitionAction::EXIT_STANDBY, TransitionAction::EXIT_STANDBY, TransitionAction::INVALID,
+        TransitionAction::WITH_MAINT, TransitionAction::UNBLOCK}},
+}};
+
+constexpr TransitionAction GetTransitionAction(uint32_t curState, uint32_t nextState)
+{
+    if (curState >= STANDBY_STATE_NUM || nextState >= STANDBY_STATE_NUM) {
+        return TransitionAction::INVALID;
+    }
+    return STATE_TRANSITION_TABLE[curState][nextState];
+}
+
+constexpr bool IsTransitionValid(uint32_t curState, uint32_t nextState)
+{
+    return GetTransitionAction(curState, nextState) != TransitionAction::INVALID;
+}
+
+constexpr std::string_view GetTransitionActionName(TransitionAction action)
+{
+    return TRANSITION_ACTION_NAMES[static_cast<uint32_t>(action)];
+}
+
+constexpr std::string_view GetTransitionTriggerName(TransitionTrigger trigger)
+{
+    auto index = static_cast<uint32_t>(trigger);
+    return index < TRANSITION_TRIGGER_NAMES.size() ? TRANSITION_TRIGGER_NAMES[index] : TRANSITION_TRIGGER_NAMES[0];
+}
+
+// the action of every valid transition must agree with the depth order of the states
+constexpr bool IsTransitionTableConsistent()
+{
+    for (uint32_t curState = 0; curState < STANDBY_STATE_NUM; ++curState) {
+        for (uint32_t nextState = 0; nextState < STANDBY_STATE_NUM; ++nextState) {
+            TransitionAction action = STATE_TRANSITION_TABLE[curState][nextState];
+            bool withMaint = curState != nextState && (curState == StandbyState::MAINTENANCE ||
+                nextState == StandbyState::MAINTENANCE);
+            if (action == TransitionAction::INVALID) {
+                continue;
+            }
+            if ((curState == nextState) != (action == TransitionAction::UNBLOCK) ||
+                withMaint != (action == TransitionAction::WITH_MAINT) ||
+                (action == TransitionAction::ENTER_STANDBY && curState > nextState) ||
+                (action == TransitionAction::EXIT_STANDBY && curState < nextState)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// every state must be able to go back to working, and maintenance is only entered from nap or sleep
+constexpr bool IsTransitionTableComplete()
+{
+    for (uint32_t curState = 0; curState < STANDBY_STATE_NUM; ++curState) {
+        if (!IsTransitionValid(curState, StandbyState::WORKING) || !IsTransitionValid(curState, curState)) {
+            return false;
+        }
+        if (curState != StandbyState::MAINTENANCE && IsTransitionValid(curState, StandbyState::MAINTENANCE) !=
+            (curState == StandbyState::NAP || curState == StandbyState::SLEEP)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(IsTransitionTableConsistent(), "action of standby state transition does not match the states");
+static_assert(IsTransitionTableComplete(), "standby state transition table misses a required transition");
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_PLUGINS_EXT_INCLUDE_STATE_TRANSITION_TABLE_H
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_PLUGINS_EXT_INCLUDE_STRATEGY_REGISTRY_H
+#define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_PLUGINS_EXT_INCLUDE_STRATEGY_REGISTRY_H
+
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ibase_strategy.h"
+#include "singleton.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+using StrategyCreator = std::function<std::shared_ptr<IBaseStrategy>()>;
+
+struct StrategyDescriptor {
+    // name used in strategy_list of device standby config
+    std::string name_ {""};
+    StrategyCreator creator_ {nullptr};
+    // bit (1 << eventId) of each consumed StandbyMessageType, 0 means all messages are consumed
+    uint64_t eventMask_ {0};
+    // system abilities the strategy calls, only for dump
+    std::vector<int32_t> dependentSaIds_ {};
+};
+
+/**
+ * factories of strategies, a strategy is constructed only when it is enabled in strategy_list.
+ * built-in strategies are registered by strategy manager, extension plugins may register their own
+ * before strategy manager is initialized.
+ */
+class StrategyRegistry {
+DECLARE_DELAYED_SINGLETON(StrategyRegistry);
+public:
+    static std::shared_ptr<StrategyRegistry> GetInstance();
+
+    /**
+     * @brief register factory of strategy, fails if name is empty or already registered.
+     */
+    bool RegisterStrategy(const StrategyDescriptor& descriptor);
+
+    void UnregisterStrategy(const std::string& name);
+
+    /**
+     * @brief construct a new strategy with registered factory.
+     *
+     * @param eventMask set to event mask of the strategy.
+     * @return nullptr if name is not registered.
+     */
+    std::shared_ptr<IBaseStrategy> CreateStrategy(const std::string& name, uint64_t& eventMask);
+
+    static uint64_t GetEventMask(std::initializer_list<uint32_t> eventIds);
+
+    static bool IsEventConsumed(uint64_t eventMask, uint32_t eventId);
+
+    void ShellDump(std::string& result);
+
+private:
+    StrategyRegistry(const StrategyRegistry&) = delete;
+    StrategyRegistry& operator= (const StrategyRegistry&) = delete;
+    StrategyRegistry(StrategyRegistry&&) = delete;
+    StrategyRegistry& operator= (StrategyRegistry&&) = delete;
+
+private:
+    std::mutex registryMutex_ {};
+    std::map<std::string, StrategyDescriptor> descriptorMap_ {};
+    std::map<std::string, uint32_t> createdCountMap_ {};
+};
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_PLUGINS_EXT_INCLUDE_STRATEGY_REGISTRY_H
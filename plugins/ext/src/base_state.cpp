@@ -15,14 +15,16 @@
 
 #include "base_state.h"
 
-#include "time_service_client.h"
+#include "standby_clock.h"
 
 #include "standby_messsage.h"
 #include "standby_service_log.h"
 #include "standby_config_manager.h"
+#include "state_transition_table.h"
 
 #include "istate_manager_adapter.h"
 #include "timed_task.h"
+#include "timer_multiplexer.h"
 #include "time_provider.h"
 #include "standby_service_impl.h"
 #include "standby_config_manager.h"
@@ -32,6 +34,8 @@ namespace OHOS {
 namespace DevStandbyMgr {
 namespace {
     constexpr int32_t MAX_DELAY_TIME_INTERVAL = 30 * 60 * 1000;
+    // maintenance may start up to a tenth of the interval late
+    constexpr int64_t MAINT_TOLERANCE_DIVISOR = 10;
 #ifdef STANDBY_FIREWALL_TIMER_NO_WAKEUP
     constexpr int32_t TIMER_TYPE_EXACT = 4;
 #endif
@@ -46,11 +50,11 @@ ErrCode BaseState::Init(const std::shared_ptr<BaseState>& statePtr)
 {
     auto callbackTask = [statePtr]() { statePtr->StartTransitNextState(statePtr); };
 #ifdef STANDBY_REALTIME_TIMER_ENABLE
-    enterStandbyTimerId_ = TimedTask::CreateTimer(false, 0, 1, callbackTask);
+    enterStandbyTimerId_ = TimerMultiplexer::GetInstance()->CreateTimer(false, 0, 1, callbackTask);
 #elif defined(STANDBY_FIREWALL_TIMER_NO_WAKEUP)
-    enterStandbyTimerId_ = TimedTask::CreateTimer(false, 0, TIMER_TYPE_EXACT, callbackTask);
+    enterStandbyTimerId_ = TimerMultiplexer::GetInstance()->CreateTimer(false, 0, TIMER_TYPE_EXACT, callbackTask);
 #else
-    enterStandbyTimerId_ = TimedTask::CreateTimer(false, 0, true, false, callbackTask);
+    enterStandbyTimerId_ = TimerMultiplexer::GetInstance()->CreateTimer(false, 0, true, false, callbackTask);
 #endif
     if (enterStandbyTimerId_ == 0) {
         STANDBYSERVICE_LOGE("%{public}s state init failed", STATE_NAME_LIST[GetCurState()].c_str());
@@ -76,9 +80,14 @@ uint32_t BaseState::GetCurInnerPhase()
     return curPhase_;
 }
 
+bool BaseState::CheckTransitionValid(uint32_t nextState)
+{
+    return IsTransitionValid(curState_, nextState);
+}
+
 void BaseState::StartTransitNextState(const std::shared_ptr<BaseState>& statePtr)
 {
-    handler_->PostTask([statePtr]() {
+    StandbyClock::GetInstance()->PostTask(handler_, [statePtr]() {
         STANDBYSERVICE_LOGD("due to timeout, try to enter %{public}s state from %{public}s",
             STATE_NAME_LIST[statePtr->nextState_].c_str(), STATE_NAME_LIST[statePtr->curState_].c_str());
         BaseState::AcquireStandbyRunningLock();
@@ -92,6 +101,7 @@ void BaseState::StartTransitNextState(const std::shared_ptr<BaseState>& statePtr
             STANDBYSERVICE_LOGW("state is in evalution, stop evalution and enter next state");
             stateManagerPtr->StopEvalution();
         }
+        stateManagerPtr->SetTransitionTrigger(TransitionTrigger::TIMEOUT);
         if (stateManagerPtr->TransitToState(statePtr->nextState_) != ERR_OK) {
             STANDBYSERVICE_LOGW("can not transit to state %{public}d, block current state", statePtr->nextState_);
             stateManagerPtr->BlockCurrentState();
@@ -145,11 +155,14 @@ void BaseState::SetTimedTask(const std::string& timedTaskName, uint64_t timedTas
     }
 }
 
-ErrCode BaseState::StartStateTransitionTimer(int64_t triggerTime)
+ErrCode BaseState::StartStateTransitionTimer(int64_t triggerTime, int64_t lateTolerance)
 {
-    if (enterStandbyTimerId_ == 0 || !MiscServices::TimeServiceClient::GetInstance()->
-        StartTimer(enterStandbyTimerId_, MiscServices::TimeServiceClient::GetInstance()->
-        GetWallTimeMs() + triggerTime)) {
+    if (enterStandbyTimerId_ != 0) {
+        TimerMultiplexer::GetInstance()->SetTimerTolerance(enterStandbyTimerId_, 0,
+            lateTolerance > 0 ? static_cast<uint64_t>(lateTolerance) : 0);
+    }
+    if (enterStandbyTimerId_ == 0 || !TimerMultiplexer::GetInstance()->StartTimer(enterStandbyTimerId_,
+        StandbyClock::GetInstance()->GetWallTimeMs() + triggerTime)) {
         STANDBYSERVICE_LOGE("%{public}s state set timed task failed", STATE_NAME_LIST[nextState_].c_str());
         return ERR_STANDBY_TIMER_SERVICE_ERROR;
     }
@@ -166,7 +179,7 @@ ErrCode BaseState::StopTimedTask(const std::string& timedTaskName)
         STANDBYSERVICE_LOGW("timedTask %{public}s not exist", timedTaskName.c_str());
         return ERR_STANDBY_TIMERID_NOT_EXIST;
     } else if (iter->second > 0) {
-        MiscServices::TimeServiceClient::GetInstance()->StopTimer(iter->second);
+        TimerMultiplexer::GetInstance()->StopTimer(iter->second);
     }
 
     return ERR_OK;
@@ -175,10 +188,9 @@ ErrCode BaseState::StopTimedTask(const std::string& timedTaskName)
 void BaseState::DestroyAllTimedTask()
 {
     for (auto& [timeTaskName, timerId] : timedTaskMap_) {
-        handler_->RemoveTask(timeTaskName);
+        StandbyClock::GetInstance()->RemoveTask(handler_, timeTaskName);
         if (timerId > 0) {
-            TimeServiceClient::GetInstance()->StopTimer(timerId);
-            TimeServiceClient::GetInstance()->DestroyTimer(timerId);
+            TimerMultiplexer::GetInstance()->DestroyTimer(timerId);
         }
     }
     timedTaskMap_.clear();
@@ -258,5 +270,10 @@ int64_t StateWithMaint::CalculateMaintTimeOut(const std::shared_ptr<IStateManage
     maintIntervalTimeOut *= TimeConstant::MSEC_PER_SEC;
     return maintIntervalTimeOut;
 }
+
+int64_t StateWithMaint::GetMaintLateTolerance(int64_t maintIntervalTimeOut)
+{
+    return maintIntervalTimeOut / MAINT_TOLERANCE_DIVISOR;
+}
 }  // namespace DevStandbyMgr
 }  // namespace OHOS
\ No newline at end of file
@@ -45,5 +45,15 @@ bool IStateManagerAdapter::IsScrOffHalfHourCtrl()
 {
     return scrOffHalfHourCtrl_;
 }
+
+void IStateManagerAdapter::SetTransitionTrigger(TransitionTrigger trigger)
+{
+    transitionTrigger_ = trigger;
+}
+
+ErrCode IStateManagerAdapter::GetStateResidency(int64_t beginTime, int64_t endTime, std::vector<int64_t>& residency)
+{
+    return ERR_STANDBY_OBJECT_NOT_EXIST;
+}
 }  // namespace DevStandbyMgr
 }  // namespace OHOS
\ No newline at end of file
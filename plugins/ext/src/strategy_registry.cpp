@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "strategy_registry.h"
+
+#include "standby_service_log.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+namespace {
+constexpr uint32_t MAX_EVENT_MASK_BITS = 64;
+}
+
+StrategyRegistry::StrategyRegistry() {}
+
+StrategyRegistry::~StrategyRegistry() {}
+
+std::shared_ptr<StrategyRegistry> StrategyRegistry::GetInstance()
+{
+    return DelayedSingleton<StrategyRegistry>::GetInstance();
+}
+
+bool StrategyRegistry::RegisterStrategy(const StrategyDescriptor& descriptor)
+{
+    if (descriptor.name_.empty() || !descriptor.creator_) {
+        STANDBYSERVICE_LOGE("invalid strategy descriptor");
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    if (!descriptorMap_.emplace(descriptor.name_, descriptor).second) {
+        STANDBYSERVICE_LOGW("strategy %{public}s is already registered", descriptor.name_.c_str());
+        return false;
+    }
+    return true;
+}
+
+void StrategyRegistry::UnregisterStrategy(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    descriptorMap_.erase(name);
+    createdCountMap_.erase(name);
+}
+
+std::shared_ptr<IBaseStrategy> StrategyRegistry::CreateStrategy(const std::string& name, uint64_t& eventMask)
+{
+    StrategyCreator creator {nullptr};
+    {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        auto iter = descriptorMap_.find(name);
+        if (iter == descriptorMap_.end()) {
+            return nullptr;
+        }
+        creator = iter->second.creator_;
+        eventMask = iter->second.eventMask_;
+        ++createdCountMap_[name];
+    }
+    // factory runs without lock, so that it may query the registry
+    return creator();
+}
+
+uint64_t StrategyRegistry::GetEventMask(std::initializer_list<uint32_t> eventIds)
+{
+    uint64_t eventMask {0};
+    for (auto eventId : eventIds) {
+        if (eventId < MAX_EVENT_MASK_BITS) {
+            eventMask |= 1ULL << eventId;
+        }
+    }
+    return eventMask;
+}
+
+bool StrategyRegistry::IsEventConsumed(uint64_t eventMask, uint32_t eventId)
+{
+    if (eventMask == 0 || eventId >= MAX_EVENT_MASK_BITS) {
+        return true;
+    }
+    return (eventMask & (1ULL << eventId)) != 0;
+}
+
+void StrategyRegistry::ShellDump(std::string& result)
+{
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    result.append("=================StrategyRegistry=================\n");
+    for (const auto& [name, descriptor] : descriptorMap_) {
+        auto iter = createdCountMap_.find(name);
+        result.append(name).append(" created: ")
+            .append(std::to_string(iter == createdCountMap_.end() ? 0 : iter->second))
+            .append(" event mask: ").append(std::to_string(descriptor.eventMask_))
+            .append(" dependent sa:");
+        for (auto saId : descriptor.dependentSaIds_) {
+            result.append(" ").append(std::to_string(saId));
+        }
+        result.append("\n");
+    }
+}
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
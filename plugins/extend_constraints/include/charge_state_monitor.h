@@ -18,6 +18,7 @@
 
 #include <memory>
 #include "iconstraint_monitor.h"
+#include "thread_pool.h"
 
 namespace OHOS {
 namespace DevStandbyMgr {
@@ -28,8 +29,14 @@ public:
     void StartMonitoring() override;
     void StopMonitoring() override;
 
+private:
+    // query the battery service on queryWorker_ if no charging event has been received yet
+    void QueryChargeState();
+
 private:
     std::shared_ptr<AppExecFwk::EventHandler> handler_ {nullptr};
+    ThreadPool queryWorker_ {"StandbyChargeQuery"};
+    bool isWorkerStarted_ {false};
 };
 } // DevStandbyMgr
 } // OHOS
@@ -34,10 +34,32 @@ public:
     ErrCode StopEvalution() override;
     void RegisterConstraintCallback(const ConstraintEvalParam& params, const std::shared_ptr<
         IConstraintMonitor>& monitor) override;
+    void RegisterConstraintCallback(const ConstraintEvalParam& params, const std::shared_ptr<
+        IConstraintMonitor>& monitor, int64_t timeout) override;
+    void SetConstraintCombination(const ConstraintEvalParam& params, ConstraintCombination combination) override;
+    void EndEvalConstraint(const std::shared_ptr<IConstraintMonitor>& monitor, bool evalResult) override;
     void ShellDump(const std::vector<std::string>& argsInStr, std::string& result) override;
 
+private:
+    // start the monitors one by one, stop if a monitor ends the evaluation meanwhile
+    void StartMonitors(std::vector<ConstraintMonitorEntry> entries);
+    void FinishEvalution(bool evalResult);
+    static std::string GetTimeoutTaskName(size_t index);
+    void DumpEvalution(std::string& result);
+
 private:
     bool isEvaluation_ {false};
+    std::shared_ptr<AppExecFwk::EventHandler> handler_ {nullptr};
+    ConstraintCombination curCombination_ {ConstraintCombination::ALL_PASS};
+    // monitors of the current evaluation which have not ended
+    size_t pendingCount_ {0};
+    uint32_t curEvalHash_ {0};
+    // monotonic time in ms
+    int64_t evalStartTime_ {0};
+    uint64_t evalCount_ {0};
+    bool lastEvalResult_ {false};
+    int64_t lastEvalDuration_ {0};
+    int64_t maxEvalDuration_ {0};
     std::shared_ptr<IConstraintMonitor> motionConstraint_ {nullptr};
     std::shared_ptr<IConstraintMonitor> repeatedMotionConstraint_ {nullptr};
 };
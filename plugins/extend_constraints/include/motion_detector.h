@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_PLUGINS_CONSTRAINTS_INCLUDE_MOTION_DETECTOR_H
+#define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_PLUGINS_CONSTRAINTS_INCLUDE_MOTION_DETECTOR_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "motion_energy.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+// value of motion_detector in detect_list
+enum class MotionDetectorType : int32_t {
+    ENERGY = 0,
+    VARIANCE,
+    JERK,
+    SIGNIFICANT_MOTION,
+    END,
+};
+
+/**
+ * decides from the accelerometer samples of one detection window whether the device moves. detectors depend on
+ * nothing but the samples, so that they also run in the offline evaluation tool.
+ */
+class IMotionDetector {
+public:
+    virtual ~IMotionDetector() = default;
+    virtual MotionDetectorType GetType() const = 0;
+    virtual std::string GetName() const = 0;
+
+    // the significant motion sensor is used alone if false
+    virtual bool UseAccelerometer() const
+    {
+        return true;
+    }
+
+    /**
+     * @brief start a detection window.
+     *
+     * @param threshold score above which the device moves, in the unit of the detector.
+     * @param isRepeatedDetection the short windows of repeated detection in sleep state.
+     */
+    virtual void Reset(double threshold, bool isRepeatedDetection) = 0;
+
+    /**
+     * @brief add samples of the window. previous is the sample before the batch, the first sample of the window
+     * when the batch starts the window.
+     */
+    virtual void AddSamples(const AccelSampleBatch& batch, const MotionVector& previous) = 0;
+    virtual double GetScore() const = 0;
+    virtual bool IsMotionDetected() const = 0;
+};
+
+/**
+ * @brief create a detector, nullptr if the type is unknown.
+ *
+ * @param samplingInterval interval between accelerometer samples in ns.
+ */
+std::unique_ptr<IMotionDetector> CreateMotionDetector(MotionDetectorType type, int64_t samplingInterval);
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_PLUGINS_CONSTRAINTS_INCLUDE_MOTION_DETECTOR_H
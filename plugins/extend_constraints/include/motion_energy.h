@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_PLUGINS_CONSTRAINTS_INCLUDE_MOTION_ENERGY_H
+#define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_PLUGINS_CONSTRAINTS_INCLUDE_MOTION_ENERGY_H
+
+#include <cstddef>
+
+namespace OHOS {
+namespace DevStandbyMgr {
+struct MotionVector {
+    float x_ {0};
+    float y_ {0};
+    float z_ {0};
+};
+
+// sums of samples shifted by an origin, from which the variance of each axis is computed
+struct MotionMoments {
+    static constexpr size_t AXIS_NUM = 3;
+    size_t count_ {0};
+    double sum_[AXIS_NUM] {};
+    double squareSum_[AXIS_NUM] {};
+};
+
+/**
+ * accelerometer samples kept as separate x, y and z arrays, so that the motion energy of a batch is computed by
+ * loops without dependency between samples, which the compiler vectorizes.
+ */
+class AccelSampleBatch {
+public:
+    static constexpr size_t CAPACITY = 64;
+
+    explicit AccelSampleBatch(size_t batchSize = CAPACITY);
+    void Add(float x, float y, float z);
+    void Clear();
+    bool Empty() const;
+    // batch size is reached, the batch should be processed before more samples are added
+    bool Full() const;
+    size_t Size() const;
+
+    /**
+     * @brief sum of squared differences between consecutive samples. the first sample is compared with previous,
+     * which is then set to the last sample.
+     */
+    double AccumulateEnergy(MotionVector& previous) const;
+
+    // add samples minus origin to moments, the origin keeps the sums of squares small against gravity
+    void AccumulateMoments(const MotionVector& origin, MotionMoments& moments) const;
+
+    // largest squared difference between consecutive samples, the first sample is compared with previous
+    float GetMaxSquaredDifference(const MotionVector& previous) const;
+
+    // the batch must not be empty
+    MotionVector GetLast() const;
+
+private:
+    size_t batchSize_ {CAPACITY};
+    size_t size_ {0};
+    alignas(16) float x_[CAPACITY] {};
+    alignas(16) float y_[CAPACITY] {};
+    alignas(16) float z_[CAPACITY] {};
+};
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_PLUGINS_CONSTRAINTS_INCLUDE_MOTION_ENERGY_H
@@ -16,6 +16,7 @@
 #ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_PLUGINS_CONSTRAINTS_INCLUDE_MOTION_SENSOR_CONSTRAINT_H
 #define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_PLUGINS_CONSTRAINTS_INCLUDE_MOTION_SENSOR_CONSTRAINT_H
 
+#include <atomic>
 #include <memory>
 #include <map>
 #include <functional>
@@ -25,6 +26,8 @@
 #include "sensor_agent_type.h"
 #include "iconstraint_monitor.h"
 #include "base_state.h"
+#include "motion_detector.h"
+#include "motion_energy.h"
 
 namespace OHOS {
 namespace DevStandbyMgr {
@@ -34,17 +37,38 @@ class MotionSensorMonitor : public IConstraintMonitor,
 public:
     MotionSensorMonitor(int32_t detectionTimeOut, int32_t restTimeOut, int32_t totalTimeOut,
         const ConstraintEvalParam& params);
+    ~MotionSensorMonitor() override;
     bool Init() override;
     void StartMonitoring() override;
     void StopMonitoring() override;
-    static double GetEnergy();
-    static void SetEnergy(double energy);
-    static void AddEnergy(AccelData *accelData);
+    // score of the motion detector in the current window
+    double GetScore() const;
+    void SetScore(double score);
+    void AddEnergy(AccelData *accelData);
+    // samples received while the monitor does not accept them, or after motion has been detected
+    uint64_t GetDroppedSampleCount() const;
+    // samples of events reported again, whose timestamp is not newer than that of the last event
+    uint64_t GetDuplicateSampleCount() const;
     static void MotionSensorCallback(SensorEvent *event);
     static void AcceleromterCallback(SensorEvent *event);
     static void RepeatAcceleromterCallback(SensorEvent *event);
 
 private:
+    // sensor callbacks carry no user data, events are dispatched to the monitor that is monitoring
+    static void DispatchSensorEvent(SensorEvent *event, void (MotionSensorMonitor::*handleEvent)(SensorEvent*));
+    void HandleAccelEvent(SensorEvent *event);
+    void HandleMotionEvent(SensorEvent *event);
+    void AddAccelSample(const AccelData& accelData);
+    // pass buffered samples to the detector, return true if it detects motion
+    bool ProcessAccelBatch();
+    // post the end of evaluation, at most once per evaluation
+    void PostMotionDetected();
+    // stop accepting samples and wait for sensor callbacks in progress, the caller then owns the samples
+    void PauseSampling();
+    // detector selected by motion_detector in detect_list, energy if it is unknown
+    void InitMotionDetector();
+    // threshold of the detector from detect_list, in the unit of its score
+    double ReadMotionThreshold() const;
     bool InitSensorUserMap(SensorInfo* sensorInfo, int32_t count);
     void AssignAcclerometerSensorCallBack();
     void AssignMotionSensorCallBack();
@@ -61,16 +85,30 @@ private:
     const int32_t restTimeOut_;
     const int32_t totalTimeOut_;
 
-    static double energy_;
-    static bool hasPrevAccelData_;
-    static AccelData previousAccelData_;
-    static AccelData currentAccelData_;
+    // score of detector_, written on the sensor thread while samples are accepted, otherwise on the handler thread
+    std::atomic<double> score_ {0};
+    // the detector and the samples below belong to the sensor thread while isAccepting_ is true
+    std::unique_ptr<IMotionDetector> detector_ {};
+    bool hasPrevAccelData_ {false};
+    MotionVector previousAccelData_ {};
+    int64_t lastTimestamp_ {0};
+    // samples waiting to be processed, filled from the sensor callback
+    AccelSampleBatch accelBatch_;
+    std::atomic<bool> isAccepting_ {false};
+    // set by the first motion of an evaluation
+    std::atomic<bool> isMotionDetected_ {false};
+    std::atomic<uint64_t> droppedSampleCount_ {0};
+    std::atomic<uint64_t> duplicateSampleCount_ {0};
     std::shared_ptr<AppExecFwk::EventHandler> handler_ {};
     ConstraintEvalParam params_{};
     bool isMonitoring_ {false};
 
     // key is sensor type, value is sensorUser with callback function pointer
     std::map<int32_t, SensorUser> sensorUserMap_ {};
+
+    static std::atomic<MotionSensorMonitor*> activeMonitor_;
+    // sensor callbacks running with the monitor loaded from activeMonitor_
+    static std::atomic<int32_t> activeCallbackCount_;
 };
 } // DevStandbyMgr
 } // OHOS
@@ -22,26 +22,52 @@
 
 namespace OHOS {
 namespace DevStandbyMgr {
+namespace {
+constexpr int32_t QUERY_WORKER_NUM = 1;
+}
+
 bool ChargeStateMonitor::Init()
 {
     auto &constraintManager = StandbyServiceImpl::GetInstance()->GetConstraintManager();
     ConstraintEvalParam params{StandbyState::WORKING, 0, StandbyState::DARK, 0};
     constraintManager->RegisterConstraintCallback(params, shared_from_this());
+    QueryChargeState();
     return true;
 }
 
+void ChargeStateMonitor::QueryChargeState()
+{
+    #ifdef STANDBY_BATTERY_MANAGER_ENABLE
+    if (DeviceStateCache::GetInstance()->GetChargeState() != ChargeState::UNKNOWN) {
+        return;
+    }
+    if (!isWorkerStarted_) {
+        if (queryWorker_.Start(QUERY_WORKER_NUM) != ERR_OK) {
+            STANDBYSERVICE_LOGE("failed to start charge state query worker");
+            return;
+        }
+        isWorkerStarted_ = true;
+    }
+    queryWorker_.AddTask([]() {
+        auto chargingStatus = PowerMgr::BatterySrvClient::GetInstance().GetChargingStatus();
+        bool isCharging = chargingStatus == PowerMgr::BatteryChargeState::CHARGE_STATE_ENABLE ||
+            chargingStatus == PowerMgr::BatteryChargeState::CHARGE_STATE_FULL;
+        if (DeviceStateCache::GetInstance()->InitChargeState(isCharging)) {
+            STANDBYSERVICE_LOGI("init charge state, isCharging: %{public}d", isCharging);
+        }
+    });
+    #endif
+}
+
 void ChargeStateMonitor::StartMonitoring()
 {
     bool res {true};
-    #ifdef STANDBY_BATTERY_MANAGER_ENABLE
-    auto chargingStatus = PowerMgr::BatterySrvClient::GetInstance().GetChargingStatus();
-    if (chargingStatus == PowerMgr::BatteryChargeState::CHARGE_STATE_ENABLE || chargingStatus ==
-        PowerMgr::BatteryChargeState::CHARGE_STATE_FULL) {
+    // kept by charging events, the battery service is not queried on the handler thread
+    if (DeviceStateCache::GetInstance()->GetChargeState() == ChargeState::CHARGING) {
         STANDBYSERVICE_LOGI("can not enter next state due to the charging status");
         res = false;
     }
-    #endif
-    StandbyServiceImpl::GetInstance()->GetStateManager()->EndEvalCurrentState(res);
+    StandbyServiceImpl::GetInstance()->GetConstraintManager()->EndEvalConstraint(shared_from_this(), res);
 }
 
 void ChargeStateMonitor::StopMonitoring()
@@ -14,6 +14,10 @@
  */
 
 #include "constraint_manager_adapter.h"
+
+#include <algorithm>
+#include <cinttypes>
+
 #include "standby_service_impl.h"
 #include "standby_service_log.h"
 #include "standby_config_manager.h"
@@ -22,9 +26,14 @@
 #endif
 #include "charge_state_monitor.h"
 #include "base_state.h"
+#include "standby_clock.h"
 
 namespace OHOS {
 namespace DevStandbyMgr {
+namespace {
+const std::string CONSTRAINT_TIMEOUT_TASK = "ConstraintTimeoutTask_";
+}
+
 bool ConstraintManagerAdapter::Init()
 {
     stateManager_ = StandbyServiceImpl::GetInstance()->GetStateManager();
@@ -32,6 +41,7 @@ bool ConstraintManagerAdapter::Init()
         STANDBYSERVICE_LOGI("constraint manager plugin initialization failed");
         return false;
     }
+    handler_ = StandbyServiceImpl::GetInstance()->GetHandler();
     constraintMonitorList_.emplace_back(std::make_shared<ChargeStateMonitor>());
     if (StandbyConfigManager::GetInstance()->GetStandbySwitch(DETECT_MOTION_CONFIG)) {
         #ifdef STANDBY_SENSORS_SENSOR_ENABLE
@@ -58,13 +68,18 @@ bool ConstraintManagerAdapter::Init()
 
 bool ConstraintManagerAdapter::UnInit()
 {
+    if (isEvaluation_) {
+        StopEvalution();
+    }
     constraintMonitorList_.clear();
     constraintMap_.clear();
     stateManager_.reset();
-    curMonitor_.reset();
+    curMonitors_.clear();
+    pendingCount_ = 0;
     isEvaluation_ = false;
     repeatedMotionConstraint_.reset();
     motionConstraint_.reset();
+    handler_.reset();
     return true;
 }
 
@@ -76,27 +91,49 @@ ErrCode ConstraintManagerAdapter::StartEvalution(const ConstraintEvalParam& para
     }
     STANDBYSERVICE_LOGD("start constraint evalution");
     isEvaluation_ = true;
-    uint32_t evalutionHash = params.GetHashValue();
-    auto iter = constraintMap_.find(evalutionHash);
-    if (iter == constraintMap_.end()) {
+    ++evalCount_;
+    curEvalHash_ = params.GetHashValue();
+    evalStartTime_ = StandbyClock::GetInstance()->GetMonotonicTimeMs();
+    auto iter = constraintMap_.find(curEvalHash_);
+    if (iter == constraintMap_.end() || iter->second.entries_.empty()) {
         STANDBYSERVICE_LOGD("constraint evalution is nullptr, pass");
-        curMonitor_ = nullptr;
-        auto stateManagerPtr = stateManager_.lock();
-        if (!stateManagerPtr) {
+        curMonitors_.clear();
+        pendingCount_ = 0;
+        if (stateManager_.expired()) {
             STANDBYSERVICE_LOGW("state manager is nullptr, can not end evalution");
             return ERR_STATE_MANAGER_IS_NULLPTR;
-        } else {
-            stateManagerPtr->EndEvalCurrentState(true);
-        }
-    } else {
-        curMonitor_ = iter->second;
-        if (curMonitor_) {
-            curMonitor_->StartMonitoring();
         }
+        FinishEvalution(true);
+        return ERR_OK;
     }
+    curCombination_ = iter->second.combination_;
+    curMonitors_.clear();
+    pendingCount_ = iter->second.entries_.size();
+    StartMonitors(iter->second.entries_);
     return ERR_OK;
 }
 
+void ConstraintManagerAdapter::StartMonitors(std::vector<ConstraintMonitorEntry> entries)
+{
+    uint64_t evalCount = evalCount_;
+    for (size_t index = 0; index < entries.size(); ++index) {
+        const ConstraintMonitorEntry& entry = entries[index];
+        curMonitors_.emplace_back(entry);
+        entry.monitor_->StartMonitoring();
+        // the monitor may end the evaluation at once, and the next evaluation may have started since
+        if (!isEvaluation_ || evalCount_ != evalCount) {
+            return;
+        }
+        if (curMonitors_[index].monitor_ == nullptr || entry.timeout_ <= 0) {
+            continue;
+        }
+        StandbyClock::GetInstance()->PostTask(handler_, [this, monitor = entry.monitor_]() {
+            STANDBYSERVICE_LOGW("constraint monitor timed out");
+            EndEvalConstraint(monitor, false);
+            }, GetTimeoutTaskName(index), entry.timeout_);
+    }
+}
+
 ErrCode ConstraintManagerAdapter::StopEvalution()
 {
     if (!isEvaluation_)  {
@@ -104,22 +141,117 @@ ErrCode ConstraintManagerAdapter::StopEvalution()
         return ERR_STANDBY_STATE_TIMING_SEQ_ERROR;
     }
     isEvaluation_ = false;
-    if (!curMonitor_) {
-        return ERR_OK;
+    std::vector<ConstraintMonitorEntry> monitors;
+    monitors.swap(curMonitors_);
+    pendingCount_ = 0;
+    for (size_t index = 0; index < monitors.size(); ++index) {
+        if (!monitors[index].monitor_) {
+            continue;
+        }
+        StandbyClock::GetInstance()->RemoveTask(handler_, GetTimeoutTaskName(index));
+        monitors[index].monitor_->StopMonitoring();
     }
-    curMonitor_->StopMonitoring();
-    curMonitor_ = nullptr;
     return ERR_OK;
 }
 
+void ConstraintManagerAdapter::EndEvalConstraint(const std::shared_ptr<IConstraintMonitor>& monitor,
+    bool evalResult)
+{
+    if (!isEvaluation_ || !monitor) {
+        STANDBYSERVICE_LOGD("no evalution is running, ignore the result of constraint monitor");
+        return;
+    }
+    auto iter = std::find_if(curMonitors_.begin(), curMonitors_.end(),
+        [&monitor](const ConstraintMonitorEntry& entry) { return entry.monitor_ == monitor; });
+    if (iter == curMonitors_.end()) {
+        STANDBYSERVICE_LOGD("constraint monitor is not running, ignore its result");
+        return;
+    }
+    size_t index = static_cast<size_t>(iter - curMonitors_.begin());
+    iter->monitor_ = nullptr;
+    --pendingCount_;
+    StandbyClock::GetInstance()->RemoveTask(handler_, GetTimeoutTaskName(index));
+    monitor->StopMonitoring();
+    STANDBYSERVICE_LOGD("constraint monitor %{public}zu ends with %{public}d after %{public}" PRId64 " ms", index,
+        evalResult, StandbyClock::GetInstance()->GetMonotonicTimeMs() - evalStartTime_);
+
+    // a failure decides all pass, and a pass decides any pass
+    bool isDecided = (curCombination_ == ConstraintCombination::ALL_PASS) ? !evalResult : evalResult;
+    if (isDecided || pendingCount_ == 0) {
+        FinishEvalution(evalResult);
+    }
+}
+
+void ConstraintManagerAdapter::FinishEvalution(bool evalResult)
+{
+    int64_t duration = StandbyClock::GetInstance()->GetMonotonicTimeMs() - evalStartTime_;
+    lastEvalResult_ = evalResult;
+    lastEvalDuration_ = duration;
+    maxEvalDuration_ = std::max(maxEvalDuration_, duration);
+    STANDBYSERVICE_LOGI("constraint evalution %{public}u ends with %{public}d in %{public}" PRId64 " ms, "
+        "%{public}zu monitors stopped", curEvalHash_, evalResult, duration, pendingCount_);
+
+    uint64_t evalCount = evalCount_;
+    auto stateManagerPtr = stateManager_.lock();
+    if (stateManagerPtr) {
+        // the state manager stops the evaluation
+        stateManagerPtr->EndEvalCurrentState(evalResult);
+    } else {
+        STANDBYSERVICE_LOGW("state manager is nullptr, can not end evalution");
+    }
+    if (isEvaluation_ && evalCount_ == evalCount) {
+        StopEvalution();
+    }
+}
+
+std::string ConstraintManagerAdapter::GetTimeoutTaskName(size_t index)
+{
+    return CONSTRAINT_TIMEOUT_TASK + std::to_string(index);
+}
+
 void ConstraintManagerAdapter::RegisterConstraintCallback(const ConstraintEvalParam& params,
     const std::shared_ptr<IConstraintMonitor>& monitor)
 {
-    constraintMap_.emplace(params.GetHashValue(), monitor);
+    RegisterConstraintCallback(params, monitor, 0);
+}
+
+void ConstraintManagerAdapter::RegisterConstraintCallback(const ConstraintEvalParam& params,
+    const std::shared_ptr<IConstraintMonitor>& monitor, int64_t timeout)
+{
+    if (!monitor) {
+        STANDBYSERVICE_LOGW("can not register nullptr constraint monitor");
+        return;
+    }
+    constraintMap_[params.GetHashValue()].entries_.emplace_back(ConstraintMonitorEntry {monitor,
+        std::max<int64_t>(timeout, 0)});
+}
+
+void ConstraintManagerAdapter::SetConstraintCombination(const ConstraintEvalParam& params,
+    ConstraintCombination combination)
+{
+    constraintMap_[params.GetHashValue()].combination_ = combination;
 }
 
 void ConstraintManagerAdapter::ShellDump(const std::vector<std::string>& argsInStr, std::string& result)
 {
+    if (!argsInStr.empty() && argsInStr[DUMP_FIRST_PARAM] == DUMP_DETAIL_INFO) {
+        DumpEvalution(result);
+    }
+}
+
+void ConstraintManagerAdapter::DumpEvalution(std::string& result)
+{
+    result.append("constraint evalution: ").append(isEvaluation_ ? "running" : "idle")
+        .append(", pending monitors: ").append(std::to_string(pendingCount_))
+        .append(", evalutions: ").append(std::to_string(evalCount_))
+        .append(", last result: ").append(std::to_string(lastEvalResult_))
+        .append(", last duration(ms): ").append(std::to_string(lastEvalDuration_))
+        .append(", max duration(ms): ").append(std::to_string(maxEvalDuration_)).append("\n");
+    for (const auto& [evalHash, group] : constraintMap_) {
+        result.append("  constraint ").append(std::to_string(evalHash)).append(": ")
+            .append(group.combination_ == ConstraintCombination::ALL_PASS ? "all" : "any")
+            .append(" of ").append(std::to_string(group.entries_.size())).append(" monitors\n");
+    }
 }
 }  // namespace DevStandbyMgr
 }  // namespace OHOS
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "motion_detector.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace OHOS {
+namespace DevStandbyMgr {
+namespace {
+// energy sums over the window, the windows of repeated detection are shorter
+constexpr double REPEATED_DETECTION_ENERGY_RATIO = 15;
+constexpr double NS_PER_SECOND = 1e9;
+
+// sum of squared differences between consecutive samples in (m/s^2)^2, the former only algorithm
+class EnergyMotionDetector : public IMotionDetector {
+public:
+    MotionDetectorType GetType() const override
+    {
+        return MotionDetectorType::ENERGY;
+    }
+
+    std::string GetName() const override
+    {
+        return "energy";
+    }
+
+    void Reset(double threshold, bool isRepeatedDetection) override
+    {
+        threshold_ = isRepeatedDetection ? threshold / REPEATED_DETECTION_ENERGY_RATIO : threshold;
+        energy_ = 0;
+    }
+
+    void AddSamples(const AccelSampleBatch& batch, const MotionVector& previous) override
+    {
+        MotionVector last = previous;
+        energy_ += batch.AccumulateEnergy(last);
+    }
+
+    double GetScore() const override
+    {
+        return energy_;
+    }
+
+    bool IsMotionDetected() const override
+    {
+        return energy_ > threshold_;
+    }
+
+private:
+    double threshold_ {0};
+    double energy_ {0};
+};
+
+/**
+ * sum of the variances of the three axes over the window in (m/s^2)^2. unlike energy it does not grow with the
+ * window, and it also catches a slow turn of the device, which changes the direction of gravity.
+ */
+class VarianceMotionDetector : public IMotionDetector {
+public:
+    MotionDetectorType GetType() const override
+    {
+        return MotionDetectorType::VARIANCE;
+    }
+
+    std::string GetName() const override
+    {
+        return "variance";
+    }
+
+    void Reset(double threshold, bool isRepeatedDetection) override
+    {
+        threshold_ = threshold;
+        moments_ = {};
+    }
+
+    void AddSamples(const AccelSampleBatch& batch, const MotionVector& previous) override
+    {
+        if (moments_.count_ == 0) {
+            origin_ = previous;
+        }
+        batch.AccumulateMoments(origin_, moments_);
+    }
+
+    double GetScore() const override
+    {
+        if (moments_.count_ < MIN_SAMPLE_NUM) {
+            return 0;
+        }
+        double count = static_cast<double>(moments_.count_);
+        double variance = 0;
+        for (size_t axis = 0; axis < MotionMoments::AXIS_NUM; ++axis) {
+            double mean = moments_.sum_[axis] / count;
+            variance += moments_.squareSum_[axis] / count - mean * mean;
+        }
+        return variance;
+    }
+
+    bool IsMotionDetected() const override
+    {
+        return GetScore() > threshold_;
+    }
+
+private:
+    static constexpr size_t MIN_SAMPLE_NUM = 2;
+    double threshold_ {0};
+    MotionVector origin_ {};
+    MotionMoments moments_ {};
+};
+
+// largest change of acceleration between two samples per second in m/s^3, reacts to a single shake
+class JerkMotionDetector : public IMotionDetector {
+public:
+    explicit JerkMotionDetector(int64_t samplingInterval)
+        : samplingInterval_(static_cast<double>(samplingInterval) / NS_PER_SECOND) {}
+
+    MotionDetectorType GetType() const override
+    {
+        return MotionDetectorType::JERK;
+    }
+
+    std::string GetName() const override
+    {
+        return "jerk";
+    }
+
+    void Reset(double threshold, bool isRepeatedDetection) override
+    {
+        threshold_ = threshold;
+        maxSquaredDiff_ = 0;
+    }
+
+    void AddSamples(const AccelSampleBatch& batch, const MotionVector& previous) override
+    {
+        maxSquaredDiff_ = std::max(maxSquaredDiff_, batch.GetMaxSquaredDifference(previous));
+    }
+
+    double GetScore() const override
+    {
+        return samplingInterval_ > 0 ? std::sqrt(maxSquaredDiff_) / samplingInterval_ : 0;
+    }
+
+    bool IsMotionDetected() const override
+    {
+        return GetScore() > threshold_;
+    }
+
+private:
+    // in s
+    const double samplingInterval_;
+    double threshold_ {0};
+    float maxSquaredDiff_ {0};
+};
+
+// only the significant motion sensor reports motion, the accelerometer stays off
+class SignificantMotionDetector : public IMotionDetector {
+public:
+    MotionDetectorType GetType() const override
+    {
+        return MotionDetectorType::SIGNIFICANT_MOTION;
+    }
+
+    std::string GetName() const override
+    {
+        return "significant_motion";
+    }
+
+    bool UseAccelerometer() const override
+    {
+        return false;
+    }
+
+    void Reset(double threshold, bool isRepeatedDetection) override {}
+
+    void AddSamples(const AccelSampleBatch& batch, const MotionVector& previous) override {}
+
+    double GetScore() const override
+    {
+        return 0;
+    }
+
+    bool IsMotionDetected() const override
+    {
+        return false;
+    }
+};
+}
+
+std::unique_ptr<IMotionDetector> CreateMotionDetector(MotionDetectorType type, int64_t samplingInterval)
+{
+    switch (type) {
+        case MotionDetectorType::ENERGY:
+            return std::make_unique<EnergyMotionDetector>();
+        case MotionDetectorType::VARIANCE:
+            return std::make_unique<VarianceMotionDetector>();
+        case MotionDetectorType::JERK:
+            return std::make_unique<JerkMotionDetector>(samplingInterval);
+        case MotionDetectorType::SIGNIFICANT_MOTION:
+            return std::make_unique<SignificantMotionDetector>();
+        default:
+            return nullptr;
+    }
+}
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "motion_energy.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace DevStandbyMgr {
+namespace {
+// partial sums added in parallel, a float reduction is only vectorized when its order is given by the code
+constexpr size_t LANE_NUM = 4;
+}
+
+AccelSampleBatch::AccelSampleBatch(size_t batchSize) : batchSize_(std::clamp<size_t>(batchSize, 1, CAPACITY)) {}
+
+void AccelSampleBatch::Add(float x, float y, float z)
+{
+    if (size_ >= CAPACITY) {
+        return;
+    }
+    x_[size_] = x;
+    y_[size_] = y;
+    z_[size_] = z;
+    ++size_;
+}
+
+void AccelSampleBatch::Clear()
+{
+    size_ = 0;
+}
+
+bool AccelSampleBatch::Empty() const
+{
+    return size_ == 0;
+}
+
+bool AccelSampleBatch::Full() const
+{
+    return size_ >= batchSize_;
+}
+
+size_t AccelSampleBatch::Size() const
+{
+    return size_;
+}
+
+double AccelSampleBatch::AccumulateEnergy(MotionVector& previous) const
+{
+    if (size_ == 0) {
+        return 0;
+    }
+    float dx = x_[0] - previous.x_;
+    float dy = y_[0] - previous.y_;
+    float dz = z_[0] - previous.z_;
+    float lanes[LANE_NUM] = {dx * dx + dy * dy + dz * dz, 0, 0, 0};
+    size_t index = 1;
+    for (; index + LANE_NUM <= size_; index += LANE_NUM) {
+        for (size_t lane = 0; lane < LANE_NUM; ++lane) {
+            float diffX = x_[index + lane] - x_[index + lane - 1];
+            float diffY = y_[index + lane] - y_[index + lane - 1];
+            float diffZ = z_[index + lane] - z_[index + lane - 1];
+            lanes[lane] += diffX * diffX + diffY * diffY + diffZ * diffZ;
+        }
+    }
+    for (; index < size_; ++index) {
+        float diffX = x_[index] - x_[index - 1];
+        float diffY = y_[index] - y_[index - 1];
+        float diffZ = z_[index] - z_[index - 1];
+        lanes[0] += diffX * diffX + diffY * diffY + diffZ * diffZ;
+    }
+    previous = GetLast();
+    double energy = 0;
+    for (const auto lane : lanes) {
+        energy += lane;
+    }
+    return energy;
+}
+
+void AccelSampleBatch::AccumulateMoments(const MotionVector& origin, MotionMoments& moments) const
+{
+    float sum[MotionMoments::AXIS_NUM] = {0, 0, 0};
+    float squareSum[MotionMoments::AXIS_NUM] = {0, 0, 0};
+    for (size_t index = 0; index < size_; ++index) {
+        float diffX = x_[index] - origin.x_;
+        float diffY = y_[index] - origin.y_;
+        float diffZ = z_[index] - origin.z_;
+        sum[0] += diffX;
+        sum[1] += diffY;
+        sum[2] += diffZ;
+        squareSum[0] += diffX * diffX;
+        squareSum[1] += diffY * diffY;
+        squareSum[2] += diffZ * diffZ;
+    }
+    moments.count_ += size_;
+    for (size_t axis = 0; axis < MotionMoments::AXIS_NUM; ++axis) {
+        moments.sum_[axis] += sum[axis];
+        moments.squareSum_[axis] += squareSum[axis];
+    }
+}
+
+float AccelSampleBatch::GetMaxSquaredDifference(const MotionVector& previous) const
+{
+    if (size_ == 0) {
+        return 0;
+    }
+    float dx = x_[0] - previous.x_;
+    float dy = y_[0] - previous.y_;
+    float dz = z_[0] - previous.z_;
+    float maxDiff = dx * dx + dy * dy + dz * dz;
+    for (size_t index = 1; index < size_; ++index) {
+        float diffX = x_[index] - x_[index - 1];
+        float diffY = y_[index] - y_[index - 1];
+        float diffZ = z_[index] - z_[index - 1];
+        maxDiff = std::max(maxDiff, diffX * diffX + diffY * diffY + diffZ * diffZ);
+    }
+    return maxDiff;
+}
+
+MotionVector AccelSampleBatch::GetLast() const
+{
+    return {x_[size_ - 1], y_[size_ - 1], z_[size_ - 1]};
+}
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
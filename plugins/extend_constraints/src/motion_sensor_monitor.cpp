@@ -15,10 +15,13 @@
 
 #include "motion_sensor_monitor.h"
 
+#include <cinttypes>
+#include <thread>
 #include <vector>
 #include <string>
 
 #include "istate_manager_adapter.h"
+#include "standby_clock.h"
 #include "standby_config_manager.h"
 #include "standby_service_impl.h"
 #include "standby_service_log.h"
@@ -26,22 +29,31 @@
 namespace OHOS {
 namespace DevStandbyMgr {
 namespace {
-    const int32_t COUNT_TIMES = 15;
     const int32_t MAX_COUNT_SENSOR = 200;
+    // variance and jerk thresholds in detect_list are integers in thousandths
+    constexpr double MOTION_THRESHOLD_SCALE = 1000;
+    constexpr int32_t DEFAULT_VARIANCE_THRESHOLD = 50;
+    constexpr int32_t DEFAULT_JERK_THRESHOLD = 3000;
+    // samples of one second at SENSOR_SAMPLING_RATE are processed together
+    constexpr size_t ACCEL_BATCH_SIZE = 5;
 }
 
-double MotionSensorMonitor::energy_ = 0;
-// use the difference between two acceleration data to judge the motion state
-// hasPrevAccelData_ is true if we has previous acceleration data to calculate the difference
-bool MotionSensorMonitor::hasPrevAccelData_ = false;
-AccelData MotionSensorMonitor::previousAccelData_ {0, 0, 0};
-AccelData MotionSensorMonitor::currentAccelData_ {0, 0, 0};
+std::atomic<MotionSensorMonitor*> MotionSensorMonitor::activeMonitor_ {nullptr};
+std::atomic<int32_t> MotionSensorMonitor::activeCallbackCount_ {0};
 
 MotionSensorMonitor::MotionSensorMonitor(int32_t detectionTimeOut, int32_t restTimeOut, int32_t totalTimeOut,
     const ConstraintEvalParam& params): detectionTimeOut_(detectionTimeOut), restTimeOut_(restTimeOut),
-    totalTimeOut_(totalTimeOut), params_(params)
+    totalTimeOut_(totalTimeOut), accelBatch_(ACCEL_BATCH_SIZE), params_(params)
 {
     handler_ = StandbyServiceImpl::GetInstance()->GetHandler();
+    detector_ = CreateMotionDetector(MotionDetectorType::ENERGY, SENSOR_SAMPLING_RATE);
+}
+
+MotionSensorMonitor::~MotionSensorMonitor()
+{
+    MotionSensorMonitor* monitor = this;
+    activeMonitor_.compare_exchange_strong(monitor, nullptr);
+    PauseSampling();
 }
 
 bool MotionSensorMonitor::CheckSersorUsable(SensorInfo *sensorInfo, int32_t count, int32_t sensorTypeId)
@@ -63,54 +75,124 @@ bool MotionSensorMonitor::CheckSersorUsable(SensorInfo *sensorInfo, int32_t coun
 
 void MotionSensorMonitor::AcceleromterCallback(SensorEvent *event)
 {
-    if (event == NULL) {
+    DispatchSensorEvent(event, &MotionSensorMonitor::HandleAccelEvent);
+}
+
+void MotionSensorMonitor::RepeatAcceleromterCallback(SensorEvent *event)
+{
+    // repeated detection differs in the threshold, which is lowered when monitoring starts
+    DispatchSensorEvent(event, &MotionSensorMonitor::HandleAccelEvent);
+}
+
+void MotionSensorMonitor::MotionSensorCallback(SensorEvent *event)
+{
+    DispatchSensorEvent(event, &MotionSensorMonitor::HandleMotionEvent);
+}
+
+void MotionSensorMonitor::DispatchSensorEvent(SensorEvent *event,
+    void (MotionSensorMonitor::*handleEvent)(SensorEvent*))
+{
+    // counted before the monitor is loaded, so that PauseSampling waits for this callback, see there
+    activeCallbackCount_.fetch_add(1);
+    MotionSensorMonitor* monitor = activeMonitor_.load();
+    if (monitor != nullptr) {
+        (monitor->*handleEvent)(event);
+    }
+    activeCallbackCount_.fetch_sub(1);
+}
+
+void MotionSensorMonitor::PauseSampling()
+{
+    // sequentially consistent with DispatchSensorEvent: either the callback finds isAccepting_ false, or it has
+    // been counted in activeCallbackCount_ before it is read here
+    isAccepting_.store(false);
+    while (activeCallbackCount_.load() != 0) {
+        std::this_thread::yield();
+    }
+}
+
+void MotionSensorMonitor::HandleAccelEvent(SensorEvent *event)
+{
+    if (event == nullptr || event->data == nullptr) {
         return;
     }
-    AccelData* sensorData = reinterpret_cast<AccelData*>(event->data);
-    MotionSensorMonitor::AddEnergy(sensorData);
-    STANDBYSERVICE_LOGD("sensor motion: %{public}lf, threshold: %{public}d", MotionSensorMonitor::GetEnergy(),
-        StandbyConfigManager::GetInstance()->GetStandbyParam(MOTION_THREADSHOLD));
-    if (MotionSensorMonitor::GetEnergy() > StandbyConfigManager::GetInstance()->
-            GetStandbyParam(MOTION_THREADSHOLD)) {
-        StandbyServiceImpl::GetInstance()->GetHandler()->PostTask([]() {
-            StandbyServiceImpl::GetInstance()->GetStateManager()->EndEvalCurrentState(false);
-            }, MOTION_DECTION_TASK);
+    // an event reported from the sensor fifo holds several samples
+    size_t count = event->dataLen / sizeof(AccelData);
+    if (!isAccepting_.load() || isMotionDetected_.load()) {
+        droppedSampleCount_.fetch_add(count, std::memory_order_relaxed);
+        return;
+    }
+    // a timestamp of 0 is not given by the sensor, such events are not checked
+    if (event->timestamp != 0 && event->timestamp <= lastTimestamp_) {
+        duplicateSampleCount_.fetch_add(count, std::memory_order_relaxed);
+        return;
+    }
+    lastTimestamp_ = event->timestamp;
+    const AccelData* samples = reinterpret_cast<AccelData*>(event->data);
+    bool isExceeded = false;
+    for (size_t index = 0; index < count; ++index) {
+        AddAccelSample(samples[index]);
+        if (accelBatch_.Full()) {
+            isExceeded = ProcessAccelBatch() || isExceeded;
+        }
+    }
+    if (isExceeded) {
+        PostMotionDetected();
     }
 }
 
-void MotionSensorMonitor::RepeatAcceleromterCallback(SensorEvent *event)
+void MotionSensorMonitor::HandleMotionEvent(SensorEvent *event)
 {
-    if (event == NULL) {
+    if (!isAccepting_.load()) {
+        droppedSampleCount_.fetch_add(1, std::memory_order_relaxed);
         return;
     }
-    STANDBYSERVICE_LOGD("periodly receive Acceleromter motion sensor callback");
-    AccelData* sensorData = reinterpret_cast<AccelData*>(event->data);
-    MotionSensorMonitor::AddEnergy(sensorData);
-    STANDBYSERVICE_LOGD("sensor motion: %{public}lf, threshold: %{public}lf", MotionSensorMonitor::GetEnergy(),
-        StandbyConfigManager::GetInstance()->GetStandbyParam(MOTION_THREADSHOLD) * 1.0 / COUNT_TIMES);
-    if (MotionSensorMonitor::GetEnergy() > StandbyConfigManager::GetInstance()->
-            GetStandbyParam(MOTION_THREADSHOLD) * 1.0 / COUNT_TIMES) {
-        StandbyServiceImpl::GetInstance()->GetHandler()->PostTask([]() {
-            StandbyServiceImpl::GetInstance()->GetStateManager()->EndEvalCurrentState(false);
-            }, MOTION_DECTION_TASK);
+    PostMotionDetected();
+}
+
+bool MotionSensorMonitor::ProcessAccelBatch()
+{
+    if (accelBatch_.Empty()) {
+        return false;
     }
+    detector_->AddSamples(accelBatch_, previousAccelData_);
+    previousAccelData_ = accelBatch_.GetLast();
+    accelBatch_.Clear();
+    double score = detector_->GetScore();
+    score_.store(score);
+    STANDBYSERVICE_LOGD("sensor motion: %{public}lf, detector: %{public}s", score, detector_->GetName().c_str());
+    return detector_->IsMotionDetected();
 }
 
-void MotionSensorMonitor::MotionSensorCallback(SensorEvent *event)
+void MotionSensorMonitor::AddAccelSample(const AccelData& accelData)
 {
-    StandbyServiceImpl::GetInstance()->GetHandler()->PostTask([]() {
-        StandbyServiceImpl::GetInstance()->GetStateManager()->EndEvalCurrentState(false);
+    if (!hasPrevAccelData_) {
+        // the first sample is compared with itself
+        hasPrevAccelData_ = true;
+        previousAccelData_ = {accelData.x, accelData.y, accelData.z};
+    }
+    accelBatch_.Add(accelData.x, accelData.y, accelData.z);
+}
+
+void MotionSensorMonitor::PostMotionDetected()
+{
+    // the accelerometer and the significant motion sensor may both report motion
+    if (isMotionDetected_.exchange(true)) {
+        return;
+    }
+    StandbyClock::GetInstance()->PostTask(handler_, [monitor = shared_from_this()]() {
+        StandbyServiceImpl::GetInstance()->GetConstraintManager()->EndEvalConstraint(monitor, false);
         }, MOTION_DECTION_TASK);
 }
 
-double MotionSensorMonitor::GetEnergy()
+double MotionSensorMonitor::GetScore() const
 {
-    return energy_;
+    return score_.load();
 }
 
-void MotionSensorMonitor::SetEnergy(double energy)
+void MotionSensorMonitor::SetScore(double score)
 {
-    energy_ = energy;
+    score_.store(score);
 }
 
 void MotionSensorMonitor::AddEnergy(AccelData *accelData)
@@ -118,14 +200,18 @@ void MotionSensorMonitor::AddEnergy(AccelData *accelData)
     if (accelData == nullptr) {
         return;
     }
-    currentAccelData_ = *accelData;
-    if (!hasPrevAccelData_) {
-        hasPrevAccelData_ = true;
-        previousAccelData_ = currentAccelData_;
-    }
-    AccelData diff {currentAccelData_.x - previousAccelData_.x, currentAccelData_.y - previousAccelData_.y,
-        currentAccelData_.z - previousAccelData_.z};
-    energy_ += (diff.x *  diff.x) + (diff.y *  diff.y) + (diff.z *  diff.z);
+    AddAccelSample(*accelData);
+    ProcessAccelBatch();
+}
+
+uint64_t MotionSensorMonitor::GetDroppedSampleCount() const
+{
+    return droppedSampleCount_.load(std::memory_order_relaxed);
+}
+
+uint64_t MotionSensorMonitor::GetDuplicateSampleCount() const
+{
+    return duplicateSampleCount_.load(std::memory_order_relaxed);
 }
 
 bool MotionSensorMonitor::Init()
@@ -138,6 +224,7 @@ bool MotionSensorMonitor::Init()
         return false;
     }
 
+    InitMotionDetector();
     if (!InitSensorUserMap(sensorInfo, count)) {
         STANDBYSERVICE_LOGE("do not find any usable sensor to detect motion");
         return false;
@@ -152,16 +239,47 @@ bool MotionSensorMonitor::Init()
     return true;
 }
 
+void MotionSensorMonitor::InitMotionDetector()
+{
+    int32_t type = StandbyConfigManager::GetInstance()->GetStandbyParam(MOTION_DETECTOR);
+    auto detector = CreateMotionDetector(static_cast<MotionDetectorType>(type), SENSOR_SAMPLING_RATE);
+    if (detector == nullptr) {
+        STANDBYSERVICE_LOGW("unknown motion detector %{public}d, use energy", type);
+        detector = CreateMotionDetector(MotionDetectorType::ENERGY, SENSOR_SAMPLING_RATE);
+    }
+    detector_ = std::move(detector);
+    STANDBYSERVICE_LOGI("motion detector is %{public}s", detector_->GetName().c_str());
+}
+
+double MotionSensorMonitor::ReadMotionThreshold() const
+{
+    auto readThreshold = [](const std::string& paramName, int32_t defaultValue) {
+        int32_t threshold = StandbyConfigManager::GetInstance()->GetStandbyParam(paramName);
+        return static_cast<double>(threshold > 0 ? threshold : defaultValue) / MOTION_THRESHOLD_SCALE;
+    };
+    switch (detector_->GetType()) {
+        case MotionDetectorType::VARIANCE:
+            return readThreshold(MOTION_VARIANCE_THRESHOLD, DEFAULT_VARIANCE_THRESHOLD);
+        case MotionDetectorType::JERK:
+            return readThreshold(MOTION_JERK_THRESHOLD, DEFAULT_JERK_THRESHOLD);
+        default:
+            return StandbyConfigManager::GetInstance()->GetStandbyParam(MOTION_THREADSHOLD);
+    }
+}
+
 bool MotionSensorMonitor::InitSensorUserMap(SensorInfo* sensorInfo, int32_t count)
 {
     if (sensorInfo == nullptr) {
         return false;
     }
     // use acceleromter sensor and significant motion sensor to check motion
-    const std::vector<int32_t> SENSOR_TYPE_CONFIG = {SENSOR_TYPE_ID_ACCELEROMETER, SENSOR_TYPE_ID_SIGNIFICANT_MOTION};
+    std::vector<int32_t> sensorTypes = {SENSOR_TYPE_ID_SIGNIFICANT_MOTION};
+    if (detector_->UseAccelerometer()) {
+        sensorTypes.emplace_back(SENSOR_TYPE_ID_ACCELEROMETER);
+    }
 
     STANDBYSERVICE_LOGI("InitSensorUserMap sensorInfo.size: %{public}d", count);
-    for (const auto sensorType : SENSOR_TYPE_CONFIG) {
+    for (const auto sensorType : sensorTypes) {
         if (CheckSersorUsable(sensorInfo, count, sensorType)) {
             sensorUserMap_.emplace(sensorType, SensorUser {});
         }
@@ -197,17 +315,24 @@ void MotionSensorMonitor::AssignMotionSensorCallBack()
 void MotionSensorMonitor::StartMonitoring()
 {
     STANDBYSERVICE_LOGD("start motion sensor monitoring");
-    handler_->PostTask([]() {
+    isMotionDetected_.store(false);
+    droppedSampleCount_.store(0, std::memory_order_relaxed);
+    duplicateSampleCount_.store(0, std::memory_order_relaxed);
+    StandbyClock::GetInstance()->PostTask(handler_, [monitor = shared_from_this()]() {
         STANDBYSERVICE_LOGI("stop motion sensor monitoring");
-        StandbyServiceImpl::GetInstance()->GetStateManager()->EndEvalCurrentState(true);
+        StandbyServiceImpl::GetInstance()->GetConstraintManager()->EndEvalConstraint(monitor, true);
         }, MOTION_DECTION_TASK, totalTimeOut_);
     PeriodlyStartMotionDetection();
 }
 
 void MotionSensorMonitor::StopMotionDetection()
 {
-    handler_->PostTask([monitor = shared_from_this()]() {
+    StandbyClock::GetInstance()->PostTask(handler_, [monitor = shared_from_this()]() {
         monitor->StopMonitoringInner();
+        // motion found in the samples left in the batch has not been reported yet
+        if (monitor->detector_->IsMotionDetected()) {
+            monitor->PostMotionDetected();
+        }
         }, MOTION_DECTION_TASK, detectionTimeOut_);
 }
 
@@ -219,15 +344,20 @@ void MotionSensorMonitor::PeriodlyStartMotionDetection()
         return;
     }
     StopMotionDetection();
-    handler_->PostTask([monitor = shared_from_this()]() {
+    StandbyClock::GetInstance()->PostTask(handler_, [monitor = shared_from_this()]() {
         monitor->PeriodlyStartMotionDetection();
         }, MOTION_DECTION_TASK, detectionTimeOut_ + restTimeOut_);
 }
 
 ErrCode MotionSensorMonitor::StartMonitoringInner()
 {
-    energy_ = 0;
+    score_.store(0);
+    // the threshold is read once here instead of for every sample
+    detector_->Reset(ReadMotionThreshold(), params_.isRepeatedDetection_);
     isMonitoring_ = true;
+    activeMonitor_.store(this);
+    // samples reset by the last StopSensor are handed to the sensor thread
+    isAccepting_.store(true);
     if (StartSensor() == ERR_OK) {
         return ERR_OK;
     }
@@ -239,8 +369,10 @@ ErrCode MotionSensorMonitor::StartMonitoringInner()
 
 void MotionSensorMonitor::StopMonitoring()
 {
-    handler_->RemoveTask(MOTION_DECTION_TASK);
+    StandbyClock::GetInstance()->RemoveTask(handler_, MOTION_DECTION_TASK);
     StopMonitoringInner();
+    STANDBYSERVICE_LOGI("stop motion sensor monitoring, dropped samples: %{public}" PRIu64 ", duplicate samples: "
+        "%{public}" PRIu64, GetDroppedSampleCount(), GetDuplicateSampleCount());
 }
 
 void MotionSensorMonitor::StopMonitoringInner()
@@ -269,20 +401,23 @@ ErrCode MotionSensorMonitor::StartSensor()
 
 void MotionSensorMonitor::StopSensor()
 {
-    hasPrevAccelData_ = false;
-    previousAccelData_ = {0, 0, 0};
-    if (!isMonitoring_) {
-        return;
-    }
-
-    for (const auto &[sensorTypeId, sensorUser] : sensorUserMap_) {
-        if (DeactivateSensor(sensorTypeId, &sensorUser) != 0) {
-            STANDBYSERVICE_LOGE("deactivate sensor failed for sensor ID %{public}d", sensorTypeId);
-        }
-        if (UnsubscribeSensor(sensorTypeId, &sensorUser) != 0) {
-            STANDBYSERVICE_LOGE("unsubscribe sensor failed for sensor ID %{public}d", sensorTypeId);
+    if (isMonitoring_) {
+        for (const auto &[sensorTypeId, sensorUser] : sensorUserMap_) {
+            if (DeactivateSensor(sensorTypeId, &sensorUser) != 0) {
+                STANDBYSERVICE_LOGE("deactivate sensor failed for sensor ID %{public}d", sensorTypeId);
+            }
+            if (UnsubscribeSensor(sensorTypeId, &sensorUser) != 0) {
+                STANDBYSERVICE_LOGE("unsubscribe sensor failed for sensor ID %{public}d", sensorTypeId);
+            }
         }
+        PauseSampling();
+        // the sensor does not report any more, samples left in the batch still count
+        ProcessAccelBatch();
     }
+    accelBatch_.Clear();
+    hasPrevAccelData_ = false;
+    previousAccelData_ = {};
+    lastTimestamp_ = 0;
 }
 } // DevStandbyMgr
 } // OHOS
\ No newline at end of file
@@ -27,7 +27,6 @@ public:
         std::shared_ptr<AppExecFwk::EventHandler>& handler);
     ErrCode BeginState() override;
     ErrCode EndState() override;
-    bool CheckTransitionValid(uint32_t nextState) override;
     void EndEvalCurrentState(bool evalResult) override;
 private:
     int32_t darkTimeOut_ {0};
@@ -25,7 +25,6 @@ using BaseState::BaseState;
 public:
     ErrCode BeginState() override;
     ErrCode EndState() override;
-    bool CheckTransitionValid(uint32_t nextState) override;
     void EndEvalCurrentState(bool evalResult) override;
 };
 }  // namespace DevStandbyMgr
@@ -26,7 +26,6 @@ public:
         stateManager, std::shared_ptr<AppExecFwk::EventHandler>& handler);
     ErrCode BeginState() override;
     ErrCode EndState() override;
-    bool CheckTransitionValid(uint32_t nextState) override;
     void EndEvalCurrentState(bool evalResult) override;
     void OnStateBlocked() override;
 protected:
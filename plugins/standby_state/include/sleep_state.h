@@ -28,7 +28,6 @@ public:
     ErrCode UnInit() override;
     ErrCode BeginState() override;
     ErrCode EndState() override;
-    bool CheckTransitionValid(uint32_t nextState) override;
     void EndEvalCurrentState(bool evalResult) override;
     void ShellDump(const std::vector<std::string>& argsInStr, std::string& result) override;
 protected:
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_PLUGINS_STANDBY_STATE_INCLUDE_STATE_HISTORY_H
+#define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_PLUGINS_STANDBY_STATE_INCLUDE_STATE_HISTORY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+
+#include "state_transition_table.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+struct StateHistoryRecord {
+    // wall time of the transition, in ms, kept across reboot
+    int64_t wallTime_ {0};
+    // monotonic time of the transition, in ms
+    int64_t monotonicTime_ {0};
+    uint8_t preState_ {0};
+    uint8_t curState_ {0};
+    // phase the previous state was left in, and phase the current state begins with
+    uint8_t prePhase_ {0};
+    uint8_t curPhase_ {0};
+    // TransitionAction of STATE_TRANSITION_TABLE
+    uint8_t action_ {0};
+    // TransitionTrigger which started the transition
+    uint8_t trigger_ {0};
+    uint8_t reserved_[2] {};
+};
+static_assert(std::is_trivially_copyable_v<StateHistoryRecord> && sizeof(StateHistoryRecord) == 24,
+    "layout of StateHistoryRecord is persisted");
+
+// time spent in every standby state, in ms
+using StateResidency = std::array<int64_t, STANDBY_STATE_NUM>;
+
+/**
+ * fixed-size ring buffer of state transitions, mapped from a file so that it survives restarts of the service
+ * and of the device. records are written in place without allocation. if the file can not be mapped, records
+ * are kept in memory allocated once in Init.
+ */
+class StateHistory {
+public:
+    StateHistory() = default;
+    ~StateHistory();
+    StateHistory(const StateHistory&) = delete;
+    StateHistory& operator= (const StateHistory&) = delete;
+
+    /**
+     * @brief map the file at path, records of a previous run are kept if the layout matches.
+     *
+     * @return false if records can only be kept in memory.
+     */
+    bool Init(const std::string& path, uint32_t capacity = DEFAULT_CAPACITY);
+    void UnInit();
+    void Append(const StateHistoryRecord& record);
+
+    // records held, at most the capacity
+    size_t Size() const;
+    // records appended since the file was created
+    uint64_t GetWriteCount() const;
+    bool IsPersistent() const;
+
+    /**
+     * @brief get the index-th newest record, index 0 is the latest one.
+     */
+    bool GetRecentRecord(size_t index, StateHistoryRecord& record) const;
+
+    /**
+     * @brief time spent in every state during [beginTime, endTime) of wall time, the state of the latest record
+     * lasts until now. time before the oldest record held, and the state left by a restart of the service, are
+     * unknown and not counted.
+     */
+    void GetResidency(int64_t beginTime, int64_t endTime, int64_t now, StateResidency& residency) const;
+
+public:
+    static constexpr uint32_t DEFAULT_CAPACITY = 4096;
+
+private:
+    struct Header {
+        uint32_t magic_ {0};
+        uint16_t version_ {0};
+        uint16_t recordSize_ {0};
+        uint32_t capacity_ {0};
+        uint32_t reserved_ {0};
+        uint64_t writeCount_ {0};
+    };
+
+    bool MapFile(const std::string& path, size_t length);
+    void Reset(uint32_t capacity);
+    const StateHistoryRecord& RecordAt(uint64_t sequence) const;
+
+private:
+    mutable std::mutex historyMutex_ {};
+    void* mappedAddr_ {nullptr};
+    size_t mappedLength_ {0};
+    std::unique_ptr<uint8_t[]> memoryBuffer_ {nullptr};
+    Header* header_ {nullptr};
+    StateHistoryRecord* records_ {nullptr};
+};
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_PLUGINS_STANDBY_STATE_INCLUDE_STATE_HISTORY_H
@@ -15,10 +15,30 @@
 #ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_SERVICES_CORE_INCLUDE_STATE_MANAGER_H
 #define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_SERVICES_CORE_INCLUDE_STATE_MANAGER_H
 
+#include <array>
+#include <deque>
+#include <optional>
+
 #include "istate_manager_adapter.h"
+#include "state_history.h"
+#include "state_transition_table.h"
 
 namespace OHOS {
 namespace DevStandbyMgr {
+struct StateTransitionStat {
+    uint64_t count_ {0};
+    // durations of the state left by the transition, in ms
+    int64_t totalDuration_ {0};
+    int64_t maxDuration_ {0};
+};
+
+struct SleepCycleTimerCount {
+    uint64_t ipcCount_ {0};
+    uint64_t wakeupCount_ {0};
+    // wakeups which would have been needed if no timer had a tolerance window
+    uint64_t uncoalescedWakeupCount_ {0};
+};
+
 class StateManagerAdapter : public IStateManagerAdapter {
 public:
     StateManagerAdapter() = default;
@@ -41,6 +61,7 @@ public:
     void StopEvalution() override;
     void HandleOpenCloseLid(const StandbyMessage& message);
     void ShellDump(const std::vector<std::string>& argsInStr, std::string& result) override;
+    ErrCode GetStateResidency(int64_t beginTime, int64_t endTime, std::vector<int64_t>& residency) override;
 protected:
     void SendNotification(uint32_t preState, bool needDispatchEvent);
     bool CheckTransitionValid(uint32_t curState, uint32_t nextState);
@@ -60,7 +81,14 @@ protected:
     void DumpEnterSpecifiedState(const std::vector<std::string>& argsInStr, std::string& result);
     void DumpActivateMotion(const std::vector<std::string>& argsInStr, std::string& result);
     void DumpResetState(const std::vector<std::string>& argsInStr, std::string& result);
-    void RecordStateTransition();
+    // valid transitions of STATE_TRANSITION_TABLE with their recorded counts and durations
+    void DumpTransitionGraph(std::string& result);
+    void DumpStateHistory(std::string& result);
+    void DumpStateResidency(int64_t beginTime, int64_t endTime, std::string& result);
+    void RecordStateTransition(uint32_t prePhase);
+    void RecordStateHistory(uint32_t prePhase);
+    void RecordSleepCycleTimerCount(uint32_t preState, uint32_t curState);
+    static SleepCycleTimerCount GetTimerCount();
     void TransitHoldSleepState();
 protected:
     std::shared_ptr<BaseState> darkStatePtr_ {nullptr};
@@ -70,6 +98,12 @@ protected:
     std::shared_ptr<BaseState> workingStatePtr_ {nullptr};
     std::vector<std::shared_ptr<BaseState>> indexToState_ {};
     bool isSleepState_ {false};
+    int64_t curStateBeginTime_ {0};
+    std::array<std::array<StateTransitionStat, STANDBY_STATE_NUM>, STANDBY_STATE_NUM> transitionStats_ {};
+    // timer counts when the current sleep cycle began, empty if not in a sleep cycle
+    std::optional<SleepCycleTimerCount> sleepCycleTimerBase_ {};
+    std::deque<SleepCycleTimerCount> recentSleepCycleTimerCounts_ {};
+    StateHistory stateHistory_ {};
 };
 }  // namespace DevStandbyMgr
 }  // namespace OHOS
@@ -27,7 +27,6 @@ public:
     ErrCode UnInit() override;
     ErrCode BeginState() override;
     ErrCode EndState() override;
-    bool CheckTransitionValid(uint32_t nextState) override;
     void EndEvalCurrentState(bool evalResult) override;
     void checkScreenStatus();
 };
@@ -18,6 +18,7 @@
 #include "time_provider.h"
 #include "timed_task.h"
 
+#include "standby_clock.h"
 #include "standby_service_log.h"
 #include "standby_config_manager.h"
 #include "iconstraint_manager_adapter.h"
@@ -51,19 +52,10 @@ ErrCode DarkState::BeginState()
 ErrCode DarkState::EndState()
 {
     StopTimedTask(TRANSIT_NEXT_STATE_TIMED_TASK);
-    handler_->RemoveTask(TRANSIT_NEXT_STATE_TIMED_TASK);
+    StandbyClock::GetInstance()->RemoveTask(handler_, TRANSIT_NEXT_STATE_TIMED_TASK);
     return ERR_OK;
 }
 
-bool DarkState::CheckTransitionValid(uint32_t nextState)
-{
-    if (nextState == StandbyState::MAINTENANCE) {
-        STANDBYSERVICE_LOGE("can not transit from dark to maintenance");
-        return false;
-    }
-    return true;
-}
-
 void DarkState::EndEvalCurrentState(bool evalResult)
 {
     auto stateManagerPtr = stateManager_.lock();
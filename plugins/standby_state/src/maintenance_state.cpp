@@ -15,6 +15,7 @@
 
 #include "maintenance_state.h"
 
+#include "standby_clock.h"
 #include "standby_service_log.h"
 #include "standby_config_manager.h"
 #include "iconstraint_manager_adapter.h"
@@ -44,19 +45,10 @@ ErrCode MaintenanceState::BeginState()
 ErrCode MaintenanceState::EndState()
 {
     StopTimedTask(TRANSIT_NEXT_STATE_TIMED_TASK);
-    handler_->RemoveTask(TRANSIT_NEXT_STATE_TIMED_TASK);
+    StandbyClock::GetInstance()->RemoveTask(handler_, TRANSIT_NEXT_STATE_TIMED_TASK);
     return ERR_OK;
 }
 
-bool MaintenanceState::CheckTransitionValid(uint32_t nextState)
-{
-    if (nextState == StandbyState::DARK) {
-        STANDBYSERVICE_LOGE("can not transit from maintenance to dark");
-        return false;
-    }
-    return true;
-}
-
 void MaintenanceState::EndEvalCurrentState(bool evalResult)
 {}
 }  // namespace DevStandbyMgr
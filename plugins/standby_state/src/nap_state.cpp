@@ -15,7 +15,7 @@
 
 #include "nap_state.h"
 
-#include "time_service_client.h"
+#include "standby_clock.h"
 
 #include "standby_service_log.h"
 #include "standby_config_manager.h"
@@ -47,7 +47,7 @@ ErrCode NapState::BeginState()
         STANDBYSERVICE_LOGI("after " SPUBI64 " ms, enter maintenance state", maintIntervalTimeOut);
 
         if (maintIntervalTimeOut != 0) {
-            StartStateTransitionTimer(maintIntervalTimeOut);
+            StartStateTransitionTimer(maintIntervalTimeOut, GetMaintLateTolerance(maintIntervalTimeOut));
         }
         return ERR_OK;
     }
@@ -61,7 +61,7 @@ ErrCode NapState::BeginState()
         STANDBYSERVICE_LOGI("napTimeOut is " SPUBI64 " ms", napTimeOut);
         StartStateTransitionTimer(napTimeOut);
     }
-    handler_->PostTask([napState = shared_from_this()]() {
+    StandbyClock::GetInstance()->PostTask(handler_, [napState = shared_from_this()]() {
         BaseState::AcquireStandbyRunningLock();
         napState->TransitToPhase(napState->curPhase_, napState->curPhase_ + 1);
         }, TRANSIT_NEXT_PHASE_INSTANT_TASK);
@@ -71,16 +71,11 @@ ErrCode NapState::BeginState()
 ErrCode NapState::EndState()
 {
     StopTimedTask(TRANSIT_NEXT_STATE_TIMED_TASK);
-    handler_->RemoveTask(TRANSIT_NEXT_STATE_TIMED_TASK);
-    handler_->RemoveTask(TRANSIT_NEXT_PHASE_INSTANT_TASK);
+    StandbyClock::GetInstance()->RemoveTask(handler_, TRANSIT_NEXT_STATE_TIMED_TASK);
+    StandbyClock::GetInstance()->RemoveTask(handler_, TRANSIT_NEXT_PHASE_INSTANT_TASK);
     return ERR_OK;
 }
 
-bool NapState::CheckTransitionValid(uint32_t nextState)
-{
-    return true;
-}
-
 void NapState::EndEvalCurrentState(bool evalResult)
 {
     if (curPhase_ == NapStatePhase::END) {
@@ -97,7 +92,7 @@ void NapState::SetPhaseTransitTask(bool evalResult)
     }
     curPhase_ += 1;
     if (curPhase_ < NapStatePhase::END) {
-        handler_->PostTask([napState = shared_from_this()]() {
+        StandbyClock::GetInstance()->PostTask(handler_, [napState = shared_from_this()]() {
             napState->TransitToPhase(napState->curPhase_, napState->curPhase_ + 1);
             }, TRANSIT_NEXT_PHASE_INSTANT_TASK);
     } else {
@@ -128,7 +123,7 @@ void NapState::OnStateBlocked()
     int64_t maintIntervalTimeOut = CalculateMaintTimeOut(stateManagerPtr, true);
     if (maintIntervalTimeOut > 0) {
         nextState_ = StandbyState::MAINTENANCE;
-        StartStateTransitionTimer(maintIntervalTimeOut);
+        StartStateTransitionTimer(maintIntervalTimeOut, GetMaintLateTolerance(maintIntervalTimeOut));
     }
     BaseState::ReleaseStandbyRunningLock();
 }
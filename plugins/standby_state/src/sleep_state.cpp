@@ -16,7 +16,7 @@
 #include "sleep_state.h"
 
 #include <cmath>
-#include "time_service_client.h"
+#include "standby_clock.h"
 
 #include "standby_service_log.h"
 #include "standby_config_manager.h"
@@ -24,6 +24,7 @@
 #include "istate_manager_adapter.h"
 #include "time_provider.h"
 #include "timed_task.h"
+#include "timer_multiplexer.h"
 
 using namespace OHOS::MiscServices;
 namespace OHOS {
@@ -43,7 +44,7 @@ SleepState::SleepState(uint32_t curState, uint32_t curPhase, const std::shared_p
 ErrCode SleepState::Init(const std::shared_ptr<BaseState>& statePtr)
 {
     auto callbackTask = [statePtr]() { statePtr->StartTransitNextState(statePtr); };
-    enterStandbyTimerId_ = TimedTask::CreateTimer(false, 0, true, true, callbackTask);
+    enterStandbyTimerId_ = TimerMultiplexer::GetInstance()->CreateTimer(false, 0, true, true, callbackTask);
     if (enterStandbyTimerId_ == 0) {
         STANDBYSERVICE_LOGE("%{public}s state init failed", STATE_NAME_LIST[GetCurState()].c_str());
         return ERR_STANDBY_STATE_INIT_FAILED;
@@ -53,18 +54,22 @@ ErrCode SleepState::Init(const std::shared_ptr<BaseState>& statePtr)
         return ERR_OK;
     }
     auto callback = [sleepState = this]() { sleepState->StartPeriodlyMotionDetection(); };
-    repeatedDetectionTimerId_ = TimedTask::CreateTimer(true, REPEATED_MOTION_DETECTION_INTERVAL, true, false, callback);
+    repeatedDetectionTimerId_ = TimerMultiplexer::GetInstance()->CreateTimer(true,
+        REPEATED_MOTION_DETECTION_INTERVAL, true, false, callback);
     if (repeatedDetectionTimerId_ == 0) {
         STANDBYSERVICE_LOGE("%{public}s init failed", STATE_NAME_LIST[GetCurState()].c_str());
         return ERR_STANDBY_STATE_INIT_FAILED;
     }
+    // motion detection does not need to be punctual, let it share wakeups with maintenance
+    TimerMultiplexer::GetInstance()->SetTimerTolerance(repeatedDetectionTimerId_,
+        REPEATED_MOTION_DETECTION_TOLERANCE, REPEATED_MOTION_DETECTION_TOLERANCE);
     SetTimedTask(REPEATED_MOTION_DETECTION_TASK, repeatedDetectionTimerId_);
     return ERR_OK;
 }
 
 void SleepState::StartPeriodlyMotionDetection()
 {
-    handler_->PostTask([sleepState = this]() {
+    StandbyClock::GetInstance()->PostTask(handler_, [sleepState = this]() {
         sleepState->isRepeatedDetection_ = true;
         ConstraintEvalParam params{sleepState->curState_, sleepState->curPhase_,
             sleepState->curState_, sleepState->curPhase_};
@@ -99,7 +104,7 @@ ErrCode SleepState::BeginState()
         if (maintIntervalTimeOut != 0) {
             STANDBYSERVICE_LOGI("from maintenance to sleep, maintIntervalTimeOut is " SPUBI64,
                 maintIntervalTimeOut);
-            StartStateTransitionTimer(maintIntervalTimeOut);
+            StartStateTransitionTimer(maintIntervalTimeOut, GetMaintLateTolerance(maintIntervalTimeOut));
         }
         return ERR_OK;
     }
@@ -109,11 +114,11 @@ ErrCode SleepState::BeginState()
     maintIntervalTimeOut = CalculateMaintTimeOut(stateManagerPtr, true);
     STANDBYSERVICE_LOGI("maintIntervalTimeOut is " SPUBI64 " ms", maintIntervalTimeOut);
 
-    handler_->PostTask([sleepState = this]() {
+    StandbyClock::GetInstance()->PostTask(handler_, [sleepState = this]() {
         BaseState::AcquireStandbyRunningLock();
         sleepState->TransitToPhase(sleepState->curPhase_, sleepState->curPhase_ + 1);
         }, TRANSIT_NEXT_PHASE_INSTANT_TASK);
-    StartStateTransitionTimer(maintIntervalTimeOut);
+    StartStateTransitionTimer(maintIntervalTimeOut, GetMaintLateTolerance(maintIntervalTimeOut));
     CheckScrenOffHalfHour();
     return ERR_OK;
 }
@@ -123,7 +128,7 @@ void SleepState::TryToEnterNextPhase(const std::shared_ptr<IStateManagerAdapter>
 {
     if (stateManagerPtr->IsEvalution()) {
         STANDBYSERVICE_LOGW("state is in evalution, postpone to enter next phase");
-        handler_->PostTask([sleepState = this, stateManagerPtr, retryTimeOut]() {
+        StandbyClock::GetInstance()->PostTask(handler_, [sleepState = this, stateManagerPtr, retryTimeOut]() {
             sleepState->TryToEnterNextPhase(stateManagerPtr, retryTimeOut);
             }, TRANSIT_NEXT_PHASE_INSTANT_TASK, retryTimeOut);
     } else if (curPhase_ < SleepStatePhase::END) {
@@ -135,21 +140,12 @@ ErrCode SleepState::EndState()
 {
     StopTimedTask(TRANSIT_NEXT_STATE_TIMED_TASK);
     StopTimedTask(REPEATED_MOTION_DETECTION_TASK);
-    handler_->RemoveTask(TRANSIT_NEXT_STATE_TIMED_TASK);
-    handler_->RemoveTask(TRANSIT_NEXT_PHASE_INSTANT_TASK);
-    handler_->RemoveTask(REPEATED_MOTION_DETECTION_TASK);
+    StandbyClock::GetInstance()->RemoveTask(handler_, TRANSIT_NEXT_STATE_TIMED_TASK);
+    StandbyClock::GetInstance()->RemoveTask(handler_, TRANSIT_NEXT_PHASE_INSTANT_TASK);
+    StandbyClock::GetInstance()->RemoveTask(handler_, REPEATED_MOTION_DETECTION_TASK);
     return ERR_OK;
 }
 
-bool SleepState::CheckTransitionValid(uint32_t nextState)
-{
-    if (nextState == StandbyState::NAP) {
-        STANDBYSERVICE_LOGE("can not transit from sleep to nap");
-        return false;
-    }
-    return true;
-}
-
 void SleepState::EndEvalCurrentState(bool evalResult)
 {
     auto stateManagerPtr = stateManager_.lock();
@@ -174,14 +170,14 @@ void SleepState::SetPhaseTransitOrRepeatedTask()
 {
     curPhase_ += 1;
     if (curPhase_ < SleepStatePhase::END) {
-        handler_->PostTask([sleepState = this]() {
+        StandbyClock::GetInstance()->PostTask(handler_, [sleepState = this]() {
             sleepState->TransitToPhase(sleepState->curPhase_, sleepState->curPhase_ + 1);
             }, TRANSIT_NEXT_PHASE_INSTANT_TASK);
     } else {
         BaseState::ReleaseStandbyRunningLock();
-        if (repeatedDetectionTimerId_ == 0 || !MiscServices::TimeServiceClient::GetInstance()->
-            StartTimer(repeatedDetectionTimerId_, MiscServices::TimeServiceClient::GetInstance()->
-            GetWallTimeMs() + REPEATED_MOTION_DETECTION_INTERVAL)) {
+        if (repeatedDetectionTimerId_ == 0 || !TimerMultiplexer::GetInstance()->StartTimer(
+            repeatedDetectionTimerId_, StandbyClock::GetInstance()->GetWallTimeMs() +
+            REPEATED_MOTION_DETECTION_INTERVAL)) {
             STANDBYSERVICE_LOGE("sleep state set periodly task failed");
         }
     }
@@ -208,7 +204,7 @@ void SleepState::CheckScrenOffHalfHour()
         STANDBYSERVICE_LOGW("state manager is nullptr, cannot begin screen off half hour");
         return;
     }
-    if (MiscServices::TimeServiceClient::GetInstance()->GetWallTimeMs() -
+    if (StandbyClock::GetInstance()->GetWallTimeMs() -
         stateManagerPtr->GetScreenOffTimeStamp() >= HALF_HOUR) {
         stateManagerPtr->OnScreenOffHalfHour(true, false);
     }
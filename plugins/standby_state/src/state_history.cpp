@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "state_history.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "standby_service_log.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+namespace {
+constexpr uint32_t STATE_HISTORY_MAGIC = 0x53484953;
+constexpr uint16_t STATE_HISTORY_VERSION = 1;
+}
+
+StateHistory::~StateHistory()
+{
+    UnInit();
+}
+
+bool StateHistory::Init(const std::string& path, uint32_t capacity)
+{
+    UnInit();
+    std::lock_guard<std::mutex> lock(historyMutex_);
+    capacity = std::max(capacity, static_cast<uint32_t>(1));
+    size_t length = sizeof(Header) + static_cast<size_t>(capacity) * sizeof(StateHistoryRecord);
+    bool isPersistent = MapFile(path, length);
+    if (!isPersistent) {
+        STANDBYSERVICE_LOGW("state history is kept in memory only");
+        memoryBuffer_ = std::make_unique<uint8_t[]>(length);
+        header_ = reinterpret_cast<Header*>(memoryBuffer_.get());
+    }
+    records_ = reinterpret_cast<StateHistoryRecord*>(reinterpret_cast<uint8_t*>(header_) + sizeof(Header));
+    if (header_->magic_ != STATE_HISTORY_MAGIC || header_->version_ != STATE_HISTORY_VERSION ||
+        header_->recordSize_ != sizeof(StateHistoryRecord) || header_->capacity_ != capacity) {
+        Reset(capacity);
+    }
+    return isPersistent;
+}
+
+bool StateHistory::MapFile(const std::string& path, size_t length)
+{
+    int32_t fd = TEMP_FAILURE_RETRY(open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR));
+    if (fd < 0) {
+        STANDBYSERVICE_LOGE("failed to open state history, errno: %{public}d", errno);
+        return false;
+    }
+    struct stat fileStat {};
+    if (fstat(fd, &fileStat) != 0 || (static_cast<size_t>(fileStat.st_size) != length &&
+        ftruncate(fd, static_cast<off_t>(length)) != 0)) {
+        STANDBYSERVICE_LOGE("failed to resize state history, errno: %{public}d", errno);
+        close(fd);
+        return false;
+    }
+    void* addr = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        STANDBYSERVICE_LOGE("failed to map state history, errno: %{public}d", errno);
+        return false;
+    }
+    mappedAddr_ = addr;
+    mappedLength_ = length;
+    header_ = static_cast<Header*>(addr);
+    return true;
+}
+
+void StateHistory::Reset(uint32_t capacity)
+{
+    std::fill_n(records_, capacity, StateHistoryRecord {});
+    header_->magic_ = STATE_HISTORY_MAGIC;
+    header_->version_ = STATE_HISTORY_VERSION;
+    header_->recordSize_ = sizeof(StateHistoryRecord);
+    header_->capacity_ = capacity;
+    header_->reserved_ = 0;
+    header_->writeCount_ = 0;
+}
+
+void StateHistory::UnInit()
+{
+    std::lock_guard<std::mutex> lock(historyMutex_);
+    if (mappedAddr_ != nullptr) {
+        munmap(mappedAddr_, mappedLength_);
+        mappedAddr_ = nullptr;
+        mappedLength_ = 0;
+    }
+    memoryBuffer_.reset();
+    header_ = nullptr;
+    records_ = nullptr;
+}
+
+void StateHistory::Append(const StateHistoryRecord& record)
+{
+    std::lock_guard<std::mutex> lock(historyMutex_);
+    if (header_ == nullptr) {
+        return;
+    }
+    records_[header_->writeCount_ % header_->capacity_] = record;
+    // the record is complete before it is counted, a record torn by a crash is never read
+    ++header_->writeCount_;
+}
+
+size_t StateHistory::Size() const
+{
+    std::lock_guard<std::mutex> lock(historyMutex_);
+    if (header_ == nullptr) {
+        return 0;
+    }
+    return static_cast<size_t>(std::min(header_->writeCount_, static_cast<uint64_t>(header_->capacity_)));
+}
+
+uint64_t StateHistory::GetWriteCount() const
+{
+    std::lock_guard<std::mutex> lock(historyMutex_);
+    return header_ == nullptr ? 0 : header_->writeCount_;
+}
+
+bool StateHistory::IsPersistent() const
+{
+    std::lock_guard<std::mutex> lock(historyMutex_);
+    return mappedAddr_ != nullptr;
+}
+
+const StateHistoryRecord& StateHistory::RecordAt(uint64_t sequence) const
+{
+    return records_[sequence % header_->capacity_];
+}
+
+bool StateHistory::GetRecentRecord(size_t index, StateHistoryRecord& record) const
+{
+    std::lock_guard<std::mutex> lock(historyMutex_);
+    if (header_ == nullptr || index >= std::min(header_->writeCount_, static_cast<uint64_t>(header_->capacity_))) {
+        return false;
+    }
+    record = RecordAt(header_->writeCount_ - 1 - index);
+    return true;
+}
+
+void StateHistory::GetResidency(int64_t beginTime, int64_t endTime, int64_t now, StateResidency& residency) const
+{
+    residency.fill(0);
+    std::lock_guard<std::mutex> lock(historyMutex_);
+    if (header_ == nullptr || header_->writeCount_ == 0) {
+        return;
+    }
+    uint64_t writeCount = header_->writeCount_;
+    uint64_t sequence = writeCount - std::min(writeCount, static_cast<uint64_t>(header_->capacity_));
+    for (; sequence < writeCount; ++sequence) {
+        const auto& record = RecordAt(sequence);
+        int64_t stateEndTime = now;
+        if (sequence + 1 < writeCount) {
+            const auto& nextRecord = RecordAt(sequence + 1);
+            // the service was down for an unknown time before it started again, the device may even have been
+            // powered off, so the state left by the restart is not counted
+            stateEndTime = nextRecord.trigger_ == static_cast<uint8_t>(TransitionTrigger::SERVICE_START) ?
+                record.wallTime_ : nextRecord.wallTime_;
+        }
+        // wall time may be set backwards, such intervals are skipped
+        int64_t overlapBegin = std::max(record.wallTime_, beginTime);
+        int64_t overlapEnd = std::min(stateEndTime, endTime);
+        if (overlapEnd > overlapBegin && record.curState_ < STANDBY_STATE_NUM) {
+            residency[record.curState_] += overlapEnd - overlapBegin;
+        }
+    }
+}
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
@@ -14,6 +14,10 @@
  */
 
 #include "state_manager_adapter.h"
+
+#include <cstdlib>
+#include <unordered_map>
+
 #ifdef STANDBY_POWER_MANAGER_ENABLE
 #include "power_mgr_client.h"
 #endif
@@ -23,17 +27,38 @@
 #include "maintenance_state.h"
 #include "nap_state.h"
 #include "sleep_state.h"
+#include "standby_clock.h"
 #include "standby_config_manager.h"
 #include "standby_service_impl.h"
 #include "standby_hitrace_chain.h"
 #include "standby_service_log.h"
 #include "standby_state_subscriber.h"
+#include "timer_multiplexer.h"
 #include "working_state.h"
 
 namespace OHOS {
 namespace DevStandbyMgr {
 namespace {
     const std::string COMMON_EVENT_USER_SLEEP_STATE_CHANGED = "COMMON_EVENT_USER_SLEEP_STATE_CHANGED";
+    const std::string STATE_HISTORY_FILE_PATH = "/data/service/el1/public/device_standby/state_history";
+    constexpr size_t MAX_RECENT_SLEEP_CYCLE_NUM = 10;
+    constexpr size_t MAX_DUMP_RECORD_NUM = 10;
+    constexpr int64_t DUMP_RESIDENCY_WINDOW = 24 * 3600 * 1000LL;
+
+    TransitionTrigger GetCommonEventTrigger(const std::string& action)
+    {
+        static const std::unordered_map<std::string, TransitionTrigger> triggerMap = {
+            {EventFwk::CommonEventSupport::COMMON_EVENT_SCREEN_ON, TransitionTrigger::SCREEN_ON},
+            {EventFwk::CommonEventSupport::COMMON_EVENT_SCREEN_UNLOCKED, TransitionTrigger::SCREEN_ON},
+            {EventFwk::CommonEventSupport::COMMON_EVENT_SCREEN_OFF, TransitionTrigger::SCREEN_OFF},
+            {EventFwk::CommonEventSupport::COMMON_EVENT_CHARGING, TransitionTrigger::CHARGING},
+            {EventFwk::CommonEventSupport::COMMON_EVENT_DISCHARGING, TransitionTrigger::DISCHARGING},
+            {EventFwk::CommonEventSupport::COMMON_EVENT_USB_DEVICE_ATTACHED, TransitionTrigger::USB_ATTACHED},
+            {EventFwk::CommonEventSupport::COMMON_EVENT_USB_DEVICE_DETACHED, TransitionTrigger::USB_DETACHED},
+        };
+        auto iter = triggerMap.find(action);
+        return iter == triggerMap.end() ? TransitionTrigger::UNKNOWN : iter->second;
+    }
 }
 bool StateManagerAdapter::Init()
 {
@@ -53,9 +78,11 @@ bool StateManagerAdapter::Init()
     };
 #ifndef STANDBY_REALTIME_TIMER_ENABLE
     auto callbackTask = [this]() { this->OnScreenOffHalfHour(true, false); };
-    scrOffHalfHourTimerId_ = TimedTask::CreateTimer(false, 0, true, false, callbackTask);
+    scrOffHalfHourTimerId_ = TimerMultiplexer::GetInstance()->CreateTimer(false, 0, true, false, callbackTask);
     if (scrOffHalfHourTimerId_ == 0) {
         STANDBYSERVICE_LOGE("timer of screen off half hour is nullptr");
+    } else {
+        TimerMultiplexer::GetInstance()->SetTimerTolerance(scrOffHalfHourTimerId_, 0, HALF_HOUR_TOLERANCE);
     }
 #endif
     for (const auto& statePtr : indexToState_) {
@@ -65,6 +92,10 @@ bool StateManagerAdapter::Init()
     }
     curStatePtr_ = workingStatePtr_;
     preStatePtr_ = curStatePtr_;
+    curStateBeginTime_ = StandbyClock::GetInstance()->GetMonotonicTimeMs();
+    stateHistory_.Init(STATE_HISTORY_FILE_PATH);
+    transitionTrigger_ = TransitionTrigger::SERVICE_START;
+    RecordStateHistory(0);
     #ifdef STANDBY_POWER_MANAGER_ENABLE
     isScreenOn_ = PowerMgr::PowerMgrClient::GetInstance().IsScreenOn();
     #endif
@@ -86,11 +117,11 @@ bool StateManagerAdapter::UnInit()
     }
 #ifndef STANDBY_REALTIME_TIMER_ENABLE
     if (scrOffHalfHourTimerId_ > 0) {
-        MiscServices::TimeServiceClient::GetInstance()->StopTimer(scrOffHalfHourTimerId_);
-        MiscServices::TimeServiceClient::GetInstance()->DestroyTimer(scrOffHalfHourTimerId_);
+        TimerMultiplexer::GetInstance()->DestroyTimer(scrOffHalfHourTimerId_);
     }
 #endif
     BaseState::ReleaseStandbyRunningLock();
+    stateHistory_.UnInit();
     return true;
 }
 
@@ -115,12 +146,14 @@ void StateManagerAdapter::HandleCommonEvent(const StandbyMessage& message)
         message.action_ == EventFwk::CommonEventSupport::COMMON_EVENT_CHARGING ||
         message.action_ == EventFwk::CommonEventSupport::COMMON_EVENT_USB_DEVICE_ATTACHED) {
         StandbyHitraceChain traceChain(__func__);
+        SetTransitionTrigger(GetCommonEventTrigger(message.action_));
         TransitToState(StandbyState::WORKING);
     }
     if (message.action_ == COMMON_EVENT_USER_SLEEP_STATE_CHANGED) {
         HandleUserSleepState(message);
     }
     if (message.action_ == EventFwk::CommonEventSupport::COMMON_EVENT_ENTER_FORCE_SLEEP) {
+        SetTransitionTrigger(TransitionTrigger::FORCE_SLEEP);
         TransitHoldSleepState();
     }
     if (curStatePtr_->GetCurState() != StandbyState::WORKING) {
@@ -128,6 +161,7 @@ void StateManagerAdapter::HandleCommonEvent(const StandbyMessage& message)
     }
     if (CheckEnterDarkState(message)) {
         StandbyHitraceChain traceChain(__func__);
+        SetTransitionTrigger(GetCommonEventTrigger(message.action_));
         TransitToState(StandbyState::DARK);
     }
 }
@@ -144,6 +178,7 @@ void StateManagerAdapter::HandleUserSleepState(const StandbyMessage& message)
     isSleepState_ = message.want_->GetBoolParam("isSleep", false);
     STANDBYSERVICE_LOGI("standby start handle user sleep state, recv sleepState is %{public}d", isSleepState_);
     if (isSleepState_) {
+        SetTransitionTrigger(TransitionTrigger::USER_SLEEP);
         TransitHoldSleepState();
     } else {
         if (curStatePtr_->GetCurState() == StandbyState::SLEEP) {
@@ -182,12 +217,11 @@ void StateManagerAdapter::HandleScrOffHalfHour(const StandbyMessage& message)
     }
     if (message.action_ == EventFwk::CommonEventSupport::COMMON_EVENT_SCREEN_OFF) {
         isScreenOn_ = false;
-        screenOffTimeStamp_ = MiscServices::TimeServiceClient::GetInstance()->GetWallTimeMs();
-        MiscServices::TimeServiceClient::GetInstance()->StartTimer(scrOffHalfHourTimerId_,
-            screenOffTimeStamp_ + HALF_HOUR);
+        screenOffTimeStamp_ = StandbyClock::GetInstance()->GetWallTimeMs();
+        TimerMultiplexer::GetInstance()->StartTimer(scrOffHalfHourTimerId_, screenOffTimeStamp_ + HALF_HOUR);
     } else if (message.action_ == EventFwk::CommonEventSupport::COMMON_EVENT_SCREEN_ON) {
         isScreenOn_ = true;
-        MiscServices::TimeServiceClient::GetInstance()->StopTimer(scrOffHalfHourTimerId_);
+        TimerMultiplexer::GetInstance()->StopTimer(scrOffHalfHourTimerId_);
     }
 }
 #endif
@@ -195,6 +229,7 @@ void StateManagerAdapter::HandleScrOffHalfHour(const StandbyMessage& message)
 void StateManagerAdapter::HandleOpenCloseLid(const StandbyMessage& message)
 {
     if (message.action_ == LID_OPEN) {
+        SetTransitionTrigger(TransitionTrigger::LID_OPEN);
         TransitToState(StandbyState::WORKING);
     }
 }
@@ -252,17 +287,19 @@ ErrCode StateManagerAdapter::TransitToState(uint32_t nextState)
     if (!CheckTransitionValid(curState, nextState)) {
         return ERR_STANDBY_STATE_TRANSITION_FAILED;
     }
-    if (curState == nextState) {
-        UnblockCurrentState();
-    } else if (nextState == StandbyState::MAINTENANCE ||
-        curState == StandbyState::MAINTENANCE) {
-        return TransitWithMaint(nextState);
-    } else if (curState < nextState) {
-        return EnterStandby(nextState);
-    } else {
-        return ExitStandby(nextState);
+    switch (GetTransitionAction(curState, nextState)) {
+        case TransitionAction::UNBLOCK:
+            UnblockCurrentState();
+            return ERR_OK;
+        case TransitionAction::WITH_MAINT:
+            return TransitWithMaint(nextState);
+        case TransitionAction::ENTER_STANDBY:
+            return EnterStandby(nextState);
+        case TransitionAction::EXIT_STANDBY:
+            return ExitStandby(nextState);
+        default:
+            return ERR_STANDBY_STATE_TRANSITION_FAILED;
     }
-    return ERR_OK;
 }
 
 ErrCode StateManagerAdapter::ExitStandby(uint32_t nextState)
@@ -284,7 +321,7 @@ bool StateManagerAdapter::CheckTransitionValid(uint32_t curState, uint32_t nextS
     bool ret = curStatePtr_->CheckTransitionValid(nextState);
     if (!ret) {
         STANDBYSERVICE_LOGE("can not transitting from now %{public}s to next %{public}s",
-            STATE_NAME_LIST[curState].c_str(), STATE_NAME_LIST[nextState].c_str());
+            STATE_NAMES[curState].data(), nextState < STANDBY_STATE_NUM ? STATE_NAMES[nextState].data() : "unknown");
     }
     return ret;
 }
@@ -310,27 +347,91 @@ ErrCode StateManagerAdapter::TransitWithMaint(uint32_t nextState)
 
 ErrCode StateManagerAdapter::TransitToStateInner(uint32_t nextState)
 {
+    uint32_t prePhase = curStatePtr_->GetCurInnerPhase();
     curStatePtr_->EndState();
     preStatePtr_ = curStatePtr_;
     curStatePtr_ = indexToState_[nextState];
     curStatePtr_->BeginState();
 
-    RecordStateTransition();
+    RecordStateTransition(prePhase);
     SendNotification(preStatePtr_->GetCurState(), true);
     BaseState::ReleaseStandbyRunningLock();
     return ERR_OK;
 }
 
-void StateManagerAdapter::RecordStateTransition()
+void StateManagerAdapter::RecordStateTransition(uint32_t prePhase)
 {
-    auto curTimeStampMs = MiscServices::TimeServiceClient::GetInstance()->GetMonotonicTimeMs();
-    stateRecordList_.emplace_back(std::make_pair(preStatePtr_->GetCurState(),
-        curTimeStampMs));
-    if (stateRecordList_.size() > MAX_RECORD_SIZE) {
-        stateRecordList_.pop_front();
+    auto curTimeStampMs = StandbyClock::GetInstance()->GetMonotonicTimeMs();
+    uint32_t preState = preStatePtr_->GetCurState();
+    uint32_t curState = curStatePtr_->GetCurState();
+    int64_t duration = curTimeStampMs - curStateBeginTime_;
+    curStateBeginTime_ = curTimeStampMs;
+    RecordStateHistory(prePhase);
+    if (preState < STANDBY_STATE_NUM && curState < STANDBY_STATE_NUM) {
+        auto& stat = transitionStats_[preState][curState];
+        ++stat.count_;
+        stat.totalDuration_ += duration;
+        stat.maxDuration_ = std::max(stat.maxDuration_, duration);
+    }
+    RecordSleepCycleTimerCount(preState, curState);
+}
+
+void StateManagerAdapter::RecordStateHistory(uint32_t prePhase)
+{
+    StateHistoryRecord record {};
+    record.wallTime_ = StandbyClock::GetInstance()->GetWallTimeMs();
+    record.monotonicTime_ = curStateBeginTime_;
+    record.preState_ = static_cast<uint8_t>(preStatePtr_->GetCurState());
+    record.curState_ = static_cast<uint8_t>(curStatePtr_->GetCurState());
+    record.prePhase_ = static_cast<uint8_t>(prePhase);
+    record.curPhase_ = static_cast<uint8_t>(curStatePtr_->GetCurInnerPhase());
+    record.action_ = static_cast<uint8_t>(GetTransitionAction(record.preState_, record.curState_));
+    record.trigger_ = static_cast<uint8_t>(transitionTrigger_);
+    stateHistory_.Append(record);
+    // a trigger is recorded once, transitions started by nothing known are recorded as unknown
+    transitionTrigger_ = TransitionTrigger::UNKNOWN;
+}
+
+ErrCode StateManagerAdapter::GetStateResidency(int64_t beginTime, int64_t endTime, std::vector<int64_t>& residency)
+{
+    if (beginTime >= endTime) {
+        STANDBYSERVICE_LOGW("invalid residency window");
+        return ERR_STANDBY_INVALID_PARAM;
+    }
+    StateResidency stateResidency {};
+    stateHistory_.GetResidency(beginTime, endTime, StandbyClock::GetInstance()->GetWallTimeMs(),
+        stateResidency);
+    residency.assign(stateResidency.begin(), stateResidency.end());
+    return ERR_OK;
+}
+
+void StateManagerAdapter::RecordSleepCycleTimerCount(uint32_t preState, uint32_t curState)
+{
+    // a sleep cycle lasts from entering sleep until leaving sleep and its maintenance windows
+    bool inSleepCycle = curState == StandbyState::SLEEP || (curState == StandbyState::MAINTENANCE &&
+        sleepCycleTimerBase_.has_value());
+    if (inSleepCycle && !sleepCycleTimerBase_.has_value()) {
+        sleepCycleTimerBase_ = GetTimerCount();
+    } else if (!inSleepCycle && sleepCycleTimerBase_.has_value()) {
+        auto timerCount = GetTimerCount();
+        timerCount.ipcCount_ -= sleepCycleTimerBase_->ipcCount_;
+        timerCount.wakeupCount_ -= sleepCycleTimerBase_->wakeupCount_;
+        timerCount.uncoalescedWakeupCount_ -= sleepCycleTimerBase_->uncoalescedWakeupCount_;
+        recentSleepCycleTimerCounts_.emplace_back(timerCount);
+        if (recentSleepCycleTimerCounts_.size() > MAX_RECENT_SLEEP_CYCLE_NUM) {
+            recentSleepCycleTimerCounts_.pop_front();
+        }
+        sleepCycleTimerBase_.reset();
     }
 }
 
+SleepCycleTimerCount StateManagerAdapter::GetTimerCount()
+{
+    auto timerMultiplexer = TimerMultiplexer::GetInstance();
+    return SleepCycleTimerCount {timerMultiplexer->GetTimerIpcCount(), timerMultiplexer->GetWakeupCount(),
+        timerMultiplexer->GetUncoalescedWakeupCount()};
+}
+
 void StateManagerAdapter::StopEvalution()
 {
     if (isEvalution_) {
@@ -389,6 +490,10 @@ void StateManagerAdapter::ShellDump(const std::vector<std::string>& argsInStr, s
         DumpShowDetailInfo(argsInStr, result);
         if (argsInStr[DUMP_SECOND_PARAM] == DUMP_RESET_STATE) {
             DumpResetState(argsInStr, result);
+        } else if (argsInStr[DUMP_SECOND_PARAM] == DUMP_STATE_RESIDENCY && argsInStr.size() >
+            static_cast<size_t>(DUMP_FOURTH_PARAM)) {
+            DumpStateResidency(std::atoll(argsInStr[DUMP_THIRD_PARAM].c_str()),
+                std::atoll(argsInStr[DUMP_FOURTH_PARAM].c_str()), result);
         }
     } else if (argsInStr[DUMP_FIRST_PARAM] == DUMP_ENTER_STATE) {
         DumpEnterSpecifiedState(argsInStr, result);
@@ -407,15 +512,93 @@ void StateManagerAdapter::DumpShowDetailInfo(const std::vector<std::string>& arg
         ", scrOffHalfHourCtrl: " + std::to_string(scrOffHalfHourCtrl_) +
         ", isScreenOn: " + std::to_string(isScreenOn_) + "\n";
 
-    if (stateRecordList_.empty()) {
+    DumpStateHistory(result);
+    DumpTransitionGraph(result);
+}
+
+void StateManagerAdapter::DumpStateHistory(std::string& result)
+{
+    if (stateHistory_.Size() == 0) {
         result += "\nstate record is empty\n";
     } else {
-        result += "\nstate transition record:\n";
+        result += "\nstate transition record, " + std::to_string(stateHistory_.GetWriteCount()) + " in total, " +
+            (stateHistory_.IsPersistent() ? "persistent" : "in memory") + ":\n";
+    }
+    StateHistoryRecord record {};
+    for (size_t index = std::min(stateHistory_.Size(), MAX_DUMP_RECORD_NUM); index > 0; --index) {
+        stateHistory_.GetRecentRecord(index - 1, record);
+        result.append(STATE_NAMES[record.preState_ % STANDBY_STATE_NUM]).append(" -> ")
+            .append(STATE_NAMES[record.curState_ % STANDBY_STATE_NUM])
+            .append(" [").append(GetTransitionActionName(static_cast<TransitionAction>(record.action_ %
+                TRANSITION_ACTION_NAMES.size()))).append("]")
+            .append(" trigger: ").append(GetTransitionTriggerName(static_cast<TransitionTrigger>(record.trigger_)))
+            .append(" phase: ").append(std::to_string(record.prePhase_)).append(" -> ")
+            .append(std::to_string(record.curPhase_))
+            .append("\twall time: ").append(std::to_string(record.wallTime_))
+            .append("\tmonotonic time: ").append(std::to_string(record.monotonicTime_)).append("\n");
+    }
+    int64_t now = StandbyClock::GetInstance()->GetWallTimeMs();
+    DumpStateResidency(now - DUMP_RESIDENCY_WINDOW, now, result);
+}
+
+void StateManagerAdapter::DumpStateResidency(int64_t beginTime, int64_t endTime, std::string& result)
+{
+    std::vector<int64_t> residency {};
+    if (GetStateResidency(beginTime, endTime, residency) != ERR_OK) {
+        result += "invalid residency window\n";
+        return;
     }
-
-    for (const auto &[stateIndex, timeStamp] : stateRecordList_) {
-        result += STATE_NAME_LIST[stateIndex] + "\t" + std::to_string(timeStamp) + "\n";
+    result.append("state residency(ms) from ").append(std::to_string(beginTime)).append(" to ")
+        .append(std::to_string(endTime)).append(":");
+    for (uint32_t state = 0; state < residency.size(); ++state) {
+        result.append(" ").append(STATE_NAMES[state]).append(": ").append(std::to_string(residency[state]));
+    }
+    result.append("\n");
+}
+
+void StateManagerAdapter::DumpTransitionGraph(std::string& result)
+{
+    result += "\nstate transition graph:\n";
+    for (uint32_t curState = 0; curState < STANDBY_STATE_NUM; ++curState) {
+        for (uint32_t nextState = 0; nextState < STANDBY_STATE_NUM; ++nextState) {
+            TransitionAction action = GetTransitionAction(curState, nextState);
+            if (action == TransitionAction::INVALID || action == TransitionAction::UNBLOCK) {
+                continue;
+            }
+            const auto& stat = transitionStats_[curState][nextState];
+            result.append(STATE_NAMES[curState]).append(" -> ").append(STATE_NAMES[nextState])
+                .append(" [").append(GetTransitionActionName(action)).append("]")
+                .append(" count: ").append(std::to_string(stat.count_))
+                .append(" avg duration(ms): ").append(std::to_string(stat.count_ == 0 ? 0 :
+                    stat.totalDuration_ / static_cast<int64_t>(stat.count_)))
+                .append(" max duration(ms): ").append(std::to_string(stat.maxDuration_)).append("\n");
+        }
+    }
+    // ipc/wakeups/uncoalesced wakeups of every cycle
+    result.append("timer of recent sleep cycles:");
+    for (const auto& timerCount : recentSleepCycleTimerCounts_) {
+        result.append(" ").append(std::to_string(timerCount.ipcCount_))
+            .append("/").append(std::to_string(timerCount.wakeupCount_))
+            .append("/").append(std::to_string(timerCount.uncoalescedWakeupCount_));
+    }
+    if (sleepCycleTimerBase_.has_value()) {
+        auto timerCount = GetTimerCount();
+        result.append(" current: ").append(std::to_string(timerCount.ipcCount_ - sleepCycleTimerBase_->ipcCount_))
+            .append("/").append(std::to_string(timerCount.wakeupCount_ - sleepCycleTimerBase_->wakeupCount_))
+            .append("/").append(std::to_string(timerCount.uncoalescedWakeupCount_ -
+                sleepCycleTimerBase_->uncoalescedWakeupCount_));
+    }
+    result.append("\n");
+    TimerMultiplexer::GetInstance()->ShellDump(result);
+    result.append("nap phases:");
+    for (const auto& phaseName : NAP_PHASE_NAMES) {
+        result.append(" ").append(phaseName);
+    }
+    result.append("\nsleep phases:");
+    for (const auto& phaseName : SLEEP_PHASE_NAMES) {
+        result.append(" ").append(phaseName);
     }
+    result.append("\n");
 }
 
 void StateManagerAdapter::DumpResetState(const std::vector<std::string>& argsInStr, std::string& result)
@@ -436,6 +619,7 @@ void StateManagerAdapter::DumpEnterSpecifiedState(const std::vector<std::string>
             result += "state name is not correct";
             return;
         }
+        SetTransitionTrigger(TransitionTrigger::DUMP);
         TransitToStateInner(iter - STATE_NAME_LIST.begin());
     }
 }
@@ -15,6 +15,7 @@
 
 #include "working_state.h"
 
+#include "standby_clock.h"
 #include "standby_service_log.h"
 #include "standby_config_manager.h"
 #include "iconstraint_manager_adapter.h"
@@ -25,7 +26,7 @@ namespace DevStandbyMgr {
 ErrCode WorkingState::BeginState()
 {
     curPhase_ = 0;
-    handler_->PostTask([working = shared_from_this()]() {
+    StandbyClock::GetInstance()->PostTask(handler_, [working = shared_from_this()]() {
         working->checkScreenStatus();
         }, TRANSIT_NEXT_STATE_CONDITION_TASK);
     return ERR_OK;
@@ -59,19 +60,10 @@ ErrCode WorkingState::EndState()
         STANDBYSERVICE_LOGE("state manager adapter is nullptr");
         return ERR_STATE_MANAGER_IS_NULLPTR;
     }
-    handler_->RemoveTask(TRANSIT_NEXT_STATE_CONDITION_TASK);
+    StandbyClock::GetInstance()->RemoveTask(handler_, TRANSIT_NEXT_STATE_CONDITION_TASK);
     return ERR_OK;
 }
 
-bool WorkingState::CheckTransitionValid(uint32_t nextState)
-{
-    if (nextState == StandbyState::MAINTENANCE) {
-        STANDBYSERVICE_LOGE("can not transit from working to maintenance");
-        return false;
-    }
-    return true;
-}
-
 void WorkingState::EndEvalCurrentState(bool evalResult)
 {
     auto stateManagerPtr = stateManager_.lock();
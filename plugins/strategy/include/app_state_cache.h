@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_APP_STATE_CACHE_H
+#define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_APP_STATE_CACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+#include "sa_query_executor.h"
+#include "singleton.h"
+#include "standby_messsage.h"
+#include "standby_service_errors.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+struct AppStateInfo {
+    int32_t uid_ {-1};
+    // bundle name of installed app, empty if uid does not belong to an app of all users
+    std::string bundleName_ {""};
+    // name of the first running process of uid
+    std::string processName_ {""};
+    std::set<int32_t> pids_ {};
+    bool isSystemApp_ {false};
+    bool isForeground_ {false};
+    // type id of each running continuous task
+    std::multiset<int32_t> continuousTaskTypeIds_ {};
+    bool hasTransientTask_ {false};
+    uint32_t runningWorkCount_ {0};
+};
+
+/**
+ * app states shared by all strategies, loaded once and then kept current by process, foreground and
+ * background task events, so that strategies do not query system abilities when entering sleep.
+ */
+class AppStateCache {
+DECLARE_DELAYED_SINGLETON(AppStateCache);
+public:
+    static std::shared_ptr<AppStateCache> GetInstance();
+
+    /**
+     * @brief rebuild the cache from system abilities.
+     *
+     * @return ERR_OK if all queries succeed.
+     */
+    ErrCode Load();
+
+    /**
+     * @brief load the cache only if it is not loaded yet or has been invalidated.
+     */
+    ErrCode EnsureLoaded();
+
+    /**
+     * @brief drop all app states, the cache will be reloaded when used next time.
+     */
+    void Clear();
+
+    /**
+     * @brief update app states incrementally, must be called before message is dispatched to strategies.
+     */
+    void HandleEvent(const StandbyMessage& message);
+
+    /**
+     * @brief get state of app with uid.
+     *
+     * @return true if app is found in cache.
+     */
+    bool GetAppState(int32_t uid, AppStateInfo& info);
+
+    /**
+     * @brief check system app flag from cache, bundle manager is queried only if uid is not cached.
+     */
+    bool IsSystemApp(int32_t uid);
+
+    /**
+     * @brief visit apps which have running processes, func must not access the cache.
+     */
+    void ForEachRunningApp(const std::function<void(const AppStateInfo&)>& func);
+
+    void ShellDump(std::string& result);
+
+private:
+    AppStateCache(const AppStateCache&) = delete;
+    AppStateCache& operator= (const AppStateCache&) = delete;
+    AppStateCache(AppStateCache&&) = delete;
+    AppStateCache& operator= (AppStateCache&&) = delete;
+    void LoadRunningApps(const AppStateQueryResult& queryResult);
+    void LoadBgTasks(const AppStateQueryResult& queryResult);
+    void LoadRunningWorks(const AppStateQueryResult& queryResult);
+    void HandleProcessStatusChanged(const StandbyMessage& message);
+    void HandleForegroundStateChanged(const StandbyMessage& message);
+    void HandleBgTaskStatusChanged(const StandbyMessage& message);
+    void HandleSysAbilityStatusChanged(const StandbyMessage& message);
+    void ReloadBgTasks(uint32_t queryMask);
+    void EraseIfUnused(std::unordered_map<int32_t, AppStateInfo>::iterator iter);
+
+private:
+    std::mutex cacheMutex_ {};
+    bool isLoaded_ {false};
+    std::unordered_map<int32_t, AppStateInfo> appStateMap_ {};
+    uint32_t loadCount_ {0};
+    int64_t lastLoadCostMs_ {0};
+    uint64_t updateCount_ {0};
+};
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_APP_STATE_CACHE_H
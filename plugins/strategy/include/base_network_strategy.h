@@ -15,16 +15,16 @@
 #ifndef DEVICE_STANDBY_EXT_BASE_NETWPRK_STRATEGY_H
 #define DEVICE_STANDBY_EXT_BASE_NETWPRK_STRATEGY_H
 
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "exemption_table.h"
 #include "ibase_strategy.h"
 
 namespace OHOS {
 namespace DevStandbyMgr {
-struct NetLimtedAppInfo {
-    std::string name_ {""};
-    uint8_t appExemptionFlag_ {0};
-};
-
-class BaseNetworkStrategy : public IBaseStrategy {
+class BaseNetworkStrategy : public IBaseStrategy, public std::enable_shared_from_this<BaseNetworkStrategy> {
 public:
     /**
      * @brief BaseNetworkStrategy HandleEvent by StandbyMessage.
@@ -78,6 +78,11 @@ protected:
      */
     virtual ErrCode UpdateFirewallAllowList();
 
+    /**
+     * @brief recalculate apps whose exemption depends on day or night condition when condition is switched.
+     */
+    virtual ErrCode UpdateConditionalAllowList();
+
     /**
      * @brief start net limited mode when has recerved reletive event.
      */
@@ -122,7 +127,7 @@ protected:
     void AddExemptionFlagByUid(int32_t uid, uint8_t flag);
     // get exemption app and restrict list from standby service
     ErrCode GetExemptionConfig();
-    ErrCode GetExemptionConfigForApp(NetLimtedAppInfo& appInfo, const std::string& bundleName);
+    ErrCode GetExemptionConfigForApp(size_t row, const std::string& bundleName);
 
     void AddExemptionFlag(uint32_t uid, const std::string& bundleName, uint8_t flag);
     void RemoveExemptionFlag(uint32_t uid, uint8_t flag);
@@ -130,13 +135,41 @@ protected:
     bool GetExemptedFlag(uint8_t appNoExemptionFlag, uint8_t appExemptionFlag);
     std::string UidsToString(const std::vector<uint32_t>& uids);
     bool IsFlagExempted(uint8_t flag);
+    bool IsFlagExemptedInCondition(uint8_t flag, uint32_t condition);
+    // exemption result of every flag value in condition, so that a scan checks one table entry per app
+    ExemptionFlagFilter GetExemptionFlagFilter(uint32_t condition);
+    bool IsConditionalRestrictApp(const std::string& bundleName);
+    bool IsConditionalRestrictApp(NameId nameId);
+
+    /**
+     * @brief buffer single uid firewall change, flushed as one batched call after a short delay.
+     */
+    void AddPendingFirewallUid(uint32_t uid, bool isAdded);
+
+    /**
+     * @brief send all buffered firewall changes to NetPolicy, invoked before state transition.
+     */
+    void FlushPendingFirewallList();
+
+    /**
+     * @brief drop buffered firewall changes when the allow list is reset as a whole.
+     */
+    void ClearPendingFirewallList();
 protected:
     static bool isFirewallEnabled_;
     static bool isNightSleepMode_;
     bool isIdleMaintence_ {false};
-    static std::unordered_map<std::int32_t, NetLimtedAppInfo> netLimitedAppInfo_;
+    // one row per uid
+    static ExemptionTable netLimitedAppInfo_;
     uint32_t nightExemptionTaskType_ {0};
     uint32_t condition_ {0};
+    // uid changes waiting to be sent to NetPolicy in one batch
+    std::set<uint32_t> pendingAllowedUids_ {};
+    std::set<uint32_t> pendingRemovedUids_ {};
+    bool isFlushTaskPosted_ {false};
+    uint32_t pendingFirewallOpCount_ {0};
+    uint64_t savedFirewallIpcCount_ {0};
+    uint64_t conditionReevaluatedCount_ {0};
     const static std::int32_t NETMANAGER_SUCCESS = 0;
     const static std::int32_t NETMANAGER_ERR_STATUS_EXIST = 2100209;
 };
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_EXEMPTION_TABLE_H
+#define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_EXEMPTION_TABLE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "name_interner.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+// result of an exemption check for each of the 256 values of an exemption flag byte
+using ExemptionFlagFilter = std::array<bool, UINT8_MAX + 1>;
+
+/**
+ * apps tracked by a strategy, one row per (uid, name). rows are kept sorted by uid and stored column by
+ * column, so that scans over exemption flags touch one contiguous byte array. pids of a row are a range
+ * of a single pid array, names are ids of the process-wide NameInterner.
+ */
+class ExemptionTable {
+public:
+    static constexpr size_t NPOS = SIZE_MAX;
+    using PidRange = std::pair<std::vector<int32_t>::const_iterator, std::vector<int32_t>::const_iterator>;
+
+    size_t Size() const;
+    bool Empty() const;
+    void Clear();
+
+    /**
+     * @brief find the first row of uid.
+     *
+     * @return NPOS if uid is not found.
+     */
+    size_t Find(int32_t uid) const;
+    size_t Find(int32_t uid, const std::string& name) const;
+    size_t Find(int32_t uid, NameId nameId) const;
+
+    /**
+     * @brief find the row of (uid, name), a row without flag and pid is inserted if not found.
+     *
+     * @return row of (uid, name) and whether it is inserted.
+     */
+    std::pair<size_t, bool> Emplace(int32_t uid, const std::string& name);
+
+    /**
+     * @brief erase row, rows after it are moved forward.
+     */
+    void Erase(size_t row);
+
+    int32_t GetUid(size_t row) const;
+    const std::string& GetName(size_t row) const;
+    NameId GetNameId(size_t row) const;
+    uint8_t GetFlag(size_t row) const;
+    void SetFlag(size_t row, uint8_t flag);
+    void AddFlag(size_t row, uint8_t flag);
+    void RemoveFlag(size_t row, uint8_t flag);
+
+    void AddPid(size_t row, int32_t pid);
+    bool RemovePid(size_t row, int32_t pid);
+    PidRange GetPids(size_t row) const;
+    size_t GetPidCount(size_t row) const;
+
+    /**
+     * @brief visit rows whose flag has any bit of mask.
+     */
+    template<typename Func>
+    void ForEachRowWithAnyFlag(uint8_t mask, Func&& func) const
+    {
+        for (size_t row = 0; row < flags_.size(); ++row) {
+            if ((flags_[row] & mask) != 0) {
+                func(row);
+            }
+        }
+    }
+
+    /**
+     * @brief collect uid of rows whose flag passes filter, uid of several rows is collected once.
+     */
+    void CollectUids(const ExemptionFlagFilter& filter, std::vector<uint32_t>& uids) const;
+
+    /**
+     * @brief collect (pid, uid) of rows whose flag passes filter.
+     */
+    void CollectPids(const ExemptionFlagFilter& filter, std::vector<std::pair<int32_t, int32_t>>& pids) const;
+
+    /**
+     * @brief bytes reserved by the table, names are shared by the process and not counted.
+     */
+    size_t GetMemoryUsage() const;
+
+private:
+    std::vector<int32_t> uids_ {};
+    std::vector<uint8_t> flags_ {};
+    std::vector<NameId> nameIds_ {};
+    // pids of row i are pids_[pidOffsets_[i], pidOffsets_[i + 1])
+    std::vector<uint32_t> pidOffsets_ {0};
+    std::vector<int32_t> pids_ {};
+};
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_EXEMPTION_TABLE_H
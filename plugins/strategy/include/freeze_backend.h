@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_FREEZE_BACKEND_H
+#define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_FREEZE_BACKEND_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "standby_service_errors.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+/**
+ * the mechanism which actually stops and resumes processes for FreezeStrategy.
+ */
+class IFreezeBackend {
+public:
+    virtual ~IFreezeBackend() = default;
+
+    /**
+     * @brief prepare the backend, called every time freezing starts.
+     *
+     * @return ERR_OK if processes can be frozen.
+     */
+    virtual ErrCode Init() = 0;
+
+    /**
+     * @brief freeze a batch of processes.
+     *
+     * @param pids processes to freeze.
+     * @param frozenPids processes which are frozen successfully.
+     */
+    virtual void Freeze(const std::vector<int32_t>& pids, std::vector<int32_t>& frozenPids) = 0;
+
+    /**
+     * @brief thaw a batch of processes frozen before, pids of dead processes are forgotten.
+     */
+    virtual void Thaw(const std::vector<int32_t>& pids) = 0;
+
+    /**
+     * @brief forget a frozen process which has died, without touching it. its pid may belong to
+     * another process already.
+     */
+    virtual void Forget(int32_t pid) = 0;
+
+    virtual std::string GetName() const = 0;
+};
+
+/**
+ * freeze processes with cgroup v2 freezer. frozen processes are moved to a child group whose
+ * cgroup.freeze is set, and moved back to their original group when thawed.
+ */
+class CgroupFreezerBackend : public IFreezeBackend {
+public:
+    explicit CgroupFreezerBackend(const std::string& cgroupRoot = "/sys/fs/cgroup",
+        const std::string& procRoot = "/proc");
+    ErrCode Init() override;
+    void Freeze(const std::vector<int32_t>& pids, std::vector<int32_t>& frozenPids) override;
+    void Thaw(const std::vector<int32_t>& pids) override;
+    void Forget(int32_t pid) override;
+    std::string GetName() const override;
+
+private:
+    // path of the cgroup v2 group of pid relative to cgroup root, "/" if unknown
+    std::string GetCgroupPath(int32_t pid);
+
+private:
+    std::string cgroupRoot_ {};
+    std::string procRoot_ {};
+    std::string frozenGroup_ {};
+    // frozen pid mapped to the group it is moved from
+    std::unordered_map<int32_t, std::string> originGroupMap_ {};
+};
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_FREEZE_BACKEND_H
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_FREEZE_STRATEGY_H
+#define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_FREEZE_STRATEGY_H
+#include "ibase_strategy.h"
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "freeze_backend.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+class FreezeStrategy : public IBaseStrategy {
+public:
+    FreezeStrategy();
+    explicit FreezeStrategy(const std::shared_ptr<IFreezeBackend>& backend);
+
+    /**
+     * @brief FreezeStrategy HandleEvent by StandbyMessage.
+     */
+    void HandleEvent(const StandbyMessage& message) override;
+
+    /**
+     * @brief FreezeStrategy OnCreated.
+     *
+     * @return ERR_OK if OnCreated success, failed with other code.
+     */
+    ErrCode OnCreated() override;
+
+    /**
+     * @brief FreezeStrategy OnDestroy.
+     *
+     * @return ERR_OK if OnDestroy success, failed with other code.
+     */
+    ErrCode OnDestroy() override;
+    void ShellDump(const std::vector<std::string>& argsInStr, std::string& result) override;
+private:
+    // start freezing when sleep enters app_res_deep phase
+    ErrCode StartFreeze(const StandbyMessage& message);
+    // thaw in maintenance, freeze again when back to sleep, thaw all when exiting sleep
+    ErrCode HandleStateTransit(const StandbyMessage& message);
+    ErrCode UpdateExemptionList(const StandbyMessage& message);
+    void HandleBgTaskStatusChanged(const StandbyMessage& message);
+    void HandleForegroundStateChanged(const StandbyMessage& message);
+    void HandleProcessStatusChanged(const StandbyMessage& message);
+
+    // collect processes of apps which are not exempted, and freeze them batch by batch
+    void StartFreezeCycle();
+    void FreezeNextBatch();
+    void ThawAll();
+    void ThawUid(int32_t uid);
+    void ThawPids(const std::vector<int32_t>& pids);
+    void StopFreeze();
+    void PostFreezeBatchTask();
+    void RemoveFreezeBatchTask();
+    void RecordCycle();
+
+    void DumpShowDetailInfo(const std::vector<std::string>& argsInStr, std::string& result);
+private:
+    std::shared_ptr<IFreezeBackend> backend_ {nullptr};
+    bool isFreezing_ {false};
+    bool isIdleMaintence_ {false};
+    int32_t batchSize_ {0};
+    // (pid, uid) waiting for the next batch
+    std::deque<std::pair<int32_t, int32_t>> pendingPids_ {};
+    // frozen pid mapped to its uid
+    std::unordered_map<int32_t, int32_t> frozenPids_ {};
+    uint32_t curCycleFrozenCount_ {0};
+    std::deque<uint32_t> recentCycleFrozenCounts_ {};
+    uint64_t cycleCount_ {0};
+    uint64_t freezeBatchCount_ {0};
+    uint64_t frozenCount_ {0};
+    int64_t totalFreezeLatency_ {0};
+    int64_t maxFreezeLatency_ {0};
+    uint64_t thawBatchCount_ {0};
+    uint64_t thawedCount_ {0};
+    int64_t totalThawLatency_ {0};
+    int64_t maxThawLatency_ {0};
+};
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_FREEZE_STRATEGY_H
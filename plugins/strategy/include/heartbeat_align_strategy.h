@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_HEARTBEAT_ALIGN_STRATEGY_H
+#define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_HEARTBEAT_ALIGN_STRATEGY_H
+#include "ibase_strategy.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "heartbeat_scheduler.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+class HeartbeatAlignStrategy : public IBaseStrategy {
+public:
+    /**
+     * @brief HeartbeatAlignStrategy HandleEvent by StandbyMessage.
+     */
+    void HandleEvent(const StandbyMessage& message) override;
+
+    /**
+     * @brief HeartbeatAlignStrategy OnCreated.
+     *
+     * @return ERR_OK if OnCreated success, failed with other code.
+     */
+    ErrCode OnCreated() override;
+
+    /**
+     * @brief HeartbeatAlignStrategy OnDestroy.
+     *
+     * @return ERR_OK if OnDestroy success, failed with other code.
+     */
+    ErrCode OnDestroy() override;
+    void ShellDump(const std::vector<std::string>& argsInStr, std::string& result) override;
+private:
+    ErrCode HandleNatIntervalChanged(const StandbyMessage& message);
+    ErrCode HandleHeartBeatValueChanged(const StandbyMessage& message);
+    // maintenance window is where pending heartbeats are gathered
+    ErrCode HandleStateTransit(const StandbyMessage& message);
+
+    // beat due groups and wait for the next one
+    void AdvanceSchedule();
+    void PostAlignTask();
+    void RemoveAlignTask();
+
+    void DumpShowDetailInfo(const std::vector<std::string>& argsInStr, std::string& result);
+private:
+    std::unique_ptr<HeartbeatScheduler> scheduler_ {nullptr};
+    int64_t maintenanceDuration_ {0};
+};
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_HEARTBEAT_ALIGN_STRATEGY_H
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_HEARTBEAT_SCHEDULER_H
+#define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_HEARTBEAT_SCHEDULER_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace OHOS {
+namespace DevStandbyMgr {
+struct HeartbeatTag {
+    std::string tag_ {};
+    int64_t interval_ {0};
+    int64_t lastBeat_ {0};
+    // time the tag beats after alignment, never later than lastBeat_ + interval_
+    int64_t alignedBeat_ {0};
+    // aligned beat falls into a maintenance window, the radio is awake anyway
+    bool inMaintenance_ {false};
+    uint64_t beatCount_ {0};
+};
+
+/**
+ * keep the heartbeat schedule of every tag and align them, so that beats due close to each other share one
+ * wakeup. a beat may be brought forward by at most flexPercent of its interval, never postponed. all times
+ * are in ms of one monotonic clock supplied by the caller.
+ */
+class HeartbeatScheduler {
+public:
+    explicit HeartbeatScheduler(int32_t flexPercent = 25);
+
+    /**
+     * @brief add a tag or change its interval, the tag is removed if interval is not positive.
+     */
+    void SetInterval(const std::string& tag, int64_t interval, int64_t now);
+    void RemoveTag(const std::string& tag);
+
+    /**
+     * @brief traffic has just passed, every connection is alive without beating.
+     */
+    void OnTraffic(int64_t now);
+
+    /**
+     * @brief the radio is awake in [start, end), beats that may happen inside are moved into it.
+     */
+    void AddMaintenanceWindow(int64_t start, int64_t end);
+
+    /**
+     * @brief beat every aligned group which is due at now, and align again.
+     */
+    void Advance(int64_t now);
+
+    const std::vector<HeartbeatTag>& GetTags() const;
+    const std::vector<std::pair<int64_t, int64_t>>& GetMaintenanceWindows() const;
+    // earliest aligned beat, -1 if there is no tag
+    int64_t GetNextWakeup() const;
+    uint64_t GetBeatCount() const;
+    uint64_t GetWakeupCount() const;
+    uint64_t GetWakeupSavedCount() const;
+
+private:
+    void Align();
+
+private:
+    int32_t flexPercent_ {0};
+    std::vector<HeartbeatTag> tags_ {};
+    std::vector<std::pair<int64_t, int64_t>> maintenanceWindows_ {};
+    uint64_t beatCount_ {0};
+    uint64_t wakeupCount_ {0};
+};
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_HEARTBEAT_SCHEDULER_H
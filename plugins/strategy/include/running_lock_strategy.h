@@ -14,28 +14,16 @@
  */
 #ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_RUNNINGLOCK_STRATEGY_H
 #define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_RUNNINGLOCK_STRATEGY_H
+#include "exemption_table.h"
 #include "ibase_strategy.h"
 
 #include <unordered_map>
+#include <unordered_set>
 #include <set>
 #include <string>
 
 namespace OHOS {
 namespace DevStandbyMgr {
-struct ProxiedAppInfo {
-    std::string name_ {""};
-    int32_t uid_ {-1};
-    int32_t pid_ {-1};
-    uint8_t appExemptionFlag_ {0};
-};
-
-struct ProxiedProcInfo {
-    std::string name_ {""};
-    int32_t uid_ {-1};
-    std::set<int32_t> pids_ {};
-    uint8_t appExemptionFlag_ {0};
-};
-
 class RunningLockStrategy : public IBaseStrategy {
 public:
     /**
@@ -69,14 +57,17 @@ protected:
     // clear record of proxied app and process
     virtual void ClearProxyRecord();
 
-    void SetProxiedAppList(std::vector<std::pair<int32_t, int32_t>>& proxiedAppList,
-        const ProxiedProcInfo& info);
+    void SetProxiedAppList(std::vector<std::pair<int32_t, int32_t>>& proxiedAppList, size_t row);
     void ProxyRunningLockList(bool isProxied, const std::vector<std::pair<int32_t, int32_t>>& proxiedAppList);
+    // proxy or unproxy pids whose status differs from proxiedAppInfo_
+    void SyncProxiedPidList();
 private:
     // update exemtion list when received exemtion list changed event
     ErrCode UpdateExemptionList(const StandbyMessage& message);
     // update resource config when received condition changed event
     ErrCode UpdateResourceConfig();
+    // recalculate exemption and restriction flag of apps whose name is in names
+    void ReevaluateExemptionConfig(const NameIdSet& nameIds);
     ErrCode StartProxy(const StandbyMessage& message);
     ErrCode StartProxyInner();
     ErrCode StopProxy(const StandbyMessage& message);
@@ -95,6 +86,7 @@ private:
     ErrCode GetWorkSchedulerTask();
     // get background task, including continuous task and transient, defaultly not be constricted.
     ErrCode GetBackgroundTaskApp();
+    void AddExemptionFlagByUid(int32_t uid, uint8_t flag);
     // get exemption app list from standby service
     ErrCode GetExemptionConfig();
 
@@ -102,17 +94,23 @@ private:
     void HandleProcessStatusChanged(const StandbyMessage& message);
 
     void GetAndCreateAppInfo(uint32_t uid, uint32_t pid, const std::string& bundleName);
-    ErrCode GetExemptionConfigForApp(ProxiedProcInfo& appInfo, const std::string& bundleName);
+    ErrCode GetExemptionConfigForApp(size_t row, const std::string& bundleName);
 
     void DumpShowDetailInfo(const std::vector<std::string>& argsInStr, std::string& result);
 protected:
     bool isProxied_ {false};
 private:
     bool isIdleMaintence_ {false};
-    // proxyed app and native process info
-    std::unordered_map<std::string, ProxiedProcInfo> proxiedAppInfo_;
+    // proxyed app and native process info, one row per (uid, name)
+    ExemptionTable proxiedAppInfo_ {};
 
-    std::unordered_map<std::int32_t, std::string> uidBundleNmeMap_;
+    std::unordered_map<std::int32_t, NameId> uidBundleNmeMap_;
+    // (pid, uid) whose running lock is proxied in power manager now
+    std::set<std::pair<int32_t, int32_t>> proxiedPidSet_ {};
+    uint64_t proxyIpcCount_ {0};
+    uint64_t proxyPairCount_ {0};
+    uint64_t skippedProxyPairCount_ {0};
+    uint64_t conditionReevaluatedCount_ {0};
 };
 }  // namespace DevStandbyMgr
 }  // namespace OHOS
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_SA_QUERY_EXECUTOR_H
+#define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_SA_QUERY_EXECUTOR_H
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "app_mgr_helper.h"
+#include "bundle_manager_helper.h"
+#ifdef ENABLE_BACKGROUND_TASK_MGR
+#include "background_task_helper.h"
+#endif
+#ifdef STANDBY_RSS_WORK_SCHEDULER_ENABLE
+#include "workscheduler_srv_client.h"
+#endif
+#include "singleton.h"
+#include "standby_service_errors.h"
+#include "thread_pool.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+struct SaQueryType {
+    enum : uint32_t {
+        RUNNING_PROCESS = 1,
+        APPLICATION_INFO = 1 << 1,
+        SPECIAL_APPLICATION_INFO = 1 << 2,
+        FOREGROUND_APP = 1 << 3,
+        CONTINUOUS_TASK = 1 << 4,
+        TRANSIENT_TASK = 1 << 5,
+        WORK_SCHEDULER = 1 << 6,
+    };
+};
+
+// results of system ability queries, written by worker threads and read on handler thread after join
+struct AppStateQueryResult {
+    std::vector<AppExecFwk::RunningProcessInfo> runningProcesses_ {};
+    std::vector<AppExecFwk::ApplicationInfo> applicationInfos_ {};
+    std::vector<AppExecFwk::ApplicationInfo> specialApplicationInfos_ {};
+    std::vector<AppExecFwk::AppStateData> foregroundApps_ {};
+#ifdef ENABLE_BACKGROUND_TASK_MGR
+    std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> continuousTasks_ {};
+    std::vector<std::shared_ptr<TransientTaskAppInfo>> transientTasks_ {};
+#endif
+#ifdef STANDBY_RSS_WORK_SCHEDULER_ENABLE
+    std::list<std::shared_ptr<WorkScheduler::WorkInfo>> workInfos_ {};
+#endif
+};
+
+struct SaQueryLatency {
+    uint32_t count_ {0};
+    uint32_t failedCount_ {0};
+    int64_t lastCostMs_ {0};
+    int64_t maxCostMs_ {0};
+    int64_t totalCostMs_ {0};
+};
+
+class SaQueryExecutor {
+DECLARE_DELAYED_SINGLETON(SaQueryExecutor);
+public:
+    static std::shared_ptr<SaQueryExecutor> GetInstance();
+
+    /**
+     * @brief issue the queries in queryMask concurrently on worker threads and wait for all of them.
+     *
+     * @param queryMask bit mask of SaQueryType.
+     * @param result filled with query results, only valid when ERR_OK is returned.
+     * @return ERR_OK if all queries succeed before deadline.
+     */
+    ErrCode QueryAppStates(uint32_t queryMask, std::shared_ptr<AppStateQueryResult>& result);
+
+    void ShellDump(std::string& result);
+
+private:
+    using SaQueryTask = std::pair<std::string, std::function<bool()>>;
+
+    SaQueryExecutor(const SaQueryExecutor&) = delete;
+    SaQueryExecutor& operator= (const SaQueryExecutor&) = delete;
+    SaQueryExecutor(SaQueryExecutor&&) = delete;
+    SaQueryExecutor& operator= (SaQueryExecutor&&) = delete;
+    void BuildQueryTasks(uint32_t queryMask, const std::shared_ptr<AppStateQueryResult>& result,
+        std::vector<SaQueryTask>& tasks);
+    bool RunQueryTasks(const std::vector<SaQueryTask>& tasks, int64_t timeOutMs);
+    void RecordLatency(const std::string& queryName, int64_t costMs, bool succeed);
+    bool StartWorkersIfNeed();
+
+private:
+    std::mutex workerMutex_ {};
+    bool isWorkerStarted_ {false};
+    ThreadPool workers_ {"StandbySaQuery"};
+    std::mutex latencyMutex_ {};
+    std::map<std::string, SaQueryLatency> latencyMap_ {};
+    uint32_t timeoutCount_ {0};
+};
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_SA_QUERY_EXECUTOR_H
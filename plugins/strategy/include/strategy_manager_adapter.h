@@ -16,16 +16,28 @@
 #ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_STRATEGY_MANAGER_ADAPTER_H
 #define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_STRATEGY_MANAGER_ADAPTER_H
 
+#include <map>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include "istrategy_manager_adapter.h"
+#include "thread_pool.h"
 
 namespace OHOS {
 namespace DevStandbyMgr {
+struct StrategyTiming {
+    std::string name_ {""};
+    uint64_t count_ {0};
+    int64_t lastCostMs_ {0};
+    int64_t maxCostMs_ {0};
+    int64_t totalCostMs_ {0};
+};
+
 class StrategyManagerAdapter : public IStrategyManagerAdapter {
 public:
-    StrategyManagerAdapter() = default;
-    ~StrategyManagerAdapter() override = default;
+    StrategyManagerAdapter();
+    ~StrategyManagerAdapter() override;
     bool Init() override;
     bool UnInit() override;
     void HandleEvent(const StandbyMessage& messageType) override;
@@ -33,6 +45,30 @@ public:
 
 protected:
     void RegisterPolicy(const std::vector<std::string>& strategies) override;
+
+private:
+    bool IsConcurrentEvent(uint32_t eventId);
+    bool IsEventConsumed(const std::shared_ptr<IBaseStrategy>& strategy, uint32_t eventId);
+    /**
+     * @brief strategies handle message on worker threads in parallel, return after all of them finish, so that
+     * each strategy still handles messages in order and never runs concurrently with the handler thread.
+     */
+    void HandleEventConcurrently(const std::vector<std::shared_ptr<IBaseStrategy>>& receivers,
+        const StandbyMessage& message);
+    void HandleStrategyEvent(const std::shared_ptr<IBaseStrategy>& strategy, const StandbyMessage& message);
+    bool StartWorkersIfNeed();
+    void DumpStrategyTiming(std::string& result);
+
+private:
+    bool isConcurrent_ {false};
+    // event mask of strategies created from registry, strategies not found here consume all messages
+    std::unordered_map<const IBaseStrategy*, uint64_t> eventMaskMap_ {};
+    std::mutex workerMutex_ {};
+    bool isWorkerStarted_ {false};
+    ThreadPool workers_ {"StandbyStrategy"};
+    std::mutex timingMutex_ {};
+    std::map<const IBaseStrategy*, StrategyTiming> timingMap_ {};
+    uint64_t concurrentEventCount_ {0};
 };
 }  // namespace DevStandbyMgr
 }  // namespace OHOS
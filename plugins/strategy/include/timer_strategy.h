@@ -15,16 +15,60 @@
 #ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_TIMER_STRATEGY_H
 #define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_TIMER_STRATEGY_H
 
+#include <string>
+#include <unordered_set>
+#include <vector>
+
 #include "ibase_strategy.h"
 
 namespace OHOS {
 namespace DevStandbyMgr {
 class TimerStrategy : public IBaseStrategy {
 public:
+    /**
+     * @brief TimerStrategy HandleEvent by StandbyMessage.
+     */
     void HandleEvent(const StandbyMessage& message) override;
+
+    /**
+     * @brief TimerStrategy OnCreated.
+     *
+     * @return ERR_OK if OnCreated success, failed with other code.
+     */
     ErrCode OnCreated() override;
+
+    /**
+     * @brief TimerStrategy OnDestroy.
+     *
+     * @return ERR_OK if OnDestroy success, failed with other code.
+     */
     ErrCode OnDestroy() override;
     void ShellDump(const std::vector<std::string>& argsInStr, std::string& result) override;
+private:
+    // align timers when entering nap or sleep, undo the alignment when exiting
+    ErrCode HandleStateTransit(const StandbyMessage& message);
+    // align wakeup timers of apps which are not exempted to interval, in seconds
+    ErrCode StartAlignTimer(uint32_t interval);
+    ErrCode StopAlignTimer();
+    // the smallest maintenance interval of state, aligned timers are triggered no later than it
+    uint32_t GetAlignInterval(uint32_t state);
+    // recalculate exempted apps, only the difference is sent to time service
+    void UpdateTimerExemption();
+    void GetExemptionNames(std::unordered_set<std::string>& exemptionNames);
+    void SetTimerExemption(const std::unordered_set<std::string>& names, bool isExemption);
+
+    void DumpShowDetailInfo(const std::vector<std::string>& argsInStr, std::string& result);
+private:
+    bool isAligned_ {false};
+    uint32_t alignInterval_ {0};
+    // names exempted from alignment in time service now
+    std::unordered_set<std::string> exemptionNames_ {};
+    int64_t alignStartTime_ {0};
+    int64_t totalAlignedTime_ {0};
+    // maintenance windows reached while aligned, timers delayed to them are triggered in one wakeup
+    uint64_t alignedWindowCount_ {0};
+    uint64_t adjustIpcCount_ {0};
+    uint64_t exemptionIpcCount_ {0};
 };
 }  // namespace DevStandbyMgr
 }  // namespace OHOS
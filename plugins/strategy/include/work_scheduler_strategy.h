@@ -16,12 +16,85 @@
 #define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_STRATEGY_INCLUDE_WORK_STRATEGY_H
 #include "ibase_strategy.h"
 
+#include <deque>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "app_state_cache.h"
+
 namespace OHOS {
 namespace DevStandbyMgr {
+struct DeferredWorkPriority {
+    enum : uint8_t {
+        SYSTEM_APP = 0,
+        NORMAL_APP,
+        RESTRICTED_APP,
+    };
+};
+
+struct DeferredWorkInfo {
+    int32_t uid_ {-1};
+    std::string name_ {""};
+    // smaller value is released earlier
+    uint8_t priority_ {DeferredWorkPriority::NORMAL_APP};
+    int64_t deferTime_ {0};
+};
+
 class WorkSchedulerStrategy : public IBaseStrategy {
+public:
+    /**
+     * @brief WorkSchedulerStrategy HandleEvent by StandbyMessage.
+     */
     void HandleEvent(const StandbyMessage& message) override;
+
+    /**
+     * @brief WorkSchedulerStrategy OnCreated.
+     *
+     * @return ERR_OK if OnCreated success, failed with other code.
+     */
     ErrCode OnCreated() override;
+
+    /**
+     * @brief WorkSchedulerStrategy OnDestroy.
+     *
+     * @return ERR_OK if OnDestroy success, failed with other code.
+     */
     ErrCode OnDestroy() override;
+    void ShellDump(const std::vector<std::string>& argsInStr, std::string& result) override;
+private:
+    // defer works in sleep, release them in maintenance and resume all of them when exiting sleep
+    ErrCode HandleStateTransit(const StandbyMessage& message);
+    // work started in sleep is deferred, finished work releases its slot in maintenance
+    ErrCode HandleWorkStatusChanged(const StandbyMessage& message);
+    // pause running works of apps which are not exempted
+    void DeferRunningWorks();
+    bool DeferWork(const AppStateInfo& appState, const std::set<std::string>& allowNames,
+        const std::set<std::string>& restrictNames);
+    // resume deferred works by priority, no more than maxConcurrency_ apps run at the same time
+    void ReleaseDeferredWorks();
+    void ReleaseAllDeferredWorks();
+    void ResumeWork(const DeferredWorkInfo& workInfo, int64_t curTime);
+    void PostReleaseTask();
+    void RemoveReleaseTask();
+    void RecordBatchSize();
+    void GetExemptionConfig(std::set<std::string>& allowNames, std::set<std::string>& restrictNames);
+
+    void DumpShowDetailInfo(const std::vector<std::string>& argsInStr, std::string& result);
+private:
+    bool isDeferring_ {false};
+    bool isIdleMaintence_ {false};
+    int32_t maxConcurrency_ {0};
+    std::unordered_map<int32_t, DeferredWorkInfo> deferredWorks_ {};
+    // uid of released works which may be still running, mapped to release time
+    std::unordered_map<int32_t, int64_t> releasedWorks_ {};
+    uint32_t curBatchSize_ {0};
+    std::deque<uint32_t> recentBatchSizes_ {};
+    uint64_t deferredCount_ {0};
+    uint64_t releasedCount_ {0};
+    int64_t totalDeferLatency_ {0};
+    int64_t maxDeferLatency_ {0};
 };
 }  // namespace DevStandbyMgr
 }  // namespace OHOS
@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "app_state_cache.h"
+
+#include <tuple>
+
+#include "bundle_manager_helper.h"
+#include "common_constant.h"
+#include "standby_service_log.h"
+#include "system_ability_definition.h"
+#include "time_service_client.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+namespace {
+constexpr uint32_t APP_STATE_LOAD_MASK = SaQueryType::RUNNING_PROCESS | SaQueryType::APPLICATION_INFO |
+    SaQueryType::SPECIAL_APPLICATION_INFO | SaQueryType::FOREGROUND_APP | SaQueryType::CONTINUOUS_TASK |
+    SaQueryType::TRANSIENT_TASK | SaQueryType::WORK_SCHEDULER;
+constexpr uint32_t BG_TASK_LOAD_MASK = SaQueryType::CONTINUOUS_TASK | SaQueryType::TRANSIENT_TASK;
+}
+
+AppStateCache::AppStateCache() {}
+
+AppStateCache::~AppStateCache() {}
+
+std::shared_ptr<AppStateCache> AppStateCache::GetInstance()
+{
+    return DelayedSingleton<AppStateCache>::GetInstance();
+}
+
+ErrCode AppStateCache::Load()
+{
+    int64_t startTime = MiscServices::TimeServiceClient::GetInstance()->GetMonotonicTimeMs();
+    std::shared_ptr<AppStateQueryResult> queryResult {nullptr};
+    if (SaQueryExecutor::GetInstance()->QueryAppStates(APP_STATE_LOAD_MASK, queryResult) != ERR_OK) {
+        STANDBYSERVICE_LOGW("failed to load app state cache");
+        Clear();
+        return ERR_STRATEGY_DEPENDS_SA_NOT_AVAILABLE;
+    }
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    appStateMap_.clear();
+    LoadRunningApps(*queryResult);
+    LoadBgTasks(*queryResult);
+    LoadRunningWorks(*queryResult);
+    isLoaded_ = true;
+    ++loadCount_;
+    lastLoadCostMs_ = MiscServices::TimeServiceClient::GetInstance()->GetMonotonicTimeMs() - startTime;
+    STANDBYSERVICE_LOGI("app state cache loaded, size is %{public}d, cost %{public}lld ms",
+        static_cast<int32_t>(appStateMap_.size()), static_cast<long long>(lastLoadCostMs_));
+    return ERR_OK;
+}
+
+ErrCode AppStateCache::EnsureLoaded()
+{
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        if (isLoaded_) {
+            return ERR_OK;
+        }
+    }
+    return Load();
+}
+
+void AppStateCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    appStateMap_.clear();
+    isLoaded_ = false;
+}
+
+void AppStateCache::LoadRunningApps(const AppStateQueryResult& queryResult)
+{
+    for (const auto& info : queryResult.runningProcesses_) {
+        auto& appState = appStateMap_[info.uid_];
+        if (appState.pids_.empty()) {
+            appState.uid_ = info.uid_;
+            appState.processName_ = info.processName_;
+        }
+        appState.pids_.emplace(info.pid_);
+    }
+    for (const auto& info : queryResult.applicationInfos_) {
+        if (auto iter = appStateMap_.find(info.uid); iter != appStateMap_.end()) {
+            iter->second.bundleName_ = info.name;
+            iter->second.isSystemApp_ = iter->second.isSystemApp_ || info.isSystemApp;
+        }
+    }
+    // apps of special user only contribute system app flag
+    for (const auto& info : queryResult.specialApplicationInfos_) {
+        if (auto iter = appStateMap_.find(info.uid); iter != appStateMap_.end()) {
+            iter->second.isSystemApp_ = iter->second.isSystemApp_ || info.isSystemApp;
+        }
+    }
+    for (const auto& info : queryResult.foregroundApps_) {
+        if (auto iter = appStateMap_.find(info.uid); iter != appStateMap_.end()) {
+            iter->second.isForeground_ = true;
+        }
+    }
+}
+
+void AppStateCache::LoadBgTasks(const AppStateQueryResult& queryResult)
+{
+    #ifdef ENABLE_BACKGROUND_TASK_MGR
+    for (const auto& task : queryResult.continuousTasks_) {
+        auto& appState = appStateMap_[task->GetCreatorUid()];
+        appState.uid_ = task->GetCreatorUid();
+        appState.continuousTaskTypeIds_.emplace(task->GetTypeId());
+    }
+    for (const auto& task : queryResult.transientTasks_) {
+        auto& appState = appStateMap_[task->GetUid()];
+        appState.uid_ = task->GetUid();
+        appState.hasTransientTask_ = true;
+    }
+    #endif
+}
+
+void AppStateCache::LoadRunningWorks(const AppStateQueryResult& queryResult)
+{
+    #ifdef STANDBY_RSS_WORK_SCHEDULER_ENABLE
+    for (const auto& work : queryResult.workInfos_) {
+        auto& appState = appStateMap_[work->GetUid()];
+        appState.uid_ = work->GetUid();
+        ++appState.runningWorkCount_;
+    }
+    #endif
+}
+
+void AppStateCache::HandleEvent(const StandbyMessage& message)
+{
+    switch (message.eventId_) {
+        case StandbyMessageType::PROCESS_STATE_CHANGED:
+            HandleProcessStatusChanged(message);
+            break;
+        case StandbyMessageType::APP_FOREGROUND_STATE_CHANGED:
+            HandleForegroundStateChanged(message);
+            break;
+        case StandbyMessageType::BG_TASK_STATUS_CHANGE:
+            HandleBgTaskStatusChanged(message);
+            break;
+        case StandbyMessageType::SYS_ABILITY_STATUS_CHANGED:
+            HandleSysAbilityStatusChanged(message);
+            break;
+        default:
+            break;
+    }
+}
+
+void AppStateCache::HandleProcessStatusChanged(const StandbyMessage& message)
+{
+    if (!message.want_.has_value()) {
+        return;
+    }
+    int32_t uid = message.want_->GetIntParam("uid", -1);
+    int32_t pid = message.want_->GetIntParam("pid", -1);
+    std::string bundleName = message.want_->GetStringParam("name");
+    bool isCreated = message.want_->GetBoolParam("isCreated", false);
+    std::unique_lock<std::mutex> lock(cacheMutex_);
+    if (!isLoaded_) {
+        return;
+    }
+    ++updateCount_;
+    if (!isCreated) {
+        if (auto iter = appStateMap_.find(uid); iter != appStateMap_.end()) {
+            iter->second.pids_.erase(pid);
+            EraseIfUnused(iter);
+        }
+        return;
+    }
+    auto iter = appStateMap_.find(uid);
+    if (iter != appStateMap_.end() && !iter->second.pids_.empty()) {
+        iter->second.pids_.emplace(pid);
+        return;
+    }
+    // first process of app, system app flag is queried once here instead of by every strategy
+    lock.unlock();
+    bool isSystemApp {false};
+    if (!BundleManagerHelper::GetInstance()->CheckIsSystemAppByUid(uid, isSystemApp)) {
+        isSystemApp = false;
+    }
+    lock.lock();
+    auto& appState = appStateMap_[uid];
+    appState.uid_ = uid;
+    appState.bundleName_ = bundleName;
+    appState.processName_ = bundleName;
+    appState.isSystemApp_ = isSystemApp;
+    appState.isForeground_ = false;
+    appState.pids_.emplace(pid);
+}
+
+void AppStateCache::HandleForegroundStateChanged(const StandbyMessage& message)
+{
+    if (!message.want_.has_value()) {
+        return;
+    }
+    int32_t uid = message.want_->GetIntParam("uid", -1);
+    bool isForeground = message.want_->GetBoolParam("isForeground", false);
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (!isLoaded_) {
+        return;
+    }
+    ++updateCount_;
+    if (auto iter = appStateMap_.find(uid); iter != appStateMap_.end()) {
+        iter->second.isForeground_ = isForeground;
+    }
+}
+
+void AppStateCache::HandleBgTaskStatusChanged(const StandbyMessage& message)
+{
+    if (!message.want_.has_value()) {
+        return;
+    }
+    std::string type = message.want_->GetStringParam(BG_TASK_TYPE);
+    bool started = message.want_->GetBoolParam(BG_TASK_STATUS, false);
+    int32_t uid = message.want_->GetIntParam(BG_TASK_UID, 0);
+    int32_t typeId = message.want_->GetIntParam(BG_TASK_TYPE_ID, -1);
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (!isLoaded_) {
+        return;
+    }
+    ++updateCount_;
+    auto iter = appStateMap_.find(uid);
+    if (iter == appStateMap_.end()) {
+        if (!started) {
+            return;
+        }
+        std::tie(iter, std::ignore) = appStateMap_.emplace(uid, AppStateInfo {});
+        iter->second.uid_ = uid;
+    }
+    auto& appState = iter->second;
+    if (type == CONTINUOUS_TASK) {
+        if (started) {
+            appState.continuousTaskTypeIds_.emplace(typeId);
+        } else if (auto typeIter = appState.continuousTaskTypeIds_.find(typeId);
+            typeIter != appState.continuousTaskTypeIds_.end()) {
+            appState.continuousTaskTypeIds_.erase(typeIter);
+        }
+    } else if (type == TRANSIENT_TASK) {
+        appState.hasTransientTask_ = started;
+    } else if (type == WORK_SCHEDULER) {
+        if (started) {
+            ++appState.runningWorkCount_;
+        } else if (appState.runningWorkCount_ > 0) {
+            --appState.runningWorkCount_;
+        }
+    }
+    EraseIfUnused(iter);
+}
+
+// tasks are lost when bgtask or work scheduler service crash, reload them when service is added again
+void AppStateCache::HandleSysAbilityStatusChanged(const StandbyMessage& message)
+{
+    if (!message.want_.has_value()) {
+        return;
+    }
+    bool isAdded = message.want_->GetBoolParam(SA_STATUS, false);
+    int32_t saId = message.want_->GetIntParam(SA_ID, 0);
+    uint32_t queryMask {0};
+    if (saId == BACKGROUND_TASK_MANAGER_SERVICE_ID) {
+        queryMask = BG_TASK_LOAD_MASK;
+    } else if (saId == WORK_SCHEDULE_SERVICE_ID) {
+        queryMask = SaQueryType::WORK_SCHEDULER;
+    } else {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        if (!isLoaded_) {
+            return;
+        }
+        for (auto iter = appStateMap_.begin(); iter != appStateMap_.end();) {
+            if (queryMask == SaQueryType::WORK_SCHEDULER) {
+                iter->second.runningWorkCount_ = 0;
+            } else {
+                iter->second.continuousTaskTypeIds_.clear();
+                iter->second.hasTransientTask_ = false;
+            }
+            auto curIter = iter++;
+            EraseIfUnused(curIter);
+        }
+    }
+    if (isAdded) {
+        ReloadBgTasks(queryMask);
+    }
+}
+
+void AppStateCache::ReloadBgTasks(uint32_t queryMask)
+{
+    std::shared_ptr<AppStateQueryResult> queryResult {nullptr};
+    if (SaQueryExecutor::GetInstance()->QueryAppStates(queryMask, queryResult) != ERR_OK) {
+        STANDBYSERVICE_LOGW("failed to reload tasks, app state cache is invalidated");
+        Clear();
+        return;
+    }
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (!isLoaded_) {
+        return;
+    }
+    if (queryMask == SaQueryType::WORK_SCHEDULER) {
+        LoadRunningWorks(*queryResult);
+    } else {
+        LoadBgTasks(*queryResult);
+    }
+}
+
+void AppStateCache::EraseIfUnused(std::unordered_map<int32_t, AppStateInfo>::iterator iter)
+{
+    const auto& appState = iter->second;
+    if (appState.pids_.empty() && appState.continuousTaskTypeIds_.empty() && !appState.hasTransientTask_ &&
+        appState.runningWorkCount_ == 0) {
+        appStateMap_.erase(iter);
+    }
+}
+
+bool AppStateCache::GetAppState(int32_t uid, AppStateInfo& info)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    auto iter = appStateMap_.find(uid);
+    if (iter == appStateMap_.end()) {
+        return false;
+    }
+    info = iter->second;
+    return true;
+}
+
+bool AppStateCache::IsSystemApp(int32_t uid)
+{
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        if (auto iter = appStateMap_.find(uid); iter != appStateMap_.end() && !iter->second.pids_.empty()) {
+            return iter->second.isSystemApp_;
+        }
+    }
+    bool isSystemApp {false};
+    return BundleManagerHelper::GetInstance()->CheckIsSystemAppByUid(uid, isSystemApp) && isSystemApp;
+}
+
+void AppStateCache::ForEachRunningApp(const std::function<void(const AppStateInfo&)>& func)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    for (const auto& [uid, appState] : appStateMap_) {
+        if (appState.pids_.empty()) {
+            continue;
+        }
+        func(appState);
+    }
+}
+
+void AppStateCache::ShellDump(std::string& result)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    result.append("=================AppStateCache====================\n");
+    result.append("isLoaded: ").append(std::to_string(isLoaded_))
+        .append(" load count: ").append(std::to_string(loadCount_))
+        .append(" last load cost(ms): ").append(std::to_string(lastLoadCostMs_))
+        .append(" incremental update count: ").append(std::to_string(updateCount_))
+        .append(" app size: ").append(std::to_string(appStateMap_.size())).append("\n");
+    for (const auto& [uid, appState] : appStateMap_) {
+        result.append("uid: ").append(std::to_string(uid)).append(" name: ").append(appState.bundleName_)
+            .append(" pid_size: ").append(std::to_string(appState.pids_.size()))
+            .append(" system: ").append(std::to_string(appState.isSystemApp_))
+            .append(" foreground: ").append(std::to_string(appState.isForeground_))
+            .append(" continuous: ").append(std::to_string(appState.continuousTaskTypeIds_.size()))
+            .append(" transient: ").append(std::to_string(appState.hasTransientTask_))
+            .append(" work: ").append(std::to_string(appState.runningWorkCount_)).append("\n");
+    }
+}
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
@@ -35,6 +35,7 @@
 #include "time_provider.h"
 #include "standby_service_impl.h"
 #include "common_constant.h"
+#include "app_state_cache.h"
 
 namespace OHOS {
 namespace DevStandbyMgr {
@@ -45,11 +46,14 @@ const std::map<std::string, uint8_t> BGTASK_EXEMPTION_FLAG_MAP {
     {WORK_SCHEDULER, ExemptionTypeFlag::WORK_SCHEDULER},
 };
 const std::string CONDITIONAL_RESTRICT_NET_APP_TAG = "conditional_restrict_net_app";
+const std::string FLUSH_FIREWALL_LIST_TASK = "FlushFirewallAllowedListTask";
+// buffered uid changes are sent no later than this delay after the first one, in ms
+constexpr int64_t FLUSH_FIREWALL_LIST_DELAY = 200;
 }
 
 bool BaseNetworkStrategy::isFirewallEnabled_ = false;
 bool BaseNetworkStrategy::isNightSleepMode_ = false;
-std::unordered_map<std::int32_t, NetLimtedAppInfo> BaseNetworkStrategy::netLimitedAppInfo_;
+ExemptionTable BaseNetworkStrategy::netLimitedAppInfo_;
 static std::mutex mutex_;
 
 void BaseNetworkStrategy::HandleEvent(const StandbyMessage& message)
@@ -77,6 +81,7 @@ void BaseNetworkStrategy::HandleEvent(const StandbyMessage& message)
 ErrCode BaseNetworkStrategy::OnCreated()
 {
     // when initialized, stop net limit mode in case of unexpected process restart
+    ClearPendingFirewallList();
     ResetFirewallAllowList();
     isFirewallEnabled_ = false;
     isIdleMaintence_ = false;
@@ -85,6 +90,7 @@ ErrCode BaseNetworkStrategy::OnCreated()
 
 ErrCode BaseNetworkStrategy::OnDestroy()
 {
+    ClearPendingFirewallList();
     ResetFirewallAllowList();
     return ERR_OK;
 }
@@ -119,8 +125,9 @@ ErrCode BaseNetworkStrategy::UpdateExemptionList(const StandbyMessage& message)
 
 ErrCode BaseNetworkStrategy::UpdateFirewallAllowList()
 {
+    ClearPendingFirewallList();
     ResetFirewallAllowList();
-    netLimitedAppInfo_.clear();
+    netLimitedAppInfo_.Clear();
     if (InitNetLimitedAppInfo() != ERR_OK) {
         return ERR_STRATEGY_DEPENDS_SA_NOT_AVAILABLE;
     }
@@ -131,6 +138,91 @@ ErrCode BaseNetworkStrategy::UpdateFirewallAllowList()
     return ERR_OK;
 }
 
+ErrCode BaseNetworkStrategy::UpdateConditionalAllowList()
+{
+    if (!isFirewallEnabled_) {
+        return UpdateFirewallAllowList();
+    }
+    // firewall allow list was calculated in the opposite condition before switch
+    uint32_t preCondition = (condition_ == ConditionType::NIGHT_STANDBY) ?
+        ConditionType::DAY_STANDBY : ConditionType::NIGHT_STANDBY;
+    auto sensitiveNames = StandbyConfigManager::GetInstance()->GetConditionSensitiveNames("NETWORK");
+    auto conditionalRestrictNameSet =
+        StandbyConfigManager::GetInstance()->GetStandbyListParaSet(CONDITIONAL_RESTRICT_NET_APP_TAG);
+    std::vector<AllowInfo> allowInfoList {};
+    StandbyServiceImpl::GetInstance()->GetAllowListInner(AllowType::NETWORK, allowInfoList,
+        ReasonCodeEnum::REASON_APP_API);
+    NameIdSet allowNameIds {};
+    for (const auto& info : allowInfoList) {
+        if (NameId nameId = NameInterner::GetInstance().Find(info.GetName()); nameId != INVALID_NAME_ID) {
+            allowNameIds.emplace(nameId);
+        }
+    }
+    std::set<std::string> restrictNameList {};
+    StandbyServiceImpl::GetInstance()->GetEligiableRestrictSet(AllowType::NETWORK, "NETWORK",
+        ReasonCodeEnum::REASON_APP_API, restrictNameList);
+    NameIdSet restrictNameIds {};
+    NameInterner::GetInstance().FindAll(restrictNameList, restrictNameIds);
+    // uid with continuous task, mapped to whether the task is exempted in current condition
+    std::unordered_map<int32_t, bool> continuousTaskUidMap {};
+    #ifdef ENABLE_BACKGROUND_TASK_MGR
+    AppStateCache::GetInstance()->ForEachRunningApp([this, &continuousTaskUidMap](const AppStateInfo& appState) {
+        if (appState.continuousTaskTypeIds_.empty()) {
+            return;
+        }
+        bool isExempted = std::any_of(appState.continuousTaskTypeIds_.begin(), appState.continuousTaskTypeIds_.end(),
+            [this](int32_t typeId) {
+                return condition_ == ConditionType::DAY_STANDBY ||
+                    (typeId >= 0 && (nightExemptionTaskType_ & (1 << typeId)) != 0);
+            });
+        continuousTaskUidMap.emplace(appState.uid_, isExempted);
+    });
+    #endif
+    uint32_t reevaluatedCount = 0;
+    for (size_t row = 0; row < netLimitedAppInfo_.Size(); ++row) {
+        int32_t uid = netLimitedAppInfo_.GetUid(row);
+        NameId nameId = netLimitedAppInfo_.GetNameId(row);
+        uint8_t appFlag = netLimitedAppInfo_.GetFlag(row);
+        auto continuousTaskIter = continuousTaskUidMap.find(uid);
+        // system app is not exempted in night, so is continuous task not in night exemption types
+        bool isSensitive = (sensitiveNames != nullptr && sensitiveNames->count(nameId) != 0)
+            || (appFlag & (ExemptionTypeFlag::UNRESTRICTED | ExemptionTypeFlag::CONTINUOUS_TASK)) != 0
+            || continuousTaskIter != continuousTaskUidMap.end();
+        if (!isSensitive) {
+            continue;
+        }
+        uint8_t flag = appFlag & (~(ExemptionTypeFlag::EXEMPTION | ExemptionTypeFlag::RESTRICTED));
+        #ifdef ENABLE_BACKGROUND_TASK_MGR
+        flag &= (~ExemptionTypeFlag::CONTINUOUS_TASK);
+        if (continuousTaskIter != continuousTaskUidMap.end() && continuousTaskIter->second) {
+            flag |= ExemptionTypeFlag::CONTINUOUS_TASK;
+        }
+        #endif
+        if (allowNameIds.count(nameId) != 0) {
+            flag |= ExemptionTypeFlag::EXEMPTION;
+        }
+        if (restrictNameIds.count(nameId) != 0) {
+            flag |= ExemptionTypeFlag::RESTRICTED;
+        }
+        if (conditionalRestrictNameSet != nullptr && conditionalRestrictNameSet->count(nameId) != 0 &&
+            (flag & (~ExemptionTypeFlag::UNRESTRICTED)) == 0) {
+            flag |= ExemptionTypeFlag::RESTRICTED;
+        }
+        bool wasExempted = IsFlagExemptedInCondition(appFlag, preCondition);
+        bool isExempted = IsFlagExemptedInCondition(flag, condition_);
+        netLimitedAppInfo_.SetFlag(row, flag);
+        if (wasExempted != isExempted) {
+            AddPendingFirewallUid(uid, isExempted);
+        }
+        ++reevaluatedCount;
+    }
+    conditionReevaluatedCount_ += reevaluatedCount;
+    STANDBYSERVICE_LOGI("condition changed, reevaluate %{public}u of %{public}d apps", reevaluatedCount,
+        static_cast<int32_t>(netLimitedAppInfo_.Size()));
+    FlushPendingFirewallList();
+    return ERR_OK;
+}
+
 ErrCode BaseNetworkStrategy::EnableNetworkFirewall(const StandbyMessage& message)
 {
     if (isFirewallEnabled_) {
@@ -151,7 +243,8 @@ ErrCode BaseNetworkStrategy::EnableNetworkFirewall(const StandbyMessage& message
 
 ErrCode BaseNetworkStrategy::EnableNetworkFirewallInner()
 {
-    netLimitedAppInfo_.clear();
+    ClearPendingFirewallList();
+    netLimitedAppInfo_.Clear();
     if (InitNetLimitedAppInfo() != ERR_OK) {
         return ERR_STRATEGY_DEPENDS_SA_NOT_AVAILABLE;
     }
@@ -162,32 +255,13 @@ ErrCode BaseNetworkStrategy::EnableNetworkFirewallInner()
 // get app info, add exemption according to the status of app.
 ErrCode BaseNetworkStrategy::InitNetLimitedAppInfo()
 {
-    if (GetAllRunningAppInfo() != ERR_OK) {
+    // app states are kept current by events, no system ability is queried unless cache is invalidated
+    if (AppStateCache::GetInstance()->EnsureLoaded() != ERR_OK) {
         return ERR_STRATEGY_DEPENDS_SA_NOT_AVAILABLE;
     }
-    std::vector<AppExecFwk::ApplicationInfo> applicationInfos {};
-    if (!BundleManagerHelper::GetInstance()->GetApplicationInfos(
-        AppExecFwk::ApplicationFlag::GET_BASIC_APPLICATION_INFO,
-        AppExecFwk::Constants::ALL_USERID, applicationInfos)) {
-        STANDBYSERVICE_LOGW("failed to get all applicationInfos");
+    if (GetAllRunningAppInfo() != ERR_OK) {
         return ERR_STRATEGY_DEPENDS_SA_NOT_AVAILABLE;
     }
-    if (!BundleManagerHelper::GetInstance()->GetApplicationInfos(
-        AppExecFwk::ApplicationFlag::GET_BASIC_APPLICATION_INFO,
-        UserSpace::SPECIAL_USERID, applicationInfos)) {
-        STANDBYSERVICE_LOGW("failed to get special applicationInfos");
-    }
-    STANDBYSERVICE_LOGI("succeed GetApplicationInfos, size is %{public}d",
-        static_cast<int32_t>(applicationInfos.size()));
-    for (const auto& info : applicationInfos) {
-        if (netLimitedAppInfo_.find(info.uid) == netLimitedAppInfo_.end()) {
-            continue;
-        }
-        if (info.isSystemApp) {
-            netLimitedAppInfo_[info.uid].appExemptionFlag_ |= ExemptionTypeFlag::UNRESTRICTED;
-        }
-    }
-
     if (GetForegroundApplications() !=ERR_OK || GetBackgroundTaskApp() != ERR_OK ||
         GetWorkSchedulerTask() != ERR_OK || GetExemptionConfig() != ERR_OK) {
         return ERR_STRATEGY_DEPENDS_SA_NOT_AVAILABLE;
@@ -197,61 +271,47 @@ ErrCode BaseNetworkStrategy::InitNetLimitedAppInfo()
 
 ErrCode BaseNetworkStrategy::GetAllRunningAppInfo()
 {
-    std::vector<AppExecFwk::RunningProcessInfo> allAppProcessInfos {};
-    if (!AppMgrHelper::GetInstance()->GetAllRunningProcesses(allAppProcessInfos)) {
-        STANDBYSERVICE_LOGE("connect to app manager service failed");
-        return ERR_STRATEGY_DEPENDS_SA_NOT_AVAILABLE;
-    }
-    STANDBYSERVICE_LOGI("current running processes size %{public}d", static_cast<int32_t>(allAppProcessInfos.size()));
     std::lock_guard<std::mutex> lock(mutex_);
-    for (const auto &info : allAppProcessInfos) {
-        netLimitedAppInfo_.emplace(info.uid_, NetLimtedAppInfo {info.processName_});
-    }
+    // system apps defaultly not be restricted
+    AppStateCache::GetInstance()->ForEachRunningApp([](const AppStateInfo& appState) {
+        size_t row = netLimitedAppInfo_.Find(appState.uid_);
+        if (row == ExemptionTable::NPOS) {
+            row = netLimitedAppInfo_.Emplace(appState.uid_, appState.processName_).first;
+        }
+        if (appState.isSystemApp_) {
+            netLimitedAppInfo_.AddFlag(row, ExemptionTypeFlag::UNRESTRICTED);
+        }
+    });
+    STANDBYSERVICE_LOGI("current running app size %{public}d", static_cast<int32_t>(netLimitedAppInfo_.Size()));
     return ERR_OK;
 }
 
 ErrCode BaseNetworkStrategy::GetForegroundApplications()
 {
-    std::vector<AppExecFwk::AppStateData> fgApps {};
-    if (!AppMgrHelper::GetInstance()->GetForegroundApplications(fgApps)) {
-        STANDBYSERVICE_LOGW("get foreground app failed");
-        return ERR_STRATEGY_DEPENDS_SA_NOT_AVAILABLE;
-    }
-    for (const auto& appInfo : fgApps) {
-        AddExemptionFlagByUid(appInfo.uid, ExemptionTypeFlag::FOREGROUND_APP);
-    }
+    AppStateCache::GetInstance()->ForEachRunningApp([this](const AppStateInfo& appState) {
+        if (appState.isForeground_) {
+            AddExemptionFlagByUid(appState.uid_, ExemptionTypeFlag::FOREGROUND_APP);
+        }
+    });
     return ERR_OK;
 }
 
 ErrCode BaseNetworkStrategy::GetBackgroundTaskApp()
 {
     #ifdef ENABLE_BACKGROUND_TASK_MGR
-    std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> continuousTaskList;
-    if (!BackgroundTaskHelper::GetInstance()->GetContinuousTaskApps(continuousTaskList)) {
-        STANDBYSERVICE_LOGW("get continuous task app failed");
-        return ERR_STRATEGY_DEPENDS_SA_NOT_AVAILABLE;
-    }
-    STANDBYSERVICE_LOGD("succeed GetContinuousTaskApps, size is %{public}d",
-        static_cast<int32_t>(continuousTaskList.size()));
-    std::vector<std::shared_ptr<TransientTaskAppInfo>> transientTaskList;
-    if (!BackgroundTaskHelper::GetInstance()->GetTransientTaskApps(transientTaskList)) {
-        STANDBYSERVICE_LOGW("get transient task app failed");
-        return ERR_STRATEGY_DEPENDS_SA_NOT_AVAILABLE;
-    }
-    STANDBYSERVICE_LOGD("succeed GetTransientTaskApps, size is %{public}d",
-        static_cast<int32_t>(transientTaskList.size()));
     condition_ = TimeProvider::GetCondition();
-    for (const auto& task : continuousTaskList) {
-        if (auto infoIter = netLimitedAppInfo_.find(task->GetCreatorUid()); infoIter == netLimitedAppInfo_.end()) {
-            continue;
-        } else if (condition_ == ConditionType::DAY_STANDBY ||
-            (nightExemptionTaskType_ & (1<< task->GetTypeId())) != 0) {
-            infoIter->second.appExemptionFlag_ |= ExemptionTypeFlag::CONTINUOUS_TASK;
+    AppStateCache::GetInstance()->ForEachRunningApp([this](const AppStateInfo& appState) {
+        for (const auto typeId : appState.continuousTaskTypeIds_) {
+            if (condition_ == ConditionType::DAY_STANDBY || (typeId >= 0 &&
+                (nightExemptionTaskType_ & (1 << typeId)) != 0)) {
+                AddExemptionFlagByUid(appState.uid_, ExemptionTypeFlag::CONTINUOUS_TASK);
+                break;
+            }
         }
-    }
-    for (const auto& task : transientTaskList) {
-        AddExemptionFlagByUid(task->GetUid(), ExemptionTypeFlag::TRANSIENT_TASK);
-    }
+        if (appState.hasTransientTask_) {
+            AddExemptionFlagByUid(appState.uid_, ExemptionTypeFlag::TRANSIENT_TASK);
+        }
+    });
     #endif
     return ERR_OK;
 }
@@ -259,22 +319,19 @@ ErrCode BaseNetworkStrategy::GetBackgroundTaskApp()
 ErrCode BaseNetworkStrategy::GetWorkSchedulerTask()
 {
     #ifdef STANDBY_RSS_WORK_SCHEDULER_ENABLE
-    std::list<std::shared_ptr<WorkScheduler::WorkInfo>> workInfos;
-    if (WorkScheduler::WorkSchedulerSrvClient::GetInstance().GetAllRunningWorks(workInfos) != ERR_OK) {
-        return ERR_STRATEGY_DEPENDS_SA_NOT_AVAILABLE;
-    }
-    STANDBYSERVICE_LOGD("GetWorkSchedulerTask succeed, size is %{public}d", static_cast<int32_t>(workInfos.size()));
-    for (const auto& task : workInfos) {
-        AddExemptionFlagByUid(task->GetUid(), ExemptionTypeFlag::WORK_SCHEDULER);
-    }
+    AppStateCache::GetInstance()->ForEachRunningApp([this](const AppStateInfo& appState) {
+        if (appState.runningWorkCount_ > 0) {
+            AddExemptionFlagByUid(appState.uid_, ExemptionTypeFlag::WORK_SCHEDULER);
+        }
+    });
     #endif
     return ERR_OK;
 }
 
 void BaseNetworkStrategy::AddExemptionFlagByUid(int32_t uid, uint8_t flag)
 {
-    if (auto iter = netLimitedAppInfo_.find(uid); iter != netLimitedAppInfo_.end()) {
-        iter->second.appExemptionFlag_ |= flag;
+    if (size_t row = netLimitedAppInfo_.Find(uid); row != ExemptionTable::NPOS) {
+        netLimitedAppInfo_.AddFlag(row, flag);
     }
 }
 
@@ -284,42 +341,48 @@ ErrCode BaseNetworkStrategy::GetExemptionConfig()
     std::vector<AllowInfo> allowInfoList {};
     StandbyServiceImpl::GetInstance()->GetAllowListInner(AllowType::NETWORK, allowInfoList,
         ReasonCodeEnum::REASON_APP_API);
-    std::set<std::string> allowNameList {};
+    NameIdSet allowNameIds {};
     for (const auto& info : allowInfoList) {
-        allowNameList.emplace(info.GetName());
+        if (NameId nameId = NameInterner::GetInstance().Find(info.GetName()); nameId != INVALID_NAME_ID) {
+            allowNameIds.emplace(nameId);
+        }
     }
-    for (auto& [key, value] : netLimitedAppInfo_) {
-        if (allowNameList.find(value.name_) == allowNameList.end()) {
+    for (size_t row = 0; row < netLimitedAppInfo_.Size(); ++row) {
+        if (allowNameIds.count(netLimitedAppInfo_.GetNameId(row)) == 0) {
             continue;
         }
-        value.appExemptionFlag_ |= ExemptionTypeFlag::EXEMPTION;
+        netLimitedAppInfo_.AddFlag(row, ExemptionTypeFlag::EXEMPTION);
     }
     // if app in restricted list, add retricted flag
     std::set<std::string> restrictNameList {};
     StandbyServiceImpl::GetInstance()->GetEligiableRestrictSet(AllowType::NETWORK, "NETWORK",
         ReasonCodeEnum::REASON_APP_API, restrictNameList);
-    for (auto& [key, value] : netLimitedAppInfo_) {
-        if (restrictNameList.find(value.name_) == restrictNameList.end()) {
+    NameIdSet restrictNameIds {};
+    NameInterner::GetInstance().FindAll(restrictNameList, restrictNameIds);
+    for (size_t row = 0; row < netLimitedAppInfo_.Size(); ++row) {
+        if (restrictNameIds.count(netLimitedAppInfo_.GetNameId(row)) == 0) {
             continue;
         }
-        value.appExemptionFlag_ |= ExemptionTypeFlag::RESTRICTED;
+        netLimitedAppInfo_.AddFlag(row, ExemptionTypeFlag::RESTRICTED);
     }
     // if app in conditional restricted list and not exempted, add retricted flag
-    std::vector<std::string> conditionalRestrictNameList =
-        StandbyConfigManager::GetInstance()->GetStandbyListPara(CONDITIONAL_RESTRICT_NET_APP_TAG);
-    for (auto& [key, value] : netLimitedAppInfo_) {
-        auto it = std::find(conditionalRestrictNameList.begin(), conditionalRestrictNameList.end(), value.name_);
-        if (it == conditionalRestrictNameList.end()) {
+    auto conditionalRestrictNameSet =
+        StandbyConfigManager::GetInstance()->GetStandbyListParaSet(CONDITIONAL_RESTRICT_NET_APP_TAG);
+    if (conditionalRestrictNameSet == nullptr || conditionalRestrictNameSet->empty()) {
+        return ERR_OK;
+    }
+    for (size_t row = 0; row < netLimitedAppInfo_.Size(); ++row) {
+        if (conditionalRestrictNameSet->count(netLimitedAppInfo_.GetNameId(row)) == 0) {
             continue;
         }
-        if ((value.appExemptionFlag_ & (~ExemptionTypeFlag::UNRESTRICTED)) == 0) {
-            value.appExemptionFlag_ |= ExemptionTypeFlag::RESTRICTED;
+        if ((netLimitedAppInfo_.GetFlag(row) & (~ExemptionTypeFlag::UNRESTRICTED)) == 0) {
+            netLimitedAppInfo_.AddFlag(row, ExemptionTypeFlag::RESTRICTED);
         }
     }
     return ERR_OK;
 }
 
-ErrCode BaseNetworkStrategy::GetExemptionConfigForApp(NetLimtedAppInfo& appInfo, const std::string& bundleName)
+ErrCode BaseNetworkStrategy::GetExemptionConfigForApp(size_t row, const std::string& bundleName)
 {
     // if app in exemption list, add exemption flag
     std::vector<AllowInfo> allowInfoList {};
@@ -330,7 +393,7 @@ ErrCode BaseNetworkStrategy::GetExemptionConfigForApp(NetLimtedAppInfo& appInfo,
         if (info.GetName() != bundleName) {
             continue;
         }
-        appInfo.appExemptionFlag_ |= ExemptionTypeFlag::EXEMPTION;
+        netLimitedAppInfo_.AddFlag(row, ExemptionTypeFlag::EXEMPTION);
     }
 
     // if app in restricted list, add retricted flag
@@ -338,16 +401,13 @@ ErrCode BaseNetworkStrategy::GetExemptionConfigForApp(NetLimtedAppInfo& appInfo,
     StandbyServiceImpl::GetInstance()->GetEligiableRestrictSet(AllowType::NETWORK, "NETWORK",
         ReasonCodeEnum::REASON_APP_API, restrictNameList);
     if (restrictNameList.find(bundleName) != restrictNameList.end()) {
-        appInfo.appExemptionFlag_ |= ExemptionTypeFlag::RESTRICTED;
+        netLimitedAppInfo_.AddFlag(row, ExemptionTypeFlag::RESTRICTED);
     }
 
     // if app in conditional restricted list and not exempted, add retricted flag
-    std::vector<std::string> conditionalRestrictNameList =
-        StandbyConfigManager::GetInstance()->GetStandbyListPara(CONDITIONAL_RESTRICT_NET_APP_TAG);
-    auto it = std::find(conditionalRestrictNameList.begin(), conditionalRestrictNameList.end(), bundleName);
-    if (it != conditionalRestrictNameList.end()) {
-        if ((appInfo.appExemptionFlag_ & (~ExemptionTypeFlag::UNRESTRICTED)) == 0) {
-            appInfo.appExemptionFlag_ |= ExemptionTypeFlag::RESTRICTED;
+    if (IsConditionalRestrictApp(bundleName)) {
+        if ((netLimitedAppInfo_.GetFlag(row) & (~ExemptionTypeFlag::UNRESTRICTED)) == 0) {
+            netLimitedAppInfo_.AddFlag(row, ExemptionTypeFlag::RESTRICTED);
         }
     }
     return ERR_OK;
@@ -356,16 +416,9 @@ ErrCode BaseNetworkStrategy::GetExemptionConfigForApp(NetLimtedAppInfo& appInfo,
 void BaseNetworkStrategy::SetNetAllowApps(bool isAllow)
 {
     std::vector<uint32_t> uids;
-    for (const auto& [key, value] : netLimitedAppInfo_) {
-        if (!IsFlagExempted(value.appExemptionFlag_)) {
-            continue;
-        }
-        uids.emplace_back(key);
-        STANDBYSERVICE_LOGD("uid: %{public}d, name: %{public}s, isAllow: %{public}d",
-            key, value.name_.c_str(), isAllow);
-    }
-    STANDBYSERVICE_LOGD("all application size: %{public}d, network allow: %{public}d",
-        static_cast<int32_t>(netLimitedAppInfo_.size()), static_cast<int32_t>(uids.size()));
+    netLimitedAppInfo_.CollectUids(GetExemptionFlagFilter(TimeProvider::GetCondition()), uids);
+    STANDBYSERVICE_LOGD("all application size: %{public}d, network allow: %{public}d, isAllow: %{public}d",
+        static_cast<int32_t>(netLimitedAppInfo_.Size()), static_cast<int32_t>(uids.size()), isAllow);
     SetFirewallAllowedList(uids, isAllow);
 }
 
@@ -381,12 +434,14 @@ ErrCode BaseNetworkStrategy::DisableNetworkFirewall(const StandbyMessage& messag
         preState, curState, static_cast<int32_t>(isFirewallEnabled_));
     if ((curState == StandbyState::MAINTENANCE) && (preState == StandbyState::SLEEP)) {
         // restart net limit mode
+        FlushPendingFirewallList();
         SetFirewallStatus(false);
         isIdleMaintence_ = true;
         isFirewallEnabled_ = false;
     } else if ((curState == StandbyState::SLEEP) && (preState == StandbyState::MAINTENANCE)) {
         isIdleMaintence_ = false;
         // stop net limit mode
+        FlushPendingFirewallList();
         SetFirewallStatus(true);
         isFirewallEnabled_ = true;
     } else if (preState == StandbyState::SLEEP || preState == StandbyState::MAINTENANCE) {
@@ -400,8 +455,9 @@ ErrCode BaseNetworkStrategy::DisableNetworkFirewall(const StandbyMessage& messag
 
 ErrCode BaseNetworkStrategy::DisableNetworkFirewallInner()
 {
+    ClearPendingFirewallList();
     ResetFirewallAllowList();
-    netLimitedAppInfo_.clear();
+    netLimitedAppInfo_.Clear();
     return ERR_OK;
 }
 
@@ -484,44 +540,58 @@ void BaseNetworkStrategy::HandleProcessStatusChanged(const StandbyMessage& messa
     condition_ = TimeProvider::GetCondition();
     if (isCreated) {
         GetAndCreateAppInfo(uid, bundleName);
-        auto iter = netLimitedAppInfo_.find(uid);
-        if (!IsFlagExempted(iter->second.appExemptionFlag_)) {
+        size_t row = netLimitedAppInfo_.Find(uid);
+        if (row == ExemptionTable::NPOS || !IsFlagExempted(netLimitedAppInfo_.GetFlag(row))) {
             return;
         }
-        SetFirewallAllowedList({uid}, isCreated);
+        AddPendingFirewallUid(uid, isCreated);
     } else {
         bool isRunning {false};
         if (AppMgrHelper::GetInstance()->GetAppRunningStateByBundleName(bundleName, isRunning) && !isRunning) {
             std::lock_guard<std::mutex> lock(mutex_);
-            auto iter = netLimitedAppInfo_.find(uid);
-            if (iter == netLimitedAppInfo_.end()) {
+            size_t row = netLimitedAppInfo_.Find(uid);
+            if (row == ExemptionTable::NPOS) {
                 return;
             }
-            auto appFlag = iter->second.appExemptionFlag_;
-            netLimitedAppInfo_.erase(uid);
+            auto appFlag = netLimitedAppInfo_.GetFlag(row);
+            netLimitedAppInfo_.Erase(row);
             if (!IsFlagExempted(appFlag)) {
                 STANDBYSERVICE_LOGI("uid: %{public}d flag: %{public}d is not exempted", uid, appFlag);
                 return;
             }
-            SetFirewallAllowedList({uid}, isCreated);
+            AddPendingFirewallUid(uid, isCreated);
         }
     }
 }
 
 bool BaseNetworkStrategy::IsFlagExempted(uint8_t flag)
+{
+    return IsFlagExemptedInCondition(flag, TimeProvider::GetCondition());
+}
+
+bool BaseNetworkStrategy::IsFlagExemptedInCondition(uint8_t flag, uint32_t condition)
 {
     // if app is not exempted
     if (!ExemptionTypeFlag::IsExempted(flag)) {
         return false;
     }
     // if night and app is system app or native process, (flag minus UNRESTRICTED) is not exempted
-    if ((TimeProvider::GetCondition() == ConditionType::NIGHT_STANDBY) &&
+    if ((condition == ConditionType::NIGHT_STANDBY) &&
         (!ExemptionTypeFlag::IsExempted(flag & (~ExemptionTypeFlag::UNRESTRICTED)))) {
         return false;
     }
     return true;
 }
 
+ExemptionFlagFilter BaseNetworkStrategy::GetExemptionFlagFilter(uint32_t condition)
+{
+    ExemptionFlagFilter filter {};
+    for (size_t flag = 0; flag < filter.size(); ++flag) {
+        filter[flag] = IsFlagExemptedInCondition(static_cast<uint8_t>(flag), condition);
+    }
+    return filter;
+}
+
 void BaseNetworkStrategy::AddExemptionFlag(uint32_t uid, const std::string& bundleName, uint8_t flag)
 {
     if (!isFirewallEnabled_) {
@@ -529,22 +599,18 @@ void BaseNetworkStrategy::AddExemptionFlag(uint32_t uid, const std::string& bund
     }
     STANDBYSERVICE_LOGD("AddExemptionFlag uid is %{public}u, flag is %{public}d", uid, flag);
     GetAndCreateAppInfo(uid, bundleName);
-    auto iter = netLimitedAppInfo_.find(uid);
-    if (iter == netLimitedAppInfo_.end()) {
-        netLimitedAppInfo_[uid] = NetLimtedAppInfo {bundleName};
+    size_t row = netLimitedAppInfo_.Find(uid);
+    if (row == ExemptionTable::NPOS) {
+        return;
     }
-    auto lastAppExemptionFlag = iter->second.appExemptionFlag_;
-    iter->second.appExemptionFlag_ |= flag;
-    std::vector<std::string> conditionalRestrictNameList =
-        StandbyConfigManager::GetInstance()->GetStandbyListPara(CONDITIONAL_RESTRICT_NET_APP_TAG);
-    auto it = std::find(conditionalRestrictNameList.begin(), conditionalRestrictNameList.end(), bundleName);
-    if (it != conditionalRestrictNameList.end()) {
-        iter->second.appExemptionFlag_ &= (~ExemptionTypeFlag::RESTRICTED);
+    auto lastAppExemptionFlag = netLimitedAppInfo_.GetFlag(row);
+    netLimitedAppInfo_.AddFlag(row, flag);
+    if (IsConditionalRestrictApp(bundleName)) {
+        netLimitedAppInfo_.RemoveFlag(row, ExemptionTypeFlag::RESTRICTED);
     }
-    if (GetExemptedFlag(lastAppExemptionFlag, iter->second.appExemptionFlag_)) {
-        SetFirewallAllowedList({iter->first}, true);
+    if (GetExemptedFlag(lastAppExemptionFlag, netLimitedAppInfo_.GetFlag(row))) {
+        AddPendingFirewallUid(uid, true);
     }
-    iter->second.appExemptionFlag_ |= flag;
 }
 
 void BaseNetworkStrategy::RemoveExemptionFlag(uint32_t uid, uint8_t flag)
@@ -552,27 +618,36 @@ void BaseNetworkStrategy::RemoveExemptionFlag(uint32_t uid, uint8_t flag)
     if (!isFirewallEnabled_) {
         return;
     }
-    auto iter = netLimitedAppInfo_.find(uid);
-    if (iter == netLimitedAppInfo_.end()) {
+    size_t row = netLimitedAppInfo_.Find(uid);
+    if (row == ExemptionTable::NPOS) {
         return;
     }
 
     STANDBYSERVICE_LOGD("RemoveExemptionFlag uid is flag is %{public}d, flag is %{public}d", uid, flag);
-    auto lastAppExemptionFlag = iter->second.appExemptionFlag_;
-    iter->second.appExemptionFlag_ &= (~flag);
-    std::vector<std::string> conditionalRestrictNameList =
-        StandbyConfigManager::GetInstance()->GetStandbyListPara(CONDITIONAL_RESTRICT_NET_APP_TAG);
-    auto it = std::find(conditionalRestrictNameList.begin(), conditionalRestrictNameList.end(), iter->second.name_);
-    if (it != conditionalRestrictNameList.end()) {
-        if ((iter->second.appExemptionFlag_ & (~ExemptionTypeFlag::UNRESTRICTED)) == 0) {
-            iter->second.appExemptionFlag_ |= ExemptionTypeFlag::RESTRICTED;
+    auto lastAppExemptionFlag = netLimitedAppInfo_.GetFlag(row);
+    netLimitedAppInfo_.RemoveFlag(row, flag);
+    if (IsConditionalRestrictApp(netLimitedAppInfo_.GetNameId(row))) {
+        if ((netLimitedAppInfo_.GetFlag(row) & (~ExemptionTypeFlag::UNRESTRICTED)) == 0) {
+            netLimitedAppInfo_.AddFlag(row, ExemptionTypeFlag::RESTRICTED);
         }
     }
-    if (GetExemptedFlag(iter->second.appExemptionFlag_, lastAppExemptionFlag)) {
-        SetFirewallAllowedList({iter->first}, false);
+    if (GetExemptedFlag(netLimitedAppInfo_.GetFlag(row), lastAppExemptionFlag)) {
+        AddPendingFirewallUid(uid, false);
     }
 }
 
+bool BaseNetworkStrategy::IsConditionalRestrictApp(const std::string& bundleName)
+{
+    return IsConditionalRestrictApp(NameInterner::GetInstance().Find(bundleName));
+}
+
+bool BaseNetworkStrategy::IsConditionalRestrictApp(NameId nameId)
+{
+    auto conditionalRestrictNameSet =
+        StandbyConfigManager::GetInstance()->GetStandbyListParaSet(CONDITIONAL_RESTRICT_NET_APP_TAG);
+    return conditionalRestrictNameSet != nullptr && conditionalRestrictNameSet->count(nameId) != 0;
+}
+
 bool BaseNetworkStrategy::GetExemptedFlag(uint8_t appNoExemptionFlag, uint8_t appExemptionFlag)
 {
     condition_ = TimeProvider::GetCondition();
@@ -637,18 +712,16 @@ ErrCode BaseNetworkStrategy::SetFirewallStatus(bool enableFirewall)
 // when app is created, add app info to cache
 void BaseNetworkStrategy::GetAndCreateAppInfo(uint32_t uid, const std::string& bundleName)
 {
-    auto iter = netLimitedAppInfo_.find(uid);
-    if (iter != netLimitedAppInfo_.end()) {
+    if (netLimitedAppInfo_.Find(uid) != ExemptionTable::NPOS) {
         return;
     }
     std::lock_guard<std::mutex> lock(mutex_);
-    std::tie(iter, std::ignore) = netLimitedAppInfo_.emplace(uid, NetLimtedAppInfo {bundleName});
+    size_t row = netLimitedAppInfo_.Emplace(uid, bundleName).first;
 
-    bool isSystemApp {false};
-    if (BundleManagerHelper::GetInstance()->CheckIsSystemAppByUid(uid, isSystemApp) && isSystemApp) {
-        iter->second.appExemptionFlag_ |= ExemptionTypeFlag::UNRESTRICTED;
+    if (AppStateCache::GetInstance()->IsSystemApp(uid)) {
+        netLimitedAppInfo_.AddFlag(row, ExemptionTypeFlag::UNRESTRICTED);
     }
-    GetExemptionConfigForApp(iter->second, bundleName);
+    GetExemptionConfigForApp(row, bundleName);
 }
 
 // when bgtask or work_scheduler service crash, reset relative flag
@@ -670,13 +743,86 @@ void BaseNetworkStrategy::ResetFirewallStatus(const StandbyMessage& message)
         return;
     }
     const uint8_t bgTaskFlag = (ExemptionTypeFlag::TRANSIENT_TASK | ExemptionTypeFlag::WORK_SCHEDULER);
-    for (const auto& [key, value] : netLimitedAppInfo_) {
-        if ((value.appExemptionFlag_ & bgTaskFlag) == 0) {
-            continue;
+    // only flags are changed, rows stay where they are
+    netLimitedAppInfo_.ForEachRowWithAnyFlag(bgTaskFlag, [this, bgTaskFlag](size_t row) {
+        RemoveExemptionFlag(netLimitedAppInfo_.GetUid(row), (netLimitedAppInfo_.GetFlag(row) & bgTaskFlag));
+    });
+    // all uids of the crashed service are sent in one call
+    FlushPendingFirewallList();
+}
+
+void BaseNetworkStrategy::AddPendingFirewallUid(uint32_t uid, bool isAdded)
+{
+    auto& sameList = isAdded ? pendingAllowedUids_ : pendingRemovedUids_;
+    auto& oppositeList = isAdded ? pendingRemovedUids_ : pendingAllowedUids_;
+    // opposite change of the same uid has not been sent yet, they cancel each other out
+    if (oppositeList.erase(uid) == 0) {
+        sameList.emplace(uid);
+    }
+    ++pendingFirewallOpCount_;
+    auto handler = StandbyServiceImpl::GetInstance()->GetHandler();
+    if (handler == nullptr) {
+        FlushPendingFirewallList();
+        return;
+    }
+    if (isFlushTaskPosted_) {
+        return;
+    }
+    // the strategy may be destroyed before the task runs, nothing keeps one not owned by shared_ptr alive
+    std::weak_ptr<BaseNetworkStrategy> weakStrategy = weak_from_this();
+    if (weakStrategy.expired()) {
+        FlushPendingFirewallList();
+        return;
+    }
+    isFlushTaskPosted_ = true;
+    handler->PostTask([weakStrategy]() {
+        auto strategy = weakStrategy.lock();
+        if (strategy == nullptr) {
+            return;
+        }
+        strategy->isFlushTaskPosted_ = false;
+        strategy->FlushPendingFirewallList();
+        }, FLUSH_FIREWALL_LIST_TASK, FLUSH_FIREWALL_LIST_DELAY);
+}
+
+void BaseNetworkStrategy::FlushPendingFirewallList()
+{
+    if (isFlushTaskPosted_) {
+        if (auto handler = StandbyServiceImpl::GetInstance()->GetHandler(); handler != nullptr) {
+            handler->RemoveTask(FLUSH_FIREWALL_LIST_TASK);
+        }
+        isFlushTaskPosted_ = false;
+    }
+    uint32_t ipcCount = 0;
+    if (!pendingRemovedUids_.empty()) {
+        SetFirewallAllowedList({pendingRemovedUids_.begin(), pendingRemovedUids_.end()}, false);
+        ++ipcCount;
+    }
+    if (!pendingAllowedUids_.empty()) {
+        SetFirewallAllowedList({pendingAllowedUids_.begin(), pendingAllowedUids_.end()}, true);
+        ++ipcCount;
+    }
+    if (pendingFirewallOpCount_ > ipcCount) {
+        savedFirewallIpcCount_ += pendingFirewallOpCount_ - ipcCount;
+    }
+    STANDBYSERVICE_LOGD("flush firewall list, changes: %{public}u, ipc: %{public}u",
+        pendingFirewallOpCount_, ipcCount);
+    pendingFirewallOpCount_ = 0;
+    pendingAllowedUids_.clear();
+    pendingRemovedUids_.clear();
+}
+
+void BaseNetworkStrategy::ClearPendingFirewallList()
+{
+    if (isFlushTaskPosted_) {
+        if (auto handler = StandbyServiceImpl::GetInstance()->GetHandler(); handler != nullptr) {
+            handler->RemoveTask(FLUSH_FIREWALL_LIST_TASK);
         }
-        RemoveExemptionFlag(key, (value.appExemptionFlag_ & bgTaskFlag));
+        isFlushTaskPosted_ = false;
     }
-    return;
+    pendingFirewallOpCount_ = 0;
+    pendingAllowedUids_.clear();
+    pendingRemovedUids_.clear();
 }
 
 std::string BaseNetworkStrategy::UidsToString(const std::vector<uint32_t>& uids)
@@ -696,11 +842,17 @@ void BaseNetworkStrategy::ShellDump(const std::vector<std::string>& argsInStr, s
 {
     result.append("Network Strategy:\n").append("isFirewallEnabled: " + std::to_string(isFirewallEnabled_))
         .append(" isIdleMaintence: " + std::to_string(isIdleMaintence_)).append("\n");
-    result.append("limited app info: \n");
-    for (const auto& [key, value] : netLimitedAppInfo_) {
-        result.append("uid: ").append(std::to_string(key)).append(" name: ").append(value.name_).append(" uid: ")
-            .append(std::to_string(key)).append(" exemption flag: ")
-            .append(std::to_string(value.appExemptionFlag_)).append("\n");
+    result.append("pending allowed uids: ").append(std::to_string(pendingAllowedUids_.size()))
+        .append(" pending removed uids: ").append(std::to_string(pendingRemovedUids_.size()))
+        .append(" saved firewall ipc: ").append(std::to_string(savedFirewallIpcCount_))
+        .append(" condition reevaluated app count: ").append(std::to_string(conditionReevaluatedCount_))
+        .append("\n");
+    result.append("limited app info, size: ").append(std::to_string(netLimitedAppInfo_.Size()))
+        .append(" memory(bytes): ").append(std::to_string(netLimitedAppInfo_.GetMemoryUsage())).append("\n");
+    for (size_t row = 0; row < netLimitedAppInfo_.Size(); ++row) {
+        result.append("uid: ").append(std::to_string(netLimitedAppInfo_.GetUid(row)))
+            .append(" name: ").append(netLimitedAppInfo_.GetName(row)).append(" exemption flag: ")
+            .append(std::to_string(netLimitedAppInfo_.GetFlag(row))).append("\n");
     }
 }
 }  // namespace DevStandbyMgr
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "exemption_table.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace DevStandbyMgr {
+size_t ExemptionTable::Size() const
+{
+    return uids_.size();
+}
+
+bool ExemptionTable::Empty() const
+{
+    return uids_.empty();
+}
+
+void ExemptionTable::Clear()
+{
+    uids_.clear();
+    flags_.clear();
+    nameIds_.clear();
+    pidOffsets_.assign(1, 0);
+    pids_.clear();
+}
+
+size_t ExemptionTable::Find(int32_t uid) const
+{
+    auto iter = std::lower_bound(uids_.begin(), uids_.end(), uid);
+    if (iter == uids_.end() || *iter != uid) {
+        return NPOS;
+    }
+    return static_cast<size_t>(iter - uids_.begin());
+}
+
+size_t ExemptionTable::Find(int32_t uid, const std::string& name) const
+{
+    // a name never interned can not be the name of any row
+    return Find(uid, NameInterner::GetInstance().Find(name));
+}
+
+size_t ExemptionTable::Find(int32_t uid, NameId nameId) const
+{
+    if (nameId == INVALID_NAME_ID) {
+        return NPOS;
+    }
+    for (size_t row = Find(uid); row < uids_.size() && uids_[row] == uid; ++row) {
+        if (nameIds_[row] == nameId) {
+            return row;
+        }
+    }
+    return NPOS;
+}
+
+std::pair<size_t, bool> ExemptionTable::Emplace(int32_t uid, const std::string& name)
+{
+    NameId nameId = NameInterner::GetInstance().Intern(name);
+    if (size_t row = Find(uid, nameId); row != NPOS) {
+        return {row, false};
+    }
+    auto iter = std::upper_bound(uids_.begin(), uids_.end(), uid);
+    size_t row = static_cast<size_t>(iter - uids_.begin());
+    uids_.insert(iter, uid);
+    flags_.insert(flags_.begin() + row, 0);
+    nameIds_.insert(nameIds_.begin() + row, nameId);
+    // new row owns an empty pid range at the start of the next row
+    pidOffsets_.insert(pidOffsets_.begin() + row + 1, pidOffsets_[row]);
+    return {row, true};
+}
+
+void ExemptionTable::Erase(size_t row)
+{
+    if (row >= uids_.size()) {
+        return;
+    }
+    uint32_t pidCount = pidOffsets_[row + 1] - pidOffsets_[row];
+    pids_.erase(pids_.begin() + pidOffsets_[row], pids_.begin() + pidOffsets_[row + 1]);
+    pidOffsets_.erase(pidOffsets_.begin() + row + 1);
+    for (size_t index = row + 1; index < pidOffsets_.size(); ++index) {
+        pidOffsets_[index] -= pidCount;
+    }
+    uids_.erase(uids_.begin() + row);
+    flags_.erase(flags_.begin() + row);
+    nameIds_.erase(nameIds_.begin() + row);
+}
+
+int32_t ExemptionTable::GetUid(size_t row) const
+{
+    return uids_[row];
+}
+
+const std::string& ExemptionTable::GetName(size_t row) const
+{
+    return NameInterner::GetInstance().GetName(nameIds_[row]);
+}
+
+NameId ExemptionTable::GetNameId(size_t row) const
+{
+    return nameIds_[row];
+}
+
+uint8_t ExemptionTable::GetFlag(size_t row) const
+{
+    return flags_[row];
+}
+
+void ExemptionTable::SetFlag(size_t row, uint8_t flag)
+{
+    flags_[row] = flag;
+}
+
+void ExemptionTable::AddFlag(size_t row, uint8_t flag)
+{
+    flags_[row] |= flag;
+}
+
+void ExemptionTable::RemoveFlag(size_t row, uint8_t flag)
+{
+    flags_[row] &= static_cast<uint8_t>(~flag);
+}
+
+void ExemptionTable::AddPid(size_t row, int32_t pid)
+{
+    auto begin = pids_.begin() + pidOffsets_[row];
+    auto end = pids_.begin() + pidOffsets_[row + 1];
+    auto iter = std::lower_bound(begin, end, pid);
+    if (iter != end && *iter == pid) {
+        return;
+    }
+    pids_.insert(iter, pid);
+    for (size_t index = row + 1; index < pidOffsets_.size(); ++index) {
+        ++pidOffsets_[index];
+    }
+}
+
+bool ExemptionTable::RemovePid(size_t row, int32_t pid)
+{
+    auto begin = pids_.begin() + pidOffsets_[row];
+    auto end = pids_.begin() + pidOffsets_[row + 1];
+    auto iter = std::lower_bound(begin, end, pid);
+    if (iter == end || *iter != pid) {
+        return false;
+    }
+    pids_.erase(iter);
+    for (size_t index = row + 1; index < pidOffsets_.size(); ++index) {
+        --pidOffsets_[index];
+    }
+    return true;
+}
+
+ExemptionTable::PidRange ExemptionTable::GetPids(size_t row) const
+{
+    return {pids_.cbegin() + pidOffsets_[row], pids_.cbegin() + pidOffsets_[row + 1]};
+}
+
+size_t ExemptionTable::GetPidCount(size_t row) const
+{
+    return pidOffsets_[row + 1] - pidOffsets_[row];
+}
+
+void ExemptionTable::CollectUids(const ExemptionFlagFilter& filter, std::vector<uint32_t>& uids) const
+{
+    for (size_t row = 0; row < flags_.size(); ++row) {
+        if (!filter[flags_[row]]) {
+            continue;
+        }
+        // rows of the same uid are adjacent
+        if (uids.empty() || uids.back() != static_cast<uint32_t>(uids_[row])) {
+            uids.emplace_back(static_cast<uint32_t>(uids_[row]));
+        }
+    }
+}
+
+void ExemptionTable::CollectPids(const ExemptionFlagFilter& filter,
+    std::vector<std::pair<int32_t, int32_t>>& pids) const
+{
+    for (size_t row = 0; row < flags_.size(); ++row) {
+        if (!filter[flags_[row]]) {
+            continue;
+        }
+        for (uint32_t index = pidOffsets_[row]; index < pidOffsets_[row + 1]; ++index) {
+            pids.emplace_back(pids_[index], uids_[row]);
+        }
+    }
+}
+
+size_t ExemptionTable::GetMemoryUsage() const
+{
+    return uids_.capacity() * sizeof(int32_t) + flags_.capacity() * sizeof(uint8_t) +
+        nameIds_.capacity() * sizeof(NameId) + pidOffsets_.capacity() * sizeof(uint32_t) +
+        pids_.capacity() * sizeof(int32_t);
+}
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "freeze_backend.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <fstream>
+#include <map>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "standby_service_log.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+namespace {
+const std::string FROZEN_GROUP_NAME = "standby_frozen";
+const std::string CGROUP_PROCS = "/cgroup.procs";
+const std::string CGROUP_FREEZE = "/cgroup.freeze";
+// entry of the unified hierarchy in /proc/<pid>/cgroup
+const std::string CGROUP_V2_PREFIX = "0::";
+
+bool WriteToFd(int32_t fd, const std::string& content)
+{
+    ssize_t ret = TEMP_FAILURE_RETRY(write(fd, content.c_str(), content.size()));
+    return ret == static_cast<ssize_t>(content.size());
+}
+
+bool WriteToFile(const std::string& path, const std::string& content)
+{
+    int32_t fd = TEMP_FAILURE_RETRY(open(path.c_str(), O_WRONLY | O_CLOEXEC));
+    if (fd < 0) {
+        return false;
+    }
+    bool ret = WriteToFd(fd, content);
+    close(fd);
+    return ret;
+}
+}
+
+CgroupFreezerBackend::CgroupFreezerBackend(const std::string& cgroupRoot, const std::string& procRoot)
+    : cgroupRoot_(cgroupRoot), procRoot_(procRoot), frozenGroup_(cgroupRoot + "/" + FROZEN_GROUP_NAME) {}
+
+ErrCode CgroupFreezerBackend::Init()
+{
+    if (mkdir(frozenGroup_.c_str(), S_IRWXU) != 0 && errno != EEXIST) {
+        STANDBYSERVICE_LOGE("failed to create freezer group, errno: %{public}d", errno);
+        return ERR_STRATEGY_FREEZE_BACKEND_FAILED;
+    }
+    if (!WriteToFile(frozenGroup_ + CGROUP_FREEZE, "1")) {
+        STANDBYSERVICE_LOGE("failed to set freezer group frozen, errno: %{public}d", errno);
+        return ERR_STRATEGY_FREEZE_BACKEND_FAILED;
+    }
+    return ERR_OK;
+}
+
+void CgroupFreezerBackend::Freeze(const std::vector<int32_t>& pids, std::vector<int32_t>& frozenPids)
+{
+    if (pids.empty()) {
+        return;
+    }
+    // one write per pid is required by cgroup.procs, the file is opened once for the whole batch
+    int32_t fd = TEMP_FAILURE_RETRY(open((frozenGroup_ + CGROUP_PROCS).c_str(), O_WRONLY | O_CLOEXEC));
+    if (fd < 0) {
+        STANDBYSERVICE_LOGE("failed to open freezer group, errno: %{public}d", errno);
+        return;
+    }
+    for (const auto pid : pids) {
+        if (originGroupMap_.find(pid) != originGroupMap_.end()) {
+            frozenPids.emplace_back(pid);
+            continue;
+        }
+        std::string originGroup = GetCgroupPath(pid);
+        if (originGroup == "/" + FROZEN_GROUP_NAME) {
+            // left frozen by a previous run of the service, root group is the only known place to go back
+            originGroup = "/";
+        }
+        if (!WriteToFd(fd, std::to_string(pid))) {
+            STANDBYSERVICE_LOGD("failed to freeze pid %{public}d, errno: %{public}d", pid, errno);
+            continue;
+        }
+        originGroupMap_.emplace(pid, std::move(originGroup));
+        frozenPids.emplace_back(pid);
+    }
+    close(fd);
+}
+
+void CgroupFreezerBackend::Thaw(const std::vector<int32_t>& pids)
+{
+    // processes are moved back group by group, opening each original group once
+    std::map<std::string, std::vector<int32_t>> groupPidsMap {};
+    for (const auto pid : pids) {
+        auto iter = originGroupMap_.find(pid);
+        if (iter == originGroupMap_.end()) {
+            continue;
+        }
+        groupPidsMap[iter->second].emplace_back(pid);
+        originGroupMap_.erase(iter);
+    }
+    for (const auto& [group, groupPids] : groupPidsMap) {
+        std::string path = cgroupRoot_ + (group == "/" ? "" : group) + CGROUP_PROCS;
+        int32_t fd = TEMP_FAILURE_RETRY(open(path.c_str(), O_WRONLY | O_CLOEXEC));
+        if (fd < 0) {
+            STANDBYSERVICE_LOGE("failed to open origin group, errno: %{public}d", errno);
+            continue;
+        }
+        for (const auto pid : groupPids) {
+            // dead process has left the frozen group by itself
+            if (!WriteToFd(fd, std::to_string(pid))) {
+                STANDBYSERVICE_LOGD("failed to thaw pid %{public}d, errno: %{public}d", pid, errno);
+            }
+        }
+        close(fd);
+    }
+}
+
+void CgroupFreezerBackend::Forget(int32_t pid)
+{
+    originGroupMap_.erase(pid);
+}
+
+std::string CgroupFreezerBackend::GetName() const
+{
+    return "cgroup_v2";
+}
+
+std::string CgroupFreezerBackend::GetCgroupPath(int32_t pid)
+{
+    std::ifstream cgroupFile(procRoot_ + "/" + std::to_string(pid) + "/cgroup");
+    std::string line {};
+    while (std::getline(cgroupFile, line)) {
+        if (line.compare(0, CGROUP_V2_PREFIX.size(), CGROUP_V2_PREFIX) == 0 &&
+            line.size() > CGROUP_V2_PREFIX.size()) {
+            return line.substr(CGROUP_V2_PREFIX.size());
+        }
+    }
+    return "/";
+}
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
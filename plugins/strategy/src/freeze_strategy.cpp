@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "freeze_strategy.h"
+
+#include <algorithm>
+#include <chrono>
+#include <set>
+
+#include "allow_type.h"
+#include "app_state_cache.h"
+#include "common_constant.h"
+#include "name_interner.h"
+#include "standby_config_manager.h"
+#include "standby_service_impl.h"
+#include "standby_service_log.h"
+#include "standby_state.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+namespace {
+const std::string FREEZE_BATCH_SIZE = "freeze_batch_size";
+constexpr int32_t DEFAULT_FREEZE_BATCH_SIZE = 16;
+const std::string FREEZE_BATCH_TASK = "FreezeBatchTask";
+// batches are spread out so that the handler is not occupied by one long freeze, in ms
+constexpr int64_t FREEZE_BATCH_INTERVAL = 200;
+constexpr size_t MAX_RECENT_CYCLE_NUM = 10;
+
+int64_t GetSteadyTimeUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
+FreezeStrategy::FreezeStrategy() : backend_(std::make_shared<CgroupFreezerBackend>()) {}
+
+FreezeStrategy::FreezeStrategy(const std::shared_ptr<IFreezeBackend>& backend) : backend_(backend) {}
+
+void FreezeStrategy::HandleEvent(const StandbyMessage& message)
+{
+    STANDBYSERVICE_LOGD("FreezeStrategy revceived message %{public}u, action: %{public}s",
+        message.eventId_, message.action_.c_str());
+    switch (message.eventId_) {
+        case StandbyMessageType::PHASE_TRANSIT:
+            StartFreeze(message);
+            break;
+        case StandbyMessageType::STATE_TRANSIT:
+            HandleStateTransit(message);
+            break;
+        case StandbyMessageType::ALLOW_LIST_CHANGED:
+            UpdateExemptionList(message);
+            break;
+        case StandbyMessageType::BG_TASK_STATUS_CHANGE:
+            HandleBgTaskStatusChanged(message);
+            break;
+        case StandbyMessageType::APP_FOREGROUND_STATE_CHANGED:
+            HandleForegroundStateChanged(message);
+            break;
+        case StandbyMessageType::PROCESS_STATE_CHANGED:
+            HandleProcessStatusChanged(message);
+            break;
+        default:
+            break;
+    }
+}
+
+ErrCode FreezeStrategy::OnCreated()
+{
+    if (backend_ == nullptr) {
+        return ERR_STANDBY_OBJECT_NULL;
+    }
+    batchSize_ = StandbyConfigManager::GetInstance()->GetStandbyParam(FREEZE_BATCH_SIZE);
+    if (batchSize_ <= 0) {
+        batchSize_ = DEFAULT_FREEZE_BATCH_SIZE;
+    }
+    return ERR_OK;
+}
+
+ErrCode FreezeStrategy::OnDestroy()
+{
+    StopFreeze();
+    return ERR_OK;
+}
+
+ErrCode FreezeStrategy::StartFreeze(const StandbyMessage& message)
+{
+    if (isFreezing_) {
+        return ERR_STANDBY_STRATEGY_STATE_REPEAT;
+    }
+    if (!message.want_.has_value()) {
+        return ERR_STANDBY_OBJECT_NULL;
+    }
+    uint32_t curPhase = static_cast<uint32_t>(message.want_->GetIntParam(CURRENT_PHASE, 0));
+    uint32_t curState = static_cast<uint32_t>(message.want_->GetIntParam(CURRENT_STATE, 0));
+    if ((curState != StandbyState::SLEEP) || (curPhase != SleepStatePhase::APP_RES_DEEP)) {
+        return ERR_STANDBY_CURRENT_STATE_NOT_MATCH;
+    }
+    if (auto ret = backend_->Init(); ret != ERR_OK) {
+        STANDBYSERVICE_LOGW("freeze backend %{public}s is not available", backend_->GetName().c_str());
+        return ret;
+    }
+    isFreezing_ = true;
+    isIdleMaintence_ = false;
+    StartFreezeCycle();
+    return ERR_OK;
+}
+
+ErrCode FreezeStrategy::HandleStateTransit(const StandbyMessage& message)
+{
+    if (!isFreezing_) {
+        return ERR_STANDBY_CURRENT_STATE_NOT_MATCH;
+    }
+    if (!message.want_.has_value()) {
+        return ERR_STANDBY_OBJECT_NULL;
+    }
+    uint32_t preState = static_cast<uint32_t>(message.want_->GetIntParam(PREVIOUS_STATE, 0));
+    uint32_t curState = static_cast<uint32_t>(message.want_->GetIntParam(CURRENT_STATE, 0));
+    if ((curState == StandbyState::MAINTENANCE) && (preState == StandbyState::SLEEP)) {
+        // enter maintenance, frozen processes get a window to run
+        RemoveFreezeBatchTask();
+        pendingPids_.clear();
+        RecordCycle();
+        ThawAll();
+        isIdleMaintence_ = true;
+    } else if ((curState == StandbyState::SLEEP) && (preState == StandbyState::MAINTENANCE)) {
+        isIdleMaintence_ = false;
+        StartFreezeCycle();
+    } else if (preState == StandbyState::SLEEP || preState == StandbyState::MAINTENANCE) {
+        StopFreeze();
+    }
+    return ERR_OK;
+}
+
+ErrCode FreezeStrategy::UpdateExemptionList(const StandbyMessage& message)
+{
+    if (!message.want_.has_value()) {
+        return ERR_STANDBY_OBJECT_NULL;
+    }
+    uint32_t allowType = static_cast<uint32_t>(message.want_->GetIntParam("allowType", 0));
+    if ((allowType & AllowType::FREEZE) == 0) {
+        return ERR_STANDBY_STRATEGY_NOT_MATCH;
+    }
+    if (!isFreezing_) {
+        return ERR_STANDBY_CURRENT_STATE_NOT_MATCH;
+    }
+    // removed exemption takes effect from the next freeze cycle
+    if (message.want_->GetBoolParam("added", false)) {
+        ThawUid(message.want_->GetIntParam("uid", -1));
+    }
+    return ERR_OK;
+}
+
+void FreezeStrategy::HandleBgTaskStatusChanged(const StandbyMessage& message)
+{
+    if (!isFreezing_ || !message.want_.has_value()) {
+        return;
+    }
+    if (message.want_->GetBoolParam(BG_TASK_STATUS, false)) {
+        ThawUid(message.want_->GetIntParam(BG_TASK_UID, -1));
+    }
+}
+
+void FreezeStrategy::HandleForegroundStateChanged(const StandbyMessage& message)
+{
+    if (!isFreezing_ || !message.want_.has_value()) {
+        return;
+    }
+    if (message.want_->GetBoolParam("isForeground", false)) {
+        ThawUid(message.want_->GetIntParam("uid", -1));
+    }
+}
+
+void FreezeStrategy::HandleProcessStatusChanged(const StandbyMessage& message)
+{
+    if (!isFreezing_ || !message.want_.has_value() || message.want_->GetBoolParam("isCreated", false)) {
+        return;
+    }
+    int32_t pid = message.want_->GetIntParam("pid", -1);
+    if (frozenPids_.erase(pid) > 0) {
+        // the pid may have been reused, the process it refers to now must not be moved
+        backend_->Forget(pid);
+    }
+}
+
+void FreezeStrategy::StartFreezeCycle()
+{
+    if (AppStateCache::GetInstance()->EnsureLoaded() != ERR_OK) {
+        STANDBYSERVICE_LOGW("failed to load app state cache, skip freezing");
+        return;
+    }
+    std::vector<AllowInfo> allowInfoList {};
+    StandbyServiceImpl::GetInstance()->GetAllowListInner(AllowType::FREEZE, allowInfoList,
+        ReasonCodeEnum::REASON_APP_API);
+    // names of running apps are not interned by anyone else, so both sides are interned here
+    NameIdSet allowNameIds {};
+    for (const auto& info : allowInfoList) {
+        allowNameIds.emplace(NameInterner::GetInstance().Intern(info.GetName()));
+    }
+    std::set<std::string> restrictNameList {};
+    StandbyServiceImpl::GetInstance()->GetEligiableRestrictSet(AllowType::FREEZE, "FREEZE",
+        ReasonCodeEnum::REASON_APP_API, restrictNameList);
+    NameIdSet restrictNameIds {};
+    for (const auto& name : restrictNameList) {
+        restrictNameIds.emplace(NameInterner::GetInstance().Intern(name));
+    }
+
+    RecordCycle();
+    pendingPids_.clear();
+    AppStateCache::GetInstance()->ForEachRunningApp([this, &allowNameIds, &restrictNameIds](
+        const AppStateInfo& appState) {
+        NameId nameId = NameInterner::GetInstance().Intern(appState.bundleName_);
+        bool hasBgTask = !appState.continuousTaskTypeIds_.empty() || appState.hasTransientTask_ ||
+            appState.runningWorkCount_ > 0;
+        // system app is frozen only if it is restricted explicitly
+        if (appState.bundleName_.empty() || appState.isForeground_ || hasBgTask ||
+            allowNameIds.count(nameId) != 0 ||
+            (appState.isSystemApp_ && restrictNameIds.count(nameId) == 0)) {
+            return;
+        }
+        for (const auto pid : appState.pids_) {
+            if (frozenPids_.find(pid) == frozenPids_.end()) {
+                pendingPids_.emplace_back(pid, appState.uid_);
+            }
+        }
+    });
+    ++cycleCount_;
+    STANDBYSERVICE_LOGI("start freeze cycle, pending process size is %{public}d",
+        static_cast<int32_t>(pendingPids_.size()));
+    FreezeNextBatch();
+}
+
+void FreezeStrategy::FreezeNextBatch()
+{
+    if (pendingPids_.empty()) {
+        return;
+    }
+    size_t batchSize = std::min(pendingPids_.size(), static_cast<size_t>(batchSize_));
+    std::vector<int32_t> pids {};
+    std::unordered_map<int32_t, int32_t> pidUidMap {};
+    pids.reserve(batchSize);
+    for (size_t index = 0; index < batchSize; ++index) {
+        const auto [pid, uid] = pendingPids_.front();
+        pendingPids_.pop_front();
+        pids.emplace_back(pid);
+        pidUidMap.emplace(pid, uid);
+    }
+    std::vector<int32_t> frozenPids {};
+    int64_t startTime = GetSteadyTimeUs();
+    backend_->Freeze(pids, frozenPids);
+    int64_t latency = GetSteadyTimeUs() - startTime;
+    for (const auto pid : frozenPids) {
+        frozenPids_.emplace(pid, pidUidMap[pid]);
+    }
+    ++freezeBatchCount_;
+    frozenCount_ += frozenPids.size();
+    curCycleFrozenCount_ += static_cast<uint32_t>(frozenPids.size());
+    totalFreezeLatency_ += latency;
+    maxFreezeLatency_ = std::max(maxFreezeLatency_, latency);
+    STANDBYSERVICE_LOGD("freeze batch, frozen: %{public}d of %{public}d, remaining: %{public}d",
+        static_cast<int32_t>(frozenPids.size()), static_cast<int32_t>(pids.size()),
+        static_cast<int32_t>(pendingPids_.size()));
+    if (!pendingPids_.empty()) {
+        PostFreezeBatchTask();
+    }
+}
+
+void FreezeStrategy::ThawAll()
+{
+    std::vector<int32_t> pids {};
+    pids.reserve(frozenPids_.size());
+    for (const auto& [pid, uid] : frozenPids_) {
+        pids.emplace_back(pid);
+    }
+    frozenPids_.clear();
+    ThawPids(pids);
+}
+
+void FreezeStrategy::ThawUid(int32_t uid)
+{
+    pendingPids_.erase(std::remove_if(pendingPids_.begin(), pendingPids_.end(),
+        [uid](const auto& pidPair) { return pidPair.second == uid; }), pendingPids_.end());
+    std::vector<int32_t> pids {};
+    for (auto iter = frozenPids_.begin(); iter != frozenPids_.end();) {
+        if (iter->second == uid) {
+            pids.emplace_back(iter->first);
+            iter = frozenPids_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    ThawPids(pids);
+}
+
+void FreezeStrategy::ThawPids(const std::vector<int32_t>& pids)
+{
+    if (pids.empty()) {
+        return;
+    }
+    int64_t startTime = GetSteadyTimeUs();
+    backend_->Thaw(pids);
+    int64_t latency = GetSteadyTimeUs() - startTime;
+    ++thawBatchCount_;
+    thawedCount_ += pids.size();
+    totalThawLatency_ += latency;
+    maxThawLatency_ = std::max(maxThawLatency_, latency);
+    STANDBYSERVICE_LOGD("thaw %{public}d processes", static_cast<int32_t>(pids.size()));
+}
+
+void FreezeStrategy::StopFreeze()
+{
+    RemoveFreezeBatchTask();
+    pendingPids_.clear();
+    RecordCycle();
+    ThawAll();
+    isFreezing_ = false;
+    isIdleMaintence_ = false;
+}
+
+void FreezeStrategy::PostFreezeBatchTask()
+{
+    auto handler = StandbyServiceImpl::GetInstance()->GetHandler();
+    if (handler == nullptr) {
+        return;
+    }
+    handler->RemoveTask(FREEZE_BATCH_TASK);
+    handler->PostTask([this]() {
+        if (isFreezing_ && !isIdleMaintence_) {
+            FreezeNextBatch();
+        }
+        }, FREEZE_BATCH_TASK, FREEZE_BATCH_INTERVAL);
+}
+
+void FreezeStrategy::RemoveFreezeBatchTask()
+{
+    if (auto handler = StandbyServiceImpl::GetInstance()->GetHandler(); handler != nullptr) {
+        handler->RemoveTask(FREEZE_BATCH_TASK);
+    }
+}
+
+void FreezeStrategy::RecordCycle()
+{
+    if (curCycleFrozenCount_ == 0) {
+        return;
+    }
+    recentCycleFrozenCounts_.emplace_back(curCycleFrozenCount_);
+    if (recentCycleFrozenCounts_.size() > MAX_RECENT_CYCLE_NUM) {
+        recentCycleFrozenCounts_.pop_front();
+    }
+    curCycleFrozenCount_ = 0;
+}
+
+void FreezeStrategy::ShellDump(const std::vector<std::string>& argsInStr, std::string& result)
+{
+    if (argsInStr[DUMP_FIRST_PARAM] == DUMP_DETAIL_INFO &&
+        argsInStr[DUMP_SECOND_PARAM] == DUMP_STRATGY_DETAIL) {
+        DumpShowDetailInfo(argsInStr, result);
+    }
+}
+
+void FreezeStrategy::DumpShowDetailInfo(const std::vector<std::string>& argsInStr, std::string& result)
+{
+    result.append("=================Freeze===========================\n");
+    result.append("Freeze Strategy:\n").append("backend: " + (backend_ == nullptr ? "" : backend_->GetName()))
+        .append(" isFreezing: " + std::to_string(isFreezing_))
+        .append(" isIdleMaintence: " + std::to_string(isIdleMaintence_))
+        .append(" batch size: " + std::to_string(batchSize_)).append("\n");
+    result.append("cycle count: ").append(std::to_string(cycleCount_))
+        .append(" frozen now: ").append(std::to_string(frozenPids_.size()))
+        .append(" pending: ").append(std::to_string(pendingPids_.size())).append("\n");
+    result.append("freeze batches: ").append(std::to_string(freezeBatchCount_))
+        .append(" frozen count: ").append(std::to_string(frozenCount_))
+        .append(" avg latency(us): ").append(std::to_string(freezeBatchCount_ == 0 ? 0 :
+            totalFreezeLatency_ / static_cast<int64_t>(freezeBatchCount_)))
+        .append(" max latency(us): ").append(std::to_string(maxFreezeLatency_)).append("\n");
+    result.append("thaw batches: ").append(std::to_string(thawBatchCount_))
+        .append(" thawed count: ").append(std::to_string(thawedCount_))
+        .append(" avg latency(us): ").append(std::to_string(thawBatchCount_ == 0 ? 0 :
+            totalThawLatency_ / static_cast<int64_t>(thawBatchCount_)))
+        .append(" max latency(us): ").append(std::to_string(maxThawLatency_)).append("\n");
+    result.append("recent frozen counts per cycle:");
+    for (const auto frozenCount : recentCycleFrozenCounts_) {
+        result.append(" ").append(std::to_string(frozenCount));
+    }
+    result.append("\n");
+}
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
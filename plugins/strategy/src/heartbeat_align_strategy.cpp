@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "heartbeat_align_strategy.h"
+
+#include <algorithm>
+#include <ctime>
+
+#include "common_constant.h"
+#include "standby_config_manager.h"
+#include "standby_service_impl.h"
+#include "standby_service_log.h"
+#include "standby_state.h"
+#include "time_provider.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+namespace {
+const std::string HEARTBEAT_ALIGN_FLEX = "heartbeat_align_flex";
+// a beat may be brought forward by at most this percent of its interval
+constexpr int32_t DEFAULT_HEARTBEAT_ALIGN_FLEX = 25;
+const std::string HEARTBEAT_ALIGN_TASK = "HeartbeatAlignTask";
+const std::string NAT_TAG_PREFIX = "nat_";
+
+// heartbeats keep counting while the device is suspended
+int64_t GetBootTimeMs()
+{
+    struct timespec time {};
+    clock_gettime(CLOCK_BOOTTIME, &time);
+    return static_cast<int64_t>(time.tv_sec) * TimeConstant::MSEC_PER_SEC +
+        time.tv_nsec / TimeConstant::NSEC_PER_MSEC;
+}
+}
+
+void HeartbeatAlignStrategy::HandleEvent(const StandbyMessage& message)
+{
+    STANDBYSERVICE_LOGD("HeartbeatAlignStrategy revceived message %{public}u, action: %{public}s",
+        message.eventId_, message.action_.c_str());
+    if (scheduler_ == nullptr) {
+        return;
+    }
+    switch (message.eventId_) {
+        case StandbyMessageType::NAT_DETECT_INTERVAL_CHANGED:
+            HandleNatIntervalChanged(message);
+            break;
+        case StandbyMessageType::HEART_BEAT_VALUE_CHANGE:
+            HandleHeartBeatValueChanged(message);
+            break;
+        case StandbyMessageType::NAT_MSG_RECV:
+            scheduler_->OnTraffic(GetBootTimeMs());
+            break;
+        case StandbyMessageType::STATE_TRANSIT:
+            HandleStateTransit(message);
+            break;
+        default:
+            break;
+    }
+    AdvanceSchedule();
+}
+
+ErrCode HeartbeatAlignStrategy::OnCreated()
+{
+    int32_t flexPercent = StandbyConfigManager::GetInstance()->GetStandbyParam(HEARTBEAT_ALIGN_FLEX);
+    if (flexPercent <= 0) {
+        flexPercent = DEFAULT_HEARTBEAT_ALIGN_FLEX;
+    }
+    scheduler_ = std::make_unique<HeartbeatScheduler>(flexPercent);
+    return ERR_OK;
+}
+
+ErrCode HeartbeatAlignStrategy::OnDestroy()
+{
+    RemoveAlignTask();
+    return ERR_OK;
+}
+
+ErrCode HeartbeatAlignStrategy::HandleNatIntervalChanged(const StandbyMessage& message)
+{
+    if (!message.want_.has_value()) {
+        return ERR_STANDBY_OBJECT_NULL;
+    }
+    std::string tag = NAT_TAG_PREFIX + std::to_string(message.want_->GetIntParam(MESSAGE_TYPE, 0));
+    bool enable = message.want_->GetBoolParam(MESSAGE_ENABLE, false);
+    int64_t interval = static_cast<int64_t>(message.want_->GetIntParam(MESSAGE_INTERVAL, 0)) *
+        TimeConstant::MSEC_PER_SEC;
+    // disabled detection is removed by a zero interval
+    scheduler_->SetInterval(tag, enable ? interval : 0, GetBootTimeMs());
+    return ERR_OK;
+}
+
+ErrCode HeartbeatAlignStrategy::HandleHeartBeatValueChanged(const StandbyMessage& message)
+{
+    if (!message.want_.has_value()) {
+        return ERR_STANDBY_OBJECT_NULL;
+    }
+    std::string tag = message.want_->GetStringParam("tag");
+    if (tag.empty()) {
+        return ERR_STANDBY_INVALID_PARAM;
+    }
+    // timesTamp is when the push message was received, not an interval, so the report is handled
+    // as traffic on the kept-alive connection
+    STANDBYSERVICE_LOGD("heartbeat value of %{public}s changed", tag.c_str());
+    scheduler_->OnTraffic(GetBootTimeMs());
+    return ERR_OK;
+}
+
+ErrCode HeartbeatAlignStrategy::HandleStateTransit(const StandbyMessage& message)
+{
+    if (!message.want_.has_value()) {
+        return ERR_STANDBY_OBJECT_NULL;
+    }
+    uint32_t preState = static_cast<uint32_t>(message.want_->GetIntParam(PREVIOUS_STATE, 0));
+    uint32_t curState = static_cast<uint32_t>(message.want_->GetIntParam(CURRENT_STATE, 0));
+    if (curState != StandbyState::MAINTENANCE) {
+        return ERR_STANDBY_CURRENT_STATE_NOT_MATCH;
+    }
+    int64_t duration = StandbyConfigManager::GetInstance()->GetStandbyParam(
+        preState == StandbyState::NAP ? NAP_MAINTENANCE_TIMEOUT : SLEEP_MAINT_TIMEOUT);
+    maintenanceDuration_ = duration * TimeConstant::MSEC_PER_SEC;
+    int64_t now = GetBootTimeMs();
+    scheduler_->AddMaintenanceWindow(now, now + maintenanceDuration_);
+    return ERR_OK;
+}
+
+void HeartbeatAlignStrategy::AdvanceSchedule()
+{
+    scheduler_->Advance(GetBootTimeMs());
+    PostAlignTask();
+}
+
+void HeartbeatAlignStrategy::PostAlignTask()
+{
+    auto handler = StandbyServiceImpl::GetInstance()->GetHandler();
+    if (handler == nullptr) {
+        return;
+    }
+    handler->RemoveTask(HEARTBEAT_ALIGN_TASK);
+    int64_t nextWakeup = scheduler_->GetNextWakeup();
+    if (nextWakeup < 0) {
+        return;
+    }
+    // the handler task only keeps the schedule up to date, the beats themselves are sent by the owner of tags
+    int64_t delay = std::max<int64_t>(nextWakeup - GetBootTimeMs(), 0);
+    handler->PostTask([this]() {
+        if (scheduler_ != nullptr) {
+            AdvanceSchedule();
+        }
+        }, HEARTBEAT_ALIGN_TASK, delay);
+}
+
+void HeartbeatAlignStrategy::RemoveAlignTask()
+{
+    if (auto handler = StandbyServiceImpl::GetInstance()->GetHandler(); handler != nullptr) {
+        handler->RemoveTask(HEARTBEAT_ALIGN_TASK);
+    }
+}
+
+void HeartbeatAlignStrategy::ShellDump(const std::vector<std::string>& argsInStr, std::string& result)
+{
+    if (argsInStr[DUMP_FIRST_PARAM] == DUMP_DETAIL_INFO &&
+        argsInStr[DUMP_SECOND_PARAM] == DUMP_STRATGY_DETAIL) {
+        DumpShowDetailInfo(argsInStr, result);
+    }
+}
+
+void HeartbeatAlignStrategy::DumpShowDetailInfo(const std::vector<std::string>& argsInStr, std::string& result)
+{
+    result.append("=================HeartbeatAlign===================\n");
+    if (scheduler_ == nullptr) {
+        return;
+    }
+    int64_t now = GetBootTimeMs();
+    result.append("HeartbeatAlign Strategy:\n").append("now(ms): " + std::to_string(now))
+        .append(" next wakeup(ms): " + std::to_string(scheduler_->GetNextWakeup()))
+        .append(" maintenance duration(ms): " + std::to_string(maintenanceDuration_)).append("\n");
+    result.append("beats: ").append(std::to_string(scheduler_->GetBeatCount()))
+        .append(" wakeups: ").append(std::to_string(scheduler_->GetWakeupCount()))
+        .append(" projected wakeups saved: ").append(std::to_string(scheduler_->GetWakeupSavedCount())).append("\n");
+    result.append("aligned schedule:\n");
+    for (const auto& tag : scheduler_->GetTags()) {
+        result.append("  tag: ").append(tag.tag_)
+            .append(" interval(ms): ").append(std::to_string(tag.interval_))
+            .append(" last beat(ms): ").append(std::to_string(tag.lastBeat_))
+            .append(" deadline(ms): ").append(std::to_string(tag.lastBeat_ + tag.interval_))
+            .append(" aligned beat(ms): ").append(std::to_string(tag.alignedBeat_))
+            .append(" in maintenance: ").append(std::to_string(tag.inMaintenance_))
+            .append(" beats: ").append(std::to_string(tag.beatCount_)).append("\n");
+    }
+    result.append("maintenance windows(ms):");
+    for (const auto& [start, end] : scheduler_->GetMaintenanceWindows()) {
+        result.append(" [").append(std::to_string(start)).append(", ").append(std::to_string(end)).append(")");
+    }
+    result.append("\n");
+}
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "heartbeat_scheduler.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace DevStandbyMgr {
+namespace {
+constexpr int32_t MAX_FLEX_PERCENT = 100;
+constexpr int32_t PERCENT_BASE = 100;
+// beats handled in one Advance, the rest is dropped when the caller has not advanced for a long time
+constexpr int32_t MAX_BEATS_PER_ADVANCE = 1024;
+}
+
+HeartbeatScheduler::HeartbeatScheduler(int32_t flexPercent)
+    : flexPercent_(std::clamp(flexPercent, 0, MAX_FLEX_PERCENT)) {}
+
+void HeartbeatScheduler::SetInterval(const std::string& tag, int64_t interval, int64_t now)
+{
+    if (interval <= 0) {
+        RemoveTag(tag);
+        return;
+    }
+    auto iter = std::find_if(tags_.begin(), tags_.end(),
+        [&tag](const HeartbeatTag& item) { return item.tag_ == tag; });
+    if (iter == tags_.end()) {
+        tags_.emplace_back(HeartbeatTag {tag, interval, now, now + interval, false, 0});
+    } else {
+        iter->interval_ = interval;
+    }
+    Align();
+}
+
+void HeartbeatScheduler::RemoveTag(const std::string& tag)
+{
+    tags_.erase(std::remove_if(tags_.begin(), tags_.end(),
+        [&tag](const HeartbeatTag& item) { return item.tag_ == tag; }), tags_.end());
+    Align();
+}
+
+void HeartbeatScheduler::OnTraffic(int64_t now)
+{
+    for (auto& tag : tags_) {
+        tag.lastBeat_ = std::max(tag.lastBeat_, now);
+    }
+    Align();
+}
+
+void HeartbeatScheduler::AddMaintenanceWindow(int64_t start, int64_t end)
+{
+    if (end <= start) {
+        return;
+    }
+    maintenanceWindows_.emplace_back(start, end);
+    std::sort(maintenanceWindows_.begin(), maintenanceWindows_.end());
+    Align();
+}
+
+void HeartbeatScheduler::Advance(int64_t now)
+{
+    for (int32_t index = 0; index < MAX_BEATS_PER_ADVANCE; ++index) {
+        int64_t nextWakeup = GetNextWakeup();
+        if (nextWakeup < 0 || nextWakeup > now) {
+            break;
+        }
+        bool inMaintenance = false;
+        for (auto& tag : tags_) {
+            if (tag.alignedBeat_ != nextWakeup) {
+                continue;
+            }
+            inMaintenance = tag.inMaintenance_;
+            tag.lastBeat_ = nextWakeup;
+            ++tag.beatCount_;
+            ++beatCount_;
+        }
+        // beats of one group share the wakeup, beats in maintenance need none of their own
+        if (!inMaintenance) {
+            ++wakeupCount_;
+        }
+        Align();
+    }
+    for (auto& tag : tags_) {
+        if (tag.alignedBeat_ < now) {
+            tag.lastBeat_ = now;
+        }
+    }
+    maintenanceWindows_.erase(std::remove_if(maintenanceWindows_.begin(), maintenanceWindows_.end(),
+        [now](const auto& window) { return window.second <= now; }), maintenanceWindows_.end());
+    Align();
+}
+
+void HeartbeatScheduler::Align()
+{
+    std::vector<HeartbeatTag*> pendingTags {};
+    pendingTags.reserve(tags_.size());
+    for (auto& tag : tags_) {
+        pendingTags.emplace_back(&tag);
+    }
+    auto deadline = [](const HeartbeatTag* tag) { return tag->lastBeat_ + tag->interval_; };
+    auto earliest = [this, &deadline](const HeartbeatTag* tag) {
+        return deadline(tag) - tag->interval_ * flexPercent_ / PERCENT_BASE;
+    };
+    std::sort(pendingTags.begin(), pendingTags.end(),
+        [&deadline](const HeartbeatTag* lhs, const HeartbeatTag* rhs) { return deadline(lhs) < deadline(rhs); });
+
+    // greedy grouping: the most urgent tag decides the group time, every tag allowed to beat by then joins
+    auto groupBegin = pendingTags.begin();
+    while (groupBegin != pendingTags.end()) {
+        int64_t groupTime = deadline(*groupBegin);
+        auto groupEnd = std::stable_partition(groupBegin, pendingTags.end(),
+            [&earliest, groupTime](const HeartbeatTag* tag) { return earliest(tag) <= groupTime; });
+        // the group may beat anywhere in [lowBound, groupTime] without any member beating too early
+        int64_t lowBound = earliest(*groupBegin);
+        for (auto iter = groupBegin; iter != groupEnd; ++iter) {
+            lowBound = std::max(lowBound, earliest(*iter));
+        }
+        bool inMaintenance = false;
+        for (const auto& [start, end] : maintenanceWindows_) {
+            if (start <= groupTime && end > lowBound) {
+                groupTime = std::max(start, lowBound);
+                inMaintenance = true;
+                break;
+            }
+        }
+        for (auto iter = groupBegin; iter != groupEnd; ++iter) {
+            (*iter)->alignedBeat_ = groupTime;
+            (*iter)->inMaintenance_ = inMaintenance;
+        }
+        groupBegin = groupEnd;
+    }
+}
+
+const std::vector<HeartbeatTag>& HeartbeatScheduler::GetTags() const
+{
+    return tags_;
+}
+
+const std::vector<std::pair<int64_t, int64_t>>& HeartbeatScheduler::GetMaintenanceWindows() const
+{
+    return maintenanceWindows_;
+}
+
+int64_t HeartbeatScheduler::GetNextWakeup() const
+{
+    int64_t nextWakeup = -1;
+    for (const auto& tag : tags_) {
+        if (nextWakeup < 0 || tag.alignedBeat_ < nextWakeup) {
+            nextWakeup = tag.alignedBeat_;
+        }
+    }
+    return nextWakeup;
+}
+
+uint64_t HeartbeatScheduler::GetBeatCount() const
+{
+    return beatCount_;
+}
+
+uint64_t HeartbeatScheduler::GetWakeupCount() const
+{
+    return wakeupCount_;
+}
+
+uint64_t HeartbeatScheduler::GetWakeupSavedCount() const
+{
+    return beatCount_ - wakeupCount_;
+}
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
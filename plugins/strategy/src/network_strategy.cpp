@@ -31,6 +31,7 @@ ErrCode NetworkStrategy::OnCreated()
 {
     STANDBYSERVICE_LOGI("NetworkStrategy is now OnCreated");
     condition_ = TimeProvider::GetCondition();
+    ClearPendingFirewallList();
     ResetFirewallAllowList();
     return ERR_OK;
 }
@@ -38,6 +39,7 @@ ErrCode NetworkStrategy::OnCreated()
 ErrCode NetworkStrategy::OnDestroy()
 {
     STANDBYSERVICE_LOGI("NetworkStrategy is now OnDestroy");
+    ClearPendingFirewallList();
     ResetFirewallAllowList();
     return ERR_OK;
 }
@@ -82,7 +84,7 @@ void NetworkStrategy::UpdateNetResourceConfig(const StandbyMessage& message)
     }
     condition_ = static_cast<uint32_t>(message.want_->GetIntParam(RES_CTRL_CONDITION, 0));
     STANDBYSERVICE_LOGD("enter NetworkStrategy HandleEvent, current condition is %{public}u", condition_);
-    UpdateFirewallAllowList();
+    UpdateConditionalAllowList();
 }
 
 void NetworkStrategy::StartNetLimit(const StandbyMessage& message)
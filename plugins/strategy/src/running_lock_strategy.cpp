@@ -15,6 +15,7 @@
 
 #include "running_lock_strategy.h"
 #include <algorithm>
+#include <iterator>
 #include "standby_hitrace_chain.h"
 #include "standby_service_log.h"
 #include "system_ability_definition.h"
@@ -36,6 +37,8 @@
 #include "bundle_manager_helper.h"
 #include "standby_service_impl.h"
 #include "common_constant.h"
+#include "app_state_cache.h"
+#include "standby_config_manager.h"
 
 namespace OHOS {
 namespace DevStandbyMgr {
@@ -45,6 +48,18 @@ const std::map<std::string, uint8_t> BGTASK_EXEMPTION_FLAG_MAP {
     {TRANSIENT_TASK, ExemptionTypeFlag::TRANSIENT_TASK},
     {WORK_SCHEDULER, ExemptionTypeFlag::WORK_SCHEDULER},
 };
+
+const ExemptionFlagFilter& GetProxiedFlagFilter()
+{
+    static const ExemptionFlagFilter proxiedFlagFilter = []() {
+        ExemptionFlagFilter filter {};
+        for (size_t flag = 0; flag < filter.size(); ++flag) {
+            filter[flag] = !ExemptionTypeFlag::IsExempted(static_cast<uint8_t>(flag));
+        }
+        return filter;
+    }();
+    return proxiedFlagFilter;
+}
 }
 
 void RunningLockStrategy::HandleEvent(const StandbyMessage& message)
@@ -83,6 +98,8 @@ ErrCode RunningLockStrategy::OnCreated()
     #ifdef STANDBY_POWER_MANAGER_ENABLE
     PowerMgr::PowerMgrClient::GetInstance().ResetRunningLocks();
     #endif
+    // power manager may be restarted, all proxy records have been reset
+    proxiedPidSet_.clear();
     return ERR_OK;
 }
 
@@ -91,6 +108,7 @@ ErrCode RunningLockStrategy::OnDestroy()
     if (isProxied_ && !isIdleMaintence_) {
         ProxyAppAndProcess(false);
     }
+    proxiedPidSet_.clear();
     isProxied_ = false;
     isIdleMaintence_ = false;
     return ERR_OK;
@@ -127,11 +145,55 @@ ErrCode RunningLockStrategy::UpdateExemptionList(const StandbyMessage& message)
 
 ErrCode RunningLockStrategy::UpdateResourceConfig()
 {
-    StopProxyInner();
-    StartProxyInner();
+    if (!isProxied_) {
+        return ERR_STANDBY_CURRENT_STATE_NOT_MATCH;
+    }
+    // only apps whose exemption differs between day and night need to be recalculated
+    auto sensitiveNames = StandbyConfigManager::GetInstance()->GetConditionSensitiveNames("RUNNING_LOCK");
+    if (sensitiveNames == nullptr || sensitiveNames->empty()) {
+        return ERR_OK;
+    }
+    ReevaluateExemptionConfig(*sensitiveNames);
+    SyncProxiedPidList();
     return ERR_OK;
 }
 
+void RunningLockStrategy::ReevaluateExemptionConfig(const NameIdSet& nameIds)
+{
+    std::vector<AllowInfo> allowInfoList {};
+    StandbyServiceImpl::GetInstance()->GetAllowListInner(AllowType::RUNNING_LOCK, allowInfoList,
+        ReasonCodeEnum::REASON_APP_API);
+    NameIdSet allowNameIds {};
+    for (const auto& info : allowInfoList) {
+        if (NameId nameId = NameInterner::GetInstance().Find(info.GetName()); nameId != INVALID_NAME_ID) {
+            allowNameIds.emplace(nameId);
+        }
+    }
+    std::set<std::string> restrictBundleName {};
+    StandbyServiceImpl::GetInstance()->GetEligiableRestrictSet(AllowType::RUNNING_LOCK, "RUNNING_LOCK",
+        ReasonCodeEnum::REASON_APP_API, restrictBundleName);
+    NameIdSet restrictNameIds {};
+    NameInterner::GetInstance().FindAll(restrictBundleName, restrictNameIds);
+    uint32_t reevaluatedCount = 0;
+    for (size_t row = 0; row < proxiedAppInfo_.Size(); ++row) {
+        NameId nameId = proxiedAppInfo_.GetNameId(row);
+        if (nameIds.count(nameId) == 0) {
+            continue;
+        }
+        proxiedAppInfo_.RemoveFlag(row, ExemptionTypeFlag::EXEMPTION | ExemptionTypeFlag::RESTRICTED);
+        if (allowNameIds.count(nameId) != 0) {
+            proxiedAppInfo_.AddFlag(row, ExemptionTypeFlag::EXEMPTION);
+        }
+        if (restrictNameIds.count(nameId) != 0) {
+            proxiedAppInfo_.AddFlag(row, ExemptionTypeFlag::RESTRICTED);
+        }
+        ++reevaluatedCount;
+    }
+    conditionReevaluatedCount_ += reevaluatedCount;
+    STANDBYSERVICE_LOGI("condition changed, reevaluate %{public}u of %{public}d apps", reevaluatedCount,
+        static_cast<int32_t>(proxiedAppInfo_.Size()));
+}
+
 ErrCode RunningLockStrategy::StartProxy(const StandbyMessage& message)
 {
     StandbyHitraceChain traceChain(__func__);
@@ -172,6 +234,11 @@ ErrCode RunningLockStrategy::StartProxyInner()
 
 ErrCode RunningLockStrategy::InitProxiedAppInfo()
 {
+    // app states are kept current by events, no system ability is queried unless cache is invalidated
+    if (AppStateCache::GetInstance()->EnsureLoaded() != ERR_OK) {
+        STANDBYSERVICE_LOGW("failed to load app state cache");
+        return ERR_STRATEGY_DEPENDS_SA_NOT_AVAILABLE;
+    }
     if (GetAllAppInfos() != ERR_OK || GetAllRunningAppInfo() != ERR_OK) {
         STANDBYSERVICE_LOGW("failed to get all app info");
         return ERR_STRATEGY_DEPENDS_SA_NOT_AVAILABLE;
@@ -186,156 +253,107 @@ ErrCode RunningLockStrategy::InitProxiedAppInfo()
 
 ErrCode RunningLockStrategy::GetAllAppInfos()
 {
-    // get all app and set UNRESTRICTED flag to system app.
-    std::vector<AppExecFwk::ApplicationInfo> applicationInfos {};
-    if (!BundleManagerHelper::GetInstance()->GetApplicationInfos(
-        AppExecFwk::ApplicationFlag::GET_BASIC_APPLICATION_INFO,
-        AppExecFwk::Constants::ALL_USERID, applicationInfos)) {
-        STANDBYSERVICE_LOGW("failed to get all applicationInfos");
-        return ERR_STRATEGY_DEPENDS_SA_NOT_AVAILABLE;
-    }
-    STANDBYSERVICE_LOGI("succeed GetApplicationInfos, size is %{public}d",
-        static_cast<int32_t>(applicationInfos.size()));
-    for (const auto& info : applicationInfos) {
-        uidBundleNmeMap_.emplace(info.uid, info.name);
-        std::string key = std::to_string(info.uid) + "_" + info.name;
-        proxiedAppInfo_.emplace(key, ProxiedProcInfo {info.name, info.uid});
+    // get all running app and set UNRESTRICTED flag to system app.
+    AppStateCache::GetInstance()->ForEachRunningApp([this](const AppStateInfo& appState) {
+        if (appState.bundleName_.empty()) {
+            return;
+        }
+        size_t row = proxiedAppInfo_.Emplace(appState.uid_, appState.bundleName_).first;
+        uidBundleNmeMap_.emplace(appState.uid_, proxiedAppInfo_.GetNameId(row));
         // system app have exemption
-        if (info.isSystemApp) {
-            proxiedAppInfo_[key].appExemptionFlag_ |= ExemptionTypeFlag::UNRESTRICTED;
+        if (appState.isSystemApp_) {
+            proxiedAppInfo_.AddFlag(row, ExemptionTypeFlag::UNRESTRICTED);
         }
-    }
+    });
+    STANDBYSERVICE_LOGI("succeed get running app infos, size is %{public}d",
+        static_cast<int32_t>(uidBundleNmeMap_.size()));
     return ERR_OK;
 }
 
 ErrCode RunningLockStrategy::GetAllRunningAppInfo()
 {
-    std::vector<AppExecFwk::RunningProcessInfo> allAppProcessInfos {};
-    if (!AppMgrHelper::GetInstance()->GetAllRunningProcesses(allAppProcessInfos)) {
-        STANDBYSERVICE_LOGE("connect to app manager service failed");
-        return ERR_STRATEGY_DEPENDS_SA_NOT_AVAILABLE;
-    }
     // get all running proc of app, add them to proxiedAppInfo_.
-    STANDBYSERVICE_LOGI("current running processes size %{public}d", static_cast<int32_t>(allAppProcessInfos.size()));
-    std::set<int> runningUids {};
-    for (const auto& info : allAppProcessInfos) {
-        if (uidBundleNmeMap_.find(info.uid_) == uidBundleNmeMap_.end()) {
-            continue;
-        }
-        runningUids.emplace(info.uid_);
-        std::string key = std::to_string(info.uid_) + "_" + uidBundleNmeMap_[info.uid_];
-        auto iter = proxiedAppInfo_.find(key);
-        if (iter == proxiedAppInfo_.end()) {
-            std::tie(iter, std::ignore) = proxiedAppInfo_.emplace(key,
-                ProxiedProcInfo {info.processName_, info.uid_});
+    AppStateCache::GetInstance()->ForEachRunningApp([this](const AppStateInfo& appState) {
+        auto bundleIter = uidBundleNmeMap_.find(appState.uid_);
+        if (bundleIter == uidBundleNmeMap_.end()) {
+            return;
         }
-        iter->second.pids_.emplace(info.pid_);
-    }
-    // if app is not running, delete its info from proxiedAppInfo_.
-    for (auto appInfoIter = proxiedAppInfo_.begin(); appInfoIter != proxiedAppInfo_.end();) {
-        if (runningUids.find(appInfoIter->second.uid_) == runningUids.end()) {
-            appInfoIter = proxiedAppInfo_.erase(appInfoIter);
-        } else {
-            ++appInfoIter;
+        if (size_t row = proxiedAppInfo_.Find(appState.uid_, bundleIter->second); row != ExemptionTable::NPOS) {
+            for (const auto pid : appState.pids_) {
+                proxiedAppInfo_.AddPid(row, pid);
+            }
         }
-    }
+    });
     return ERR_OK;
 }
 
 ErrCode RunningLockStrategy::GetWorkSchedulerTask()
 {
     #ifdef STANDBY_RSS_WORK_SCHEDULER_ENABLE
-    std::list<std::shared_ptr<WorkScheduler::WorkInfo>> workInfos;
-    if (WorkScheduler::WorkSchedulerSrvClient::GetInstance().GetAllRunningWorks(workInfos) != ERR_OK) {
-        return ERR_STRATEGY_DEPENDS_SA_NOT_AVAILABLE;
-    }
-
-    STANDBYSERVICE_LOGD("GetWorkSchedulerTask succeed, size is %{public}d", static_cast<int32_t>(workInfos.size()));
-    for (const auto& task : workInfos) {
-        std::string key = std::to_string(task->GetUid()) + "_" + task->GetBundleName();
-        if (auto iter = proxiedAppInfo_.find(key); iter != proxiedAppInfo_.end()) {
-            iter->second.appExemptionFlag_ |= ExemptionTypeFlag::WORK_SCHEDULER;
+    AppStateCache::GetInstance()->ForEachRunningApp([this](const AppStateInfo& appState) {
+        if (appState.runningWorkCount_ > 0) {
+            AddExemptionFlagByUid(appState.uid_, ExemptionTypeFlag::WORK_SCHEDULER);
         }
-    }
+    });
     #endif
     return ERR_OK;
 }
 
 ErrCode RunningLockStrategy::GetForegroundApplications()
 {
-    std::vector<AppExecFwk::AppStateData> fgApps {};
-    if (!AppMgrHelper::GetInstance()->GetForegroundApplications(fgApps)) {
-        STANDBYSERVICE_LOGW("get foreground app failed");
-        return ERR_STRATEGY_DEPENDS_SA_NOT_AVAILABLE;
-    }
     // add foreground flag to app
-    for (const auto& appInfo : fgApps) {
-        std::string key = std::to_string(appInfo.uid) + "_" + appInfo.bundleName;
-        if (auto iter = proxiedAppInfo_.find(key); iter != proxiedAppInfo_.end()) {
-            iter->second.appExemptionFlag_ |= ExemptionTypeFlag::FOREGROUND_APP;
+    AppStateCache::GetInstance()->ForEachRunningApp([this](const AppStateInfo& appState) {
+        if (appState.isForeground_) {
+            AddExemptionFlagByUid(appState.uid_, ExemptionTypeFlag::FOREGROUND_APP);
         }
-    }
+    });
     return ERR_OK;
 }
 
 ErrCode RunningLockStrategy::GetBackgroundTaskApp()
 {
     #ifdef ENABLE_BACKGROUND_TASK_MGR
-    std::vector<std::shared_ptr<ContinuousTaskCallbackInfo>> continuousTaskList;
-    if (!BackgroundTaskHelper::GetInstance()->GetContinuousTaskApps(continuousTaskList)) {
-        STANDBYSERVICE_LOGE("get continuous task app failed");
-        return ERR_STRATEGY_DEPENDS_SA_NOT_AVAILABLE;
-    }
-    STANDBYSERVICE_LOGD("succeed GetContinuousTaskApps, size is %{public}d",
-        static_cast<int32_t>(continuousTaskList.size()));
-    std::vector<std::shared_ptr<TransientTaskAppInfo>> transientTaskList;
-    if (!BackgroundTaskHelper::GetInstance()->GetTransientTaskApps(transientTaskList)) {
-        STANDBYSERVICE_LOGE("get transient task app failed");
-        return ERR_STRATEGY_DEPENDS_SA_NOT_AVAILABLE;
-    }
-    // add continuous exemption flag for app with continuous task
-    STANDBYSERVICE_LOGD("succeed GetTransientTaskApps, size is %{public}d",
-        static_cast<int32_t>(transientTaskList.size()));
-    for (const auto& task : continuousTaskList) {
-        auto iter = uidBundleNmeMap_.find(task->GetCreatorUid());
-        if (iter == uidBundleNmeMap_.end()) {
-            continue;
-        }
-        std::string key = std::to_string(task->GetCreatorUid()) + "_" + iter->second;
-        if (auto infoIter = proxiedAppInfo_.find(key); infoIter == proxiedAppInfo_.end()) {
-            continue;
-        } else {
-            infoIter->second.appExemptionFlag_ |= ExemptionTypeFlag::CONTINUOUS_TASK;
+    // add continuous and transient exemption flag for app with background task
+    AppStateCache::GetInstance()->ForEachRunningApp([this](const AppStateInfo& appState) {
+        if (!appState.continuousTaskTypeIds_.empty()) {
+            AddExemptionFlagByUid(appState.uid_, ExemptionTypeFlag::CONTINUOUS_TASK);
         }
-    }
-    // add transient exemption flag for app with transient task
-    for (const auto& task : transientTaskList) {
-        std::string key = std::to_string(task->GetUid()) + "_" + task->GetPackageName();
-        if (auto iter = proxiedAppInfo_.find(key); iter == proxiedAppInfo_.end()) {
-            continue;
-        } else {
-            iter->second.appExemptionFlag_ |= ExemptionTypeFlag::TRANSIENT_TASK;
+        if (appState.hasTransientTask_) {
+            AddExemptionFlagByUid(appState.uid_, ExemptionTypeFlag::TRANSIENT_TASK);
         }
-    }
+    });
     #endif
     return ERR_OK;
 }
 
+void RunningLockStrategy::AddExemptionFlagByUid(int32_t uid, uint8_t flag)
+{
+    auto bundleIter = uidBundleNmeMap_.find(uid);
+    if (bundleIter == uidBundleNmeMap_.end()) {
+        return;
+    }
+    if (size_t row = proxiedAppInfo_.Find(uid, bundleIter->second); row != ExemptionTable::NPOS) {
+        proxiedAppInfo_.AddFlag(row, flag);
+    }
+}
+
 ErrCode RunningLockStrategy::GetExemptionConfig()
 {
     // if app in exemption list, add its exemption flag
     std::vector<AllowInfo> allowInfoList {};
     StandbyServiceImpl::GetInstance()->GetAllowListInner(AllowType::RUNNING_LOCK, allowInfoList,
         ReasonCodeEnum::REASON_APP_API);
-    std::set<std::string> allowNameList {};
+    NameIdSet allowNameIds {};
     for (const auto& info : allowInfoList) {
-        allowNameList.emplace(info.GetName());
+        if (NameId nameId = NameInterner::GetInstance().Find(info.GetName()); nameId != INVALID_NAME_ID) {
+            allowNameIds.emplace(nameId);
+        }
     }
-    for (auto& [key, value] : proxiedAppInfo_) {
-        if (allowNameList.find(value.name_) == allowNameList.end()) {
+    for (size_t row = 0; row < proxiedAppInfo_.Size(); ++row) {
+        if (allowNameIds.count(proxiedAppInfo_.GetNameId(row)) == 0) {
             continue;
         }
-        value.appExemptionFlag_ |= ExemptionTypeFlag::EXEMPTION;
+        proxiedAppInfo_.AddFlag(row, ExemptionTypeFlag::EXEMPTION);
     }
 
     // if app in restrict list, add retricted flag
@@ -344,11 +362,13 @@ ErrCode RunningLockStrategy::GetExemptionConfig()
         ReasonCodeEnum::REASON_APP_API, restrictBundleName);
     STANDBYSERVICE_LOGI("running lock restrict app list, size is %{public}d",
         static_cast<int32_t>(restrictBundleName.size()));
-    for (auto& [key, value] : proxiedAppInfo_) {
-        if (restrictBundleName.find(value.name_) == restrictBundleName.end()) {
+    NameIdSet restrictNameIds {};
+    NameInterner::GetInstance().FindAll(restrictBundleName, restrictNameIds);
+    for (size_t row = 0; row < proxiedAppInfo_.Size(); ++row) {
+        if (restrictNameIds.count(proxiedAppInfo_.GetNameId(row)) == 0) {
             continue;
         }
-        value.appExemptionFlag_ |= ExemptionTypeFlag::RESTRICTED;
+        proxiedAppInfo_.AddFlag(row, ExemptionTypeFlag::RESTRICTED);
     }
     return ERR_OK;
 }
@@ -360,18 +380,35 @@ ErrCode RunningLockStrategy::InitNativeProcInfo()
 
 ErrCode RunningLockStrategy::ProxyAppAndProcess(bool isProxied)
 {
-    std::vector<std::pair<int32_t, int32_t>> proxiedAppList;
-    for (const auto& [key, value] : proxiedAppInfo_) {
-        if (ExemptionTypeFlag::IsExempted(value.appExemptionFlag_)) {
-            continue;
-        }
-        SetProxiedAppList(proxiedAppList, value);
-    }
-    STANDBYSERVICE_LOGD("proxied app size: %{public}d", static_cast<int32_t>(proxiedAppList.size()));
-    ProxyRunningLockList(isProxied, proxiedAppList);
+    if (isProxied) {
+        SyncProxiedPidList();
+        return ERR_OK;
+    }
+    // only pids proxied before need to be unproxied
+    std::vector<std::pair<int32_t, int32_t>> unproxiedAppList(proxiedPidSet_.begin(), proxiedPidSet_.end());
+    STANDBYSERVICE_LOGD("unproxied pid size: %{public}d", static_cast<int32_t>(unproxiedAppList.size()));
+    ProxyRunningLockList(false, unproxiedAppList);
     return ERR_OK;
 }
 
+void RunningLockStrategy::SyncProxiedPidList()
+{
+    std::vector<std::pair<int32_t, int32_t>> targetPidList {};
+    proxiedAppInfo_.CollectPids(GetProxiedFlagFilter(), targetPidList);
+    std::set<std::pair<int32_t, int32_t>> targetPidSet(targetPidList.begin(), targetPidList.end());
+    std::vector<std::pair<int32_t, int32_t>> unproxiedAppList {};
+    std::set_difference(proxiedPidSet_.begin(), proxiedPidSet_.end(), targetPidSet.begin(), targetPidSet.end(),
+        std::back_inserter(unproxiedAppList));
+    std::vector<std::pair<int32_t, int32_t>> proxiedAppList {};
+    std::set_difference(targetPidSet.begin(), targetPidSet.end(), proxiedPidSet_.begin(), proxiedPidSet_.end(),
+        std::back_inserter(proxiedAppList));
+    STANDBYSERVICE_LOGD("proxied pid size: %{public}d, proxy: %{public}d, unproxy: %{public}d",
+        static_cast<int32_t>(targetPidSet.size()), static_cast<int32_t>(proxiedAppList.size()),
+        static_cast<int32_t>(unproxiedAppList.size()));
+    ProxyRunningLockList(false, unproxiedAppList);
+    ProxyRunningLockList(true, proxiedAppList);
+}
+
 ErrCode RunningLockStrategy::StopProxy(const StandbyMessage& message)
 {
     StandbyHitraceChain traceChain(__func__);
@@ -451,12 +488,11 @@ void RunningLockStrategy::ResetProxyStatus(const StandbyMessage& message)
         return;
     }
     const uint8_t bgTaskFlag = (ExemptionTypeFlag::TRANSIENT_TASK | ExemptionTypeFlag::WORK_SCHEDULER);
-    for (const auto& [key, value] : proxiedAppInfo_) {
-        if ((value.appExemptionFlag_ & bgTaskFlag) == 0) {
-            continue;
-        }
-        RemoveExemptionFlag(value.uid_, value.name_, (value.appExemptionFlag_ & bgTaskFlag));
-    }
+    // only flags are changed, rows stay where they are
+    proxiedAppInfo_.ForEachRowWithAnyFlag(bgTaskFlag, [this, bgTaskFlag](size_t row) {
+        RemoveExemptionFlag(proxiedAppInfo_.GetUid(row), proxiedAppInfo_.GetName(row),
+            (proxiedAppInfo_.GetFlag(row) & bgTaskFlag));
+    });
     return;
 }
 
@@ -465,15 +501,14 @@ void RunningLockStrategy::AddExemptionFlag(int32_t uid, const std::string& name,
     if (!isProxied_) {
         return;
     }
-    std::string mapKey = std::to_string(uid) + "_" + name;
     // if last appExemptionFlag is not exempted, current appExemptionFlag is exempted, unproxy running lock
-    if (auto iter = proxiedAppInfo_.find(mapKey); iter != proxiedAppInfo_.end()) {
-        auto lastAppExemptionFlag = iter->second.appExemptionFlag_;
-        iter->second.appExemptionFlag_ |= flag;
+    if (size_t row = proxiedAppInfo_.Find(uid, name); row != ExemptionTable::NPOS) {
+        auto lastAppExemptionFlag = proxiedAppInfo_.GetFlag(row);
+        proxiedAppInfo_.AddFlag(row, flag);
         if (!ExemptionTypeFlag::IsExempted(lastAppExemptionFlag) &&
-            ExemptionTypeFlag::IsExempted(iter->second.appExemptionFlag_)) {
+            ExemptionTypeFlag::IsExempted(proxiedAppInfo_.GetFlag(row))) {
             std::vector<std::pair<int32_t, int32_t>> proxiedAppList;
-            SetProxiedAppList(proxiedAppList, iter->second);
+            SetProxiedAppList(proxiedAppList, row);
             ProxyRunningLockList(false, proxiedAppList);
         }
     }
@@ -481,52 +516,46 @@ void RunningLockStrategy::AddExemptionFlag(int32_t uid, const std::string& name,
 
 void RunningLockStrategy::RemoveExemptionFlag(int32_t uid, const std::string& name, uint8_t flag)
 {
-    std::string mapKey = std::to_string(uid) + "_" + name;
-    auto iter = proxiedAppInfo_.find(mapKey);
-    if (iter == proxiedAppInfo_.end()) {
+    size_t row = proxiedAppInfo_.Find(uid, name);
+    if (row == ExemptionTable::NPOS) {
         return;
     }
 
     // if last appExemptionFlag is exempted, current appExemptionFlag is unexempted, proxy running lock
-    auto lastAppExemptionFlag = iter->second.appExemptionFlag_;
-    iter->second.appExemptionFlag_ &= (~flag);
-    if (ExemptionTypeFlag::IsExempted(iter->second.appExemptionFlag_) ||
+    auto lastAppExemptionFlag = proxiedAppInfo_.GetFlag(row);
+    proxiedAppInfo_.RemoveFlag(row, flag);
+    if (ExemptionTypeFlag::IsExempted(proxiedAppInfo_.GetFlag(row)) ||
         !ExemptionTypeFlag::IsExempted(lastAppExemptionFlag)) {
         return;
     }
 
     std::vector<std::pair<int32_t, int32_t>> proxiedAppList;
-    SetProxiedAppList(proxiedAppList, iter->second);
+    SetProxiedAppList(proxiedAppList, row);
     ProxyRunningLockList(true, proxiedAppList);
 }
 
 void RunningLockStrategy::ClearProxyRecord()
 {
-    proxiedAppInfo_.clear();
+    proxiedAppInfo_.Clear();
     uidBundleNmeMap_.clear();
 }
 
 // when app is created, add app info to cache
 void RunningLockStrategy::GetAndCreateAppInfo(uint32_t uid, uint32_t pid, const std::string& bundleName)
 {
-    const std::string mapKey = std::to_string(uid) + "_" + bundleName;
-    auto iter = proxiedAppInfo_.find(mapKey);
-    if (iter != proxiedAppInfo_.end()) {
-        iter->second.pids_.emplace(pid);
+    auto [row, isInserted] = proxiedAppInfo_.Emplace(uid, bundleName);
+    proxiedAppInfo_.AddPid(row, pid);
+    if (!isInserted) {
         return;
     }
 
-    std::tie(iter, std::ignore) = proxiedAppInfo_.emplace(mapKey, ProxiedProcInfo {bundleName, uid});
-    iter->second.pids_.emplace(pid);
-
-    bool isSystemApp {false};
-    if (BundleManagerHelper::GetInstance()->CheckIsSystemAppByUid(uid, isSystemApp) && isSystemApp) {
-        iter->second.appExemptionFlag_ |= ExemptionTypeFlag::UNRESTRICTED;
+    if (AppStateCache::GetInstance()->IsSystemApp(uid)) {
+        proxiedAppInfo_.AddFlag(row, ExemptionTypeFlag::UNRESTRICTED);
     }
-    GetExemptionConfigForApp(iter->second, bundleName);
+    GetExemptionConfigForApp(row, bundleName);
 }
 
-ErrCode RunningLockStrategy::GetExemptionConfigForApp(ProxiedProcInfo& appInfo, const std::string& bundleName)
+ErrCode RunningLockStrategy::GetExemptionConfigForApp(size_t row, const std::string& bundleName)
 {
     // if app in exemption list, add exemption flag
     std::vector<AllowInfo> allowInfoList {};
@@ -537,7 +566,7 @@ ErrCode RunningLockStrategy::GetExemptionConfigForApp(ProxiedProcInfo& appInfo,
         if (info.GetName() != bundleName) {
             continue;
         }
-        appInfo.appExemptionFlag_ |= ExemptionTypeFlag::EXEMPTION;
+        proxiedAppInfo_.AddFlag(row, ExemptionTypeFlag::EXEMPTION);
     }
 
     // if app in restricted list, add retricted flag
@@ -545,16 +574,16 @@ ErrCode RunningLockStrategy::GetExemptionConfigForApp(ProxiedProcInfo& appInfo,
     StandbyServiceImpl::GetInstance()->GetEligiableRestrictSet(AllowType::NETWORK, "NETWORK",
         ReasonCodeEnum::REASON_APP_API, restrictNameList);
     if (restrictNameList.find(bundleName) != restrictNameList.end()) {
-        appInfo.appExemptionFlag_ |= ExemptionTypeFlag::RESTRICTED;
+        proxiedAppInfo_.AddFlag(row, ExemptionTypeFlag::RESTRICTED);
     }
     return ERR_OK;
 }
 
-void RunningLockStrategy::SetProxiedAppList(std::vector<std::pair<int32_t, int32_t>>& proxiedAppList,
-    const ProxiedProcInfo& info)
+void RunningLockStrategy::SetProxiedAppList(std::vector<std::pair<int32_t, int32_t>>& proxiedAppList, size_t row)
 {
-    for (auto& pid : info.pids_) {
-        proxiedAppList.emplace_back(std::make_pair(pid, info.uid_));
+    auto [pidBegin, pidEnd] = proxiedAppInfo_.GetPids(row);
+    for (auto iter = pidBegin; iter != pidEnd; ++iter) {
+        proxiedAppList.emplace_back(std::make_pair(*iter, proxiedAppInfo_.GetUid(row)));
     }
 }
 
@@ -569,11 +598,32 @@ void RunningLockStrategy::ProxyRunningLockList(bool isProxied,
         STANDBYSERVICE_LOGI("current is idle maintenance, can not proxy running lock");
         return;
     }
+    // pids already in target status are not sent again
+    std::vector<std::pair<int32_t, int32_t>> changedAppList {};
+    for (const auto& item : proxiedAppList) {
+        if ((proxiedPidSet_.find(item) == proxiedPidSet_.end()) == isProxied) {
+            changedAppList.emplace_back(item);
+        }
+    }
+    skippedProxyPairCount_ += proxiedAppList.size() - changedAppList.size();
+    if (changedAppList.empty()) {
+        return;
+    }
+    ++proxyIpcCount_;
+    proxyPairCount_ += changedAppList.size();
     #ifdef STANDBY_POWER_MANAGER_ENABLE
-    if (!PowerMgr::PowerMgrClient::GetInstance().ProxyRunningLocks(isProxied, proxiedAppList)) {
+    if (!PowerMgr::PowerMgrClient::GetInstance().ProxyRunningLocks(isProxied, changedAppList)) {
         STANDBYSERVICE_LOGW("failed to ProxyRunningLockList");
+        return;
     }
     #endif
+    for (const auto& item : changedAppList) {
+        if (isProxied) {
+            proxiedPidSet_.emplace(item);
+        } else {
+            proxiedPidSet_.erase(item);
+        }
+    }
 }
 
 void RunningLockStrategy::HandleProcessStatusChanged(const StandbyMessage& message)
@@ -590,24 +640,24 @@ void RunningLockStrategy::HandleProcessStatusChanged(const StandbyMessage& messa
     std::string bundleName = message.want_->GetStringParam("name");
     bool isCreated = message.want_->GetBoolParam("isCreated", false);
 
-    auto key = std::to_string(uid) + "_" + bundleName;
     if (isCreated) {
         // if process is created
         GetAndCreateAppInfo(uid, pid, bundleName);
-        if (!ExemptionTypeFlag::IsExempted(proxiedAppInfo_[key].appExemptionFlag_)) {
+        size_t row = proxiedAppInfo_.Find(uid, bundleName);
+        if (row != ExemptionTable::NPOS && !ExemptionTypeFlag::IsExempted(proxiedAppInfo_.GetFlag(row))) {
             ProxyRunningLockList(true, {std::make_pair(pid, uid)});
         }
     } else {
-        auto iter = proxiedAppInfo_.find(key);
-        if (iter == proxiedAppInfo_.end()) {
+        size_t row = proxiedAppInfo_.Find(uid, bundleName);
+        if (row == ExemptionTable::NPOS) {
             return;
         }
-        if (!ExemptionTypeFlag::IsExempted(proxiedAppInfo_[key].appExemptionFlag_)) {
+        if (!ExemptionTypeFlag::IsExempted(proxiedAppInfo_.GetFlag(row))) {
             ProxyRunningLockList(false, {std::make_pair(pid, uid)});
         }
-        iter->second.pids_.erase(pid);
-        if (iter->second.pids_.empty()) {
-            proxiedAppInfo_.erase(iter);
+        proxiedAppInfo_.RemovePid(row, pid);
+        if (proxiedAppInfo_.GetPidCount(row) == 0) {
+            proxiedAppInfo_.Erase(row);
         }
     }
 }
@@ -626,18 +676,26 @@ void RunningLockStrategy::DumpShowDetailInfo(const std::vector<std::string>& arg
     result.append("=================RunningLock======================\n");
     result.append("Running Lock Strategy:\n").append("isProxied: " + std::to_string(isProxied_))
         .append(" isIdleMaintence: " + std::to_string(isIdleMaintence_)).append("\n");
-    result.append("proxied app info: \n");
-    for (const auto& [key, value] : proxiedAppInfo_) {
-        result.append("key: ").append(key).append(" name: ").append(value.name_).append(" uid: ")
-            .append(std::to_string(value.uid_)).append(" pid_size: ")
-            .append(std::to_string(value.pids_.size())).append(" exemption flag: ")
-            .append(std::to_string(value.appExemptionFlag_)).append("\n");
-        if (value.pids_.empty()) {
+    result.append("proxied pid size: ").append(std::to_string(proxiedPidSet_.size()))
+        .append(" proxy ipc count: ").append(std::to_string(proxyIpcCount_))
+        .append(" sent pid count: ").append(std::to_string(proxyPairCount_))
+        .append(" skipped pid count: ").append(std::to_string(skippedProxyPairCount_))
+        .append(" condition reevaluated app count: ").append(std::to_string(conditionReevaluatedCount_))
+        .append("\n");
+    result.append("proxied app info, size: ").append(std::to_string(proxiedAppInfo_.Size()))
+        .append(" memory(bytes): ").append(std::to_string(proxiedAppInfo_.GetMemoryUsage())).append("\n");
+    for (size_t row = 0; row < proxiedAppInfo_.Size(); ++row) {
+        result.append("name: ").append(proxiedAppInfo_.GetName(row)).append(" uid: ")
+            .append(std::to_string(proxiedAppInfo_.GetUid(row))).append(" pid_size: ")
+            .append(std::to_string(proxiedAppInfo_.GetPidCount(row))).append(" exemption flag: ")
+            .append(std::to_string(proxiedAppInfo_.GetFlag(row))).append("\n");
+        if (proxiedAppInfo_.GetPidCount(row) == 0) {
             continue;
         }
         result.append("pids list: ");
-        for (const auto pid : value.pids_) {
-            result.append(" ").append(std::to_string(pid));
+        auto [pidBegin, pidEnd] = proxiedAppInfo_.GetPids(row);
+        for (auto iter = pidBegin; iter != pidEnd; ++iter) {
+            result.append(" ").append(std::to_string(*iter));
         }
         result.append("\n");
     }
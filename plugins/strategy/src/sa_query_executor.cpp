@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sa_query_executor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+
+#include "standby_service_log.h"
+#include "time_service_client.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+namespace {
+constexpr int32_t SA_QUERY_WORKER_NUM = 4;
+// the slowest query is waited for no longer than this, in ms
+constexpr int64_t SA_QUERY_TIMEOUT = 3000;
+
+struct SaQueryBatchState {
+    std::mutex mutex_ {};
+    std::condition_variable condition_ {};
+    uint32_t remaining_ {0};
+    bool failed_ {false};
+};
+}
+
+SaQueryExecutor::SaQueryExecutor() {}
+
+SaQueryExecutor::~SaQueryExecutor()
+{
+    std::lock_guard<std::mutex> lock(workerMutex_);
+    if (isWorkerStarted_) {
+        workers_.Stop();
+        isWorkerStarted_ = false;
+    }
+}
+
+std::shared_ptr<SaQueryExecutor> SaQueryExecutor::GetInstance()
+{
+    return DelayedSingleton<SaQueryExecutor>::GetInstance();
+}
+
+ErrCode SaQueryExecutor::QueryAppStates(uint32_t queryMask, std::shared_ptr<AppStateQueryResult>& result)
+{
+    // result is shared with worker threads, which may outlive this call if deadline is reached
+    result = std::make_shared<AppStateQueryResult>();
+    std::vector<SaQueryTask> tasks {};
+    BuildQueryTasks(queryMask, result, tasks);
+    if (!RunQueryTasks(tasks, SA_QUERY_TIMEOUT)) {
+        result = nullptr;
+        return ERR_STRATEGY_DEPENDS_SA_NOT_AVAILABLE;
+    }
+    return ERR_OK;
+}
+
+void SaQueryExecutor::BuildQueryTasks(uint32_t queryMask, const std::shared_ptr<AppStateQueryResult>& result,
+    std::vector<SaQueryTask>& tasks)
+{
+    if ((queryMask & SaQueryType::RUNNING_PROCESS) != 0) {
+        tasks.emplace_back("GetAllRunningProcesses", [result]() {
+            return AppMgrHelper::GetInstance()->GetAllRunningProcesses(result->runningProcesses_);
+        });
+    }
+    if ((queryMask & SaQueryType::APPLICATION_INFO) != 0) {
+        tasks.emplace_back("GetApplicationInfos", [result]() {
+            return BundleManagerHelper::GetInstance()->GetApplicationInfos(
+                AppExecFwk::ApplicationFlag::GET_BASIC_APPLICATION_INFO,
+                AppExecFwk::Constants::ALL_USERID, result->applicationInfos_);
+        });
+    }
+    if ((queryMask & SaQueryType::SPECIAL_APPLICATION_INFO) != 0) {
+        // apps of special user are optional, failure does not affect restriction of other apps
+        tasks.emplace_back("GetSpecialApplicationInfos", [result]() {
+            if (!BundleManagerHelper::GetInstance()->GetApplicationInfos(
+                AppExecFwk::ApplicationFlag::GET_BASIC_APPLICATION_INFO,
+                UserSpace::SPECIAL_USERID, result->specialApplicationInfos_)) {
+                STANDBYSERVICE_LOGW("failed to get special applicationInfos");
+            }
+            return true;
+        });
+    }
+    if ((queryMask & SaQueryType::FOREGROUND_APP) != 0) {
+        tasks.emplace_back("GetForegroundApplications", [result]() {
+            return AppMgrHelper::GetInstance()->GetForegroundApplications(result->foregroundApps_);
+        });
+    }
+    #ifdef ENABLE_BACKGROUND_TASK_MGR
+    if ((queryMask & SaQueryType::CONTINUOUS_TASK) != 0) {
+        tasks.emplace_back("GetContinuousTaskApps", [result]() {
+            return BackgroundTaskHelper::GetInstance()->GetContinuousTaskApps(result->continuousTasks_);
+        });
+    }
+    if ((queryMask & SaQueryType::TRANSIENT_TASK) != 0) {
+        tasks.emplace_back("GetTransientTaskApps", [result]() {
+            return BackgroundTaskHelper::GetInstance()->GetTransientTaskApps(result->transientTasks_);
+        });
+    }
+    #endif
+    #ifdef STANDBY_RSS_WORK_SCHEDULER_ENABLE
+    if ((queryMask & SaQueryType::WORK_SCHEDULER) != 0) {
+        tasks.emplace_back("GetAllRunningWorks", [result]() {
+            return WorkScheduler::WorkSchedulerSrvClient::GetInstance().GetAllRunningWorks(
+                result->workInfos_) == ERR_OK;
+        });
+    }
+    #endif
+}
+
+bool SaQueryExecutor::RunQueryTasks(const std::vector<SaQueryTask>& tasks, int64_t timeOutMs)
+{
+    if (tasks.empty()) {
+        return true;
+    }
+    if (!StartWorkersIfNeed()) {
+        // fall back to query one by one on current thread
+        for (const auto& [queryName, query] : tasks) {
+            int64_t startTime = MiscServices::TimeServiceClient::GetInstance()->GetMonotonicTimeMs();
+            bool succeed = query();
+            RecordLatency(queryName, MiscServices::TimeServiceClient::GetInstance()->GetMonotonicTimeMs() -
+                startTime, succeed);
+            if (!succeed) {
+                return false;
+            }
+        }
+        return true;
+    }
+    auto state = std::make_shared<SaQueryBatchState>();
+    state->remaining_ = static_cast<uint32_t>(tasks.size());
+    for (const auto& task : tasks) {
+        workers_.AddTask([this, state, task]() {
+            int64_t startTime = MiscServices::TimeServiceClient::GetInstance()->GetMonotonicTimeMs();
+            bool succeed = task.second();
+            RecordLatency(task.first, MiscServices::TimeServiceClient::GetInstance()->GetMonotonicTimeMs() -
+                startTime, succeed);
+            std::lock_guard<std::mutex> lock(state->mutex_);
+            state->failed_ = state->failed_ || !succeed;
+            --state->remaining_;
+            state->condition_.notify_one();
+        });
+    }
+    std::unique_lock<std::mutex> lock(state->mutex_);
+    bool finished = state->condition_.wait_for(lock, std::chrono::milliseconds(timeOutMs),
+        [state]() { return state->remaining_ == 0 || state->failed_; });
+    if (!finished) {
+        std::lock_guard<std::mutex> latencyLock(latencyMutex_);
+        ++timeoutCount_;
+        STANDBYSERVICE_LOGW("sa query timeout, %{public}u queries unfinished", state->remaining_);
+        return false;
+    }
+    return !state->failed_;
+}
+
+bool SaQueryExecutor::StartWorkersIfNeed()
+{
+    std::lock_guard<std::mutex> lock(workerMutex_);
+    if (isWorkerStarted_) {
+        return true;
+    }
+    if (workers_.Start(SA_QUERY_WORKER_NUM) != ERR_OK) {
+        STANDBYSERVICE_LOGE("failed to start sa query workers");
+        return false;
+    }
+    isWorkerStarted_ = true;
+    return true;
+}
+
+void SaQueryExecutor::RecordLatency(const std::string& queryName, int64_t costMs, bool succeed)
+{
+    STANDBYSERVICE_LOGD("%{public}s cost %{public}lld ms, succeed: %{public}d", queryName.c_str(),
+        static_cast<long long>(costMs), succeed);
+    std::lock_guard<std::mutex> lock(latencyMutex_);
+    auto& latency = latencyMap_[queryName];
+    ++latency.count_;
+    if (!succeed) {
+        ++latency.failedCount_;
+    }
+    latency.lastCostMs_ = costMs;
+    latency.maxCostMs_ = std::max(latency.maxCostMs_, costMs);
+    latency.totalCostMs_ += costMs;
+}
+
+void SaQueryExecutor::ShellDump(std::string& result)
+{
+    std::lock_guard<std::mutex> lock(latencyMutex_);
+    result.append("=================SaQuery==========================\n");
+    result.append("timeout count: ").append(std::to_string(timeoutCount_)).append("\n");
+    for (const auto& [queryName, latency] : latencyMap_) {
+        result.append(queryName).append(" count: ").append(std::to_string(latency.count_))
+            .append(" failed: ").append(std::to_string(latency.failedCount_))
+            .append(" last(ms): ").append(std::to_string(latency.lastCostMs_))
+            .append(" max(ms): ").append(std::to_string(latency.maxCostMs_))
+            .append(" avg(ms): ").append(std::to_string(latency.count_ == 0 ? 0 :
+                latency.totalCostMs_ / latency.count_)).append("\n");
+    }
+}
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
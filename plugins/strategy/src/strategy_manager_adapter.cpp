@@ -15,23 +15,87 @@
 
 #include "strategy_manager_adapter.h"
 
+#include <algorithm>
+#include <condition_variable>
+
 #include "ibase_strategy.h"
 #include "standby_service_log.h"
 #ifdef STANDBY_COMMUNICATION_NETMANAGER_BASE_ENABLE
 #include "network_strategy.h"
 #endif
 #include "standby_config_manager.h"
+#include "freeze_strategy.h"
+#include "heartbeat_align_strategy.h"
 #include "running_lock_strategy.h"
+#include "timer_strategy.h"
+#ifdef STANDBY_RSS_WORK_SCHEDULER_ENABLE
+#include "work_scheduler_strategy.h"
+#endif
+#include "app_state_cache.h"
+#include "sa_query_executor.h"
+#include "strategy_registry.h"
+#include "common_constant.h"
+#include "name_interner.h"
+#include "system_ability_definition.h"
+#include "time_service_client.h"
 
 namespace OHOS {
 namespace DevStandbyMgr {
 namespace {
-const std::map<std::string, std::shared_ptr<IBaseStrategy>> strategyMap_ {
+constexpr int32_t STRATEGY_WORKER_NUM = 3;
+
+void RegisterBuiltinStrategies()
+{
+    auto registry = StrategyRegistry::GetInstance();
     #ifdef STANDBY_COMMUNICATION_NETMANAGER_BASE_ENABLE
-    { "NETWORK", std::make_shared<NetworkStrategy>() },
+    registry->RegisterStrategy({"NETWORK", []() { return std::make_shared<NetworkStrategy>(); },
+        StrategyRegistry::GetEventMask({StandbyMessageType::STATE_TRANSIT, StandbyMessageType::PHASE_TRANSIT,
+            StandbyMessageType::RES_CTRL_CONDITION_CHANGED, StandbyMessageType::ALLOW_LIST_CHANGED,
+            StandbyMessageType::BG_TASK_STATUS_CHANGE, StandbyMessageType::PROCESS_STATE_CHANGED}),
+        {COMM_NET_POLICY_MANAGER_SYS_ABILITY_ID}});
     #endif
-    { "RUNNING_LOCK", std::make_shared<RunningLockStrategy>() },
-};
+    registry->RegisterStrategy({"RUNNING_LOCK", []() { return std::make_shared<RunningLockStrategy>(); },
+        StrategyRegistry::GetEventMask({StandbyMessageType::STATE_TRANSIT, StandbyMessageType::PHASE_TRANSIT,
+            StandbyMessageType::RES_CTRL_CONDITION_CHANGED, StandbyMessageType::ALLOW_LIST_CHANGED,
+            StandbyMessageType::BG_TASK_STATUS_CHANGE, StandbyMessageType::PROCESS_STATE_CHANGED,
+            StandbyMessageType::SYS_ABILITY_STATUS_CHANGED}),
+        {POWER_MANAGER_SERVICE_ID}});
+    registry->RegisterStrategy({"TIMER", []() { return std::make_shared<TimerStrategy>(); },
+        StrategyRegistry::GetEventMask({StandbyMessageType::STATE_TRANSIT,
+            StandbyMessageType::RES_CTRL_CONDITION_CHANGED, StandbyMessageType::ALLOW_LIST_CHANGED}),
+        {TIME_SERVICE_ID}});
+    registry->RegisterStrategy({"FREEZE", []() { return std::make_shared<FreezeStrategy>(); },
+        StrategyRegistry::GetEventMask({StandbyMessageType::STATE_TRANSIT, StandbyMessageType::PHASE_TRANSIT,
+            StandbyMessageType::ALLOW_LIST_CHANGED, StandbyMessageType::BG_TASK_STATUS_CHANGE,
+            StandbyMessageType::PROCESS_STATE_CHANGED, StandbyMessageType::APP_FOREGROUND_STATE_CHANGED}),
+        {APP_MGR_SERVICE_ID}});
+    registry->RegisterStrategy({"HEARTBEAT_ALIGN", []() { return std::make_shared<HeartbeatAlignStrategy>(); },
+        StrategyRegistry::GetEventMask({StandbyMessageType::STATE_TRANSIT,
+            StandbyMessageType::NAT_DETECT_INTERVAL_CHANGED, StandbyMessageType::NAT_MSG_RECV,
+            StandbyMessageType::HEART_BEAT_VALUE_CHANGE}),
+        {}});
+    #ifdef STANDBY_RSS_WORK_SCHEDULER_ENABLE
+    registry->RegisterStrategy({"WORK_SCHEDULER", []() { return std::make_shared<WorkSchedulerStrategy>(); },
+        StrategyRegistry::GetEventMask({StandbyMessageType::STATE_TRANSIT,
+            StandbyMessageType::BG_TASK_STATUS_CHANGE}),
+        {WORK_SCHEDULE_SERVICE_ID}});
+    #endif
+}
+}
+
+StrategyManagerAdapter::StrategyManagerAdapter()
+{
+    static std::once_flag builtinFlag;
+    std::call_once(builtinFlag, RegisterBuiltinStrategies);
+}
+
+StrategyManagerAdapter::~StrategyManagerAdapter()
+{
+    std::lock_guard<std::mutex> lock(workerMutex_);
+    if (isWorkerStarted_) {
+        workers_.Stop();
+        isWorkerStarted_ = false;
+    }
 }
 
 bool StrategyManagerAdapter::Init()
@@ -45,7 +109,10 @@ bool StrategyManagerAdapter::Init()
         STANDBYSERVICE_LOGI("strategies is disabled");
         return true;
     }
+    // strategies read app states from the cache, load failure is retried when a strategy uses it
+    AppStateCache::GetInstance()->Load();
     RegisterPolicy(strategyConfigList);
+    isConcurrent_ = StandbyConfigManager::GetInstance()->GetStandbySwitch(STRATEGY_CONCURRENT_SWITCH);
     STANDBYSERVICE_LOGI("strategy manager plugin initialization succeed");
     return true;
 }
@@ -56,23 +123,30 @@ bool StrategyManagerAdapter::UnInit()
         strategy->OnDestroy();
     }
     strategyList_.clear();
+    eventMaskMap_.clear();
+    {
+        // keyed by the freed strategies, whose addresses may be reused
+        std::lock_guard<std::mutex> lock(timingMutex_);
+        timingMap_.clear();
+    }
+    AppStateCache::GetInstance()->Clear();
     return true;
 }
 
 void StrategyManagerAdapter::RegisterPolicy(const std::vector<std::string>& strategies)
 {
     for (const auto& item : strategies) {
-        auto strategy = strategyMap_.find(item);
-        if (strategy == strategyMap_.end()) {
-            continue;
-        }
-        STANDBYSERVICE_LOGI("strategy manager init %{public}s", item.c_str());
-        auto strategyPtr = strategy->second;
+        uint64_t eventMask {0};
+        auto strategyPtr = StrategyRegistry::GetInstance()->CreateStrategy(item, eventMask);
         if (!strategyPtr) {
             continue;
         }
+        STANDBYSERVICE_LOGI("strategy manager init %{public}s", item.c_str());
         if (strategyPtr->OnCreated() == ERR_OK) {
             strategyList_.emplace_back(strategyPtr);
+            eventMaskMap_[strategyPtr.get()] = eventMask;
+            std::lock_guard<std::mutex> lock(timingMutex_);
+            timingMap_[strategyPtr.get()].name_ = item;
         }
     }
 }
@@ -81,16 +155,132 @@ void StrategyManagerAdapter::HandleEvent(const StandbyMessage& message)
 {
     STANDBYSERVICE_LOGD("StrategyManagerAdapter revceive message %{public}u, action: %{public}s",
         message.eventId_, message.action_.c_str());
+    if (!strategyList_.empty()) {
+        AppStateCache::GetInstance()->HandleEvent(message);
+    }
+    std::vector<std::shared_ptr<IBaseStrategy>> receivers {};
+    receivers.reserve(strategyList_.size());
     for (const auto &strategy : strategyList_) {
-        strategy->HandleEvent(message);
+        if (IsEventConsumed(strategy, message.eventId_)) {
+            receivers.emplace_back(strategy);
+        }
+    }
+    if (isConcurrent_ && receivers.size() > 1 && IsConcurrentEvent(message.eventId_)) {
+        HandleEventConcurrently(receivers, message);
+        return;
+    }
+    for (const auto &strategy : receivers) {
+        HandleStrategyEvent(strategy, message);
     }
 }
 
+bool StrategyManagerAdapter::IsEventConsumed(const std::shared_ptr<IBaseStrategy>& strategy, uint32_t eventId)
+{
+    auto iter = eventMaskMap_.find(strategy.get());
+    if (iter == eventMaskMap_.end()) {
+        return true;
+    }
+    return StrategyRegistry::IsEventConsumed(iter->second, eventId);
+}
+
+bool StrategyManagerAdapter::IsConcurrentEvent(uint32_t eventId)
+{
+    // only events on which strategies call other system abilities are worth switching threads
+    return eventId == StandbyMessageType::STATE_TRANSIT || eventId == StandbyMessageType::PHASE_TRANSIT ||
+        eventId == StandbyMessageType::RES_CTRL_CONDITION_CHANGED;
+}
+
+void StrategyManagerAdapter::HandleEventConcurrently(
+    const std::vector<std::shared_ptr<IBaseStrategy>>& receivers, const StandbyMessage& message)
+{
+    if (!StartWorkersIfNeed()) {
+        for (const auto &strategy : receivers) {
+            HandleStrategyEvent(strategy, message);
+        }
+        return;
+    }
+    ++concurrentEventCount_;
+    std::mutex finishMutex;
+    std::condition_variable finishCondition;
+    size_t remaining = receivers.size() - 1;
+    for (auto iter = std::next(receivers.begin()); iter != receivers.end(); ++iter) {
+        workers_.AddTask([this, strategy = *iter, &message, &finishMutex, &finishCondition, &remaining]() {
+            HandleStrategyEvent(strategy, message);
+            std::lock_guard<std::mutex> lock(finishMutex);
+            --remaining;
+            finishCondition.notify_one();
+        });
+    }
+    // the first strategy runs on current thread, saving one thread switch
+    HandleStrategyEvent(receivers.front(), message);
+    // barrier, next message is not dispatched until all strategies finish current one
+    std::unique_lock<std::mutex> lock(finishMutex);
+    finishCondition.wait(lock, [&remaining]() { return remaining == 0; });
+}
+
+void StrategyManagerAdapter::HandleStrategyEvent(const std::shared_ptr<IBaseStrategy>& strategy,
+    const StandbyMessage& message)
+{
+    int64_t startTime = MiscServices::TimeServiceClient::GetInstance()->GetMonotonicTimeMs();
+    strategy->HandleEvent(message);
+    int64_t costMs = MiscServices::TimeServiceClient::GetInstance()->GetMonotonicTimeMs() - startTime;
+    std::lock_guard<std::mutex> lock(timingMutex_);
+    auto& timing = timingMap_[strategy.get()];
+    ++timing.count_;
+    timing.lastCostMs_ = costMs;
+    timing.maxCostMs_ = std::max(timing.maxCostMs_, costMs);
+    timing.totalCostMs_ += costMs;
+}
+
+bool StrategyManagerAdapter::StartWorkersIfNeed()
+{
+    std::lock_guard<std::mutex> lock(workerMutex_);
+    if (isWorkerStarted_) {
+        return true;
+    }
+    if (workers_.Start(STRATEGY_WORKER_NUM) != ERR_OK) {
+        STANDBYSERVICE_LOGE("failed to start strategy workers");
+        return false;
+    }
+    isWorkerStarted_ = true;
+    return true;
+}
+
 void StrategyManagerAdapter::ShellDump(const std::vector<std::string>& argsInStr, std::string& result)
 {
     for (const auto &strategy : strategyList_) {
         strategy->ShellDump(argsInStr, result);
     }
+    if (argsInStr[DUMP_FIRST_PARAM] == DUMP_DETAIL_INFO &&
+        argsInStr[DUMP_SECOND_PARAM] == DUMP_STRATGY_DETAIL) {
+        AppStateCache::GetInstance()->ShellDump(result);
+        SaQueryExecutor::GetInstance()->ShellDump(result);
+        StrategyRegistry::GetInstance()->ShellDump(result);
+        DumpStrategyTiming(result);
+        auto& interner = NameInterner::GetInstance();
+        result.append("interned names: ").append(std::to_string(interner.Size()))
+            .append(" memory(B): ").append(std::to_string(interner.GetMemoryUsage())).append("\n");
+    }
+}
+
+void StrategyManagerAdapter::DumpStrategyTiming(std::string& result)
+{
+    std::lock_guard<std::mutex> lock(timingMutex_);
+    result.append("=================StrategyTiming===================\n");
+    result.append("concurrent: ").append(std::to_string(isConcurrent_))
+        .append(" concurrent event count: ").append(std::to_string(concurrentEventCount_)).append("\n");
+    for (const auto& strategy : strategyList_) {
+        auto iter = timingMap_.find(strategy.get());
+        if (iter == timingMap_.end()) {
+            continue;
+        }
+        const auto& timing = iter->second;
+        result.append(timing.name_).append(" count: ").append(std::to_string(timing.count_))
+            .append(" last(ms): ").append(std::to_string(timing.lastCostMs_))
+            .append(" max(ms): ").append(std::to_string(timing.maxCostMs_))
+            .append(" avg(ms): ").append(std::to_string(timing.count_ == 0 ? 0 :
+                timing.totalCostMs_ / static_cast<int64_t>(timing.count_))).append("\n");
+    }
 }
 }  // namespace DevStandbyMgr
 }  // namespace OHOS
\ No newline at end of file
@@ -14,29 +14,233 @@
  */
 
 #include "timer_strategy.h"
+
+#include <algorithm>
+
+#include "allow_type.h"
+#include "common_constant.h"
+#include "standby_config_manager.h"
+#include "standby_service_impl.h"
 #include "standby_service_log.h"
+#include "standby_state.h"
+#include "time_provider.h"
+#include "time_service_client.h"
 
 namespace OHOS {
 namespace DevStandbyMgr {
+namespace {
+bool IsConditionEligible(const std::vector<uint32_t>& configConditions, uint32_t condition)
+{
+    return std::any_of(configConditions.begin(), configConditions.end(),
+        [condition](uint32_t configCondition) { return (condition & configCondition) == configCondition; });
+}
+}
+
 void TimerStrategy::HandleEvent(const StandbyMessage& message)
 {
     STANDBYSERVICE_LOGD("TimerStrategy revceived message %{public}u, action: %{public}s",
         message.eventId_, message.action_.c_str());
+    switch (message.eventId_) {
+        case StandbyMessageType::STATE_TRANSIT:
+            HandleStateTransit(message);
+            break;
+        case StandbyMessageType::ALLOW_LIST_CHANGED:
+            if (message.want_.has_value() &&
+                (static_cast<uint32_t>(message.want_->GetIntParam("allowType", 0)) & AllowType::TIMER) != 0) {
+                UpdateTimerExemption();
+            }
+            break;
+        case StandbyMessageType::RES_CTRL_CONDITION_CHANGED:
+            UpdateTimerExemption();
+            break;
+        default:
+            break;
+    }
 }
 
 ErrCode TimerStrategy::OnCreated()
 {
+    // standby service may be restarted, timers adjusted by last process are restored
+    MiscServices::TimeServiceClient::GetInstance()->AdjustTimer(false, 0);
     return ERR_OK;
 }
 
 ErrCode TimerStrategy::OnDestroy()
 {
+    StopAlignTimer();
+    return ERR_OK;
+}
+
+ErrCode TimerStrategy::HandleStateTransit(const StandbyMessage& message)
+{
+    if (!message.want_.has_value()) {
+        return ERR_STANDBY_OBJECT_NULL;
+    }
+    uint32_t curState = static_cast<uint32_t>(message.want_->GetIntParam(CURRENT_STATE, 0));
+    if (curState == StandbyState::NAP || curState == StandbyState::SLEEP) {
+        uint32_t interval = GetAlignInterval(curState);
+        if (interval == 0) {
+            return StopAlignTimer();
+        }
+        if (isAligned_ && interval == alignInterval_) {
+            return ERR_OK;
+        }
+        return StartAlignTimer(interval);
+    }
+    if (curState == StandbyState::MAINTENANCE) {
+        // aligned timers are triggered together in maintenance window
+        if (isAligned_) {
+            ++alignedWindowCount_;
+        }
+        return ERR_OK;
+    }
+    return StopAlignTimer();
+}
+
+uint32_t TimerStrategy::GetAlignInterval(uint32_t state)
+{
+    auto intervalList = StandbyConfigManager::GetInstance()->GetStandbyDurationList(
+        state == StandbyState::NAP ? NAP_MAINT_DURATION : SLEEP_MAINT_DURATOIN);
+    uint32_t alignInterval = 0;
+    for (const auto interval : intervalList) {
+        if (interval > 0 && (alignInterval == 0 || static_cast<uint32_t>(interval) < alignInterval)) {
+            alignInterval = static_cast<uint32_t>(interval);
+        }
+    }
+    return alignInterval;
+}
+
+ErrCode TimerStrategy::StartAlignTimer(uint32_t interval)
+{
+    uint32_t lastInterval = alignInterval_;
+    alignInterval_ = interval;
+    // exemption is applied before alignment, so that exempted timers are never delayed
+    UpdateTimerExemption();
+    ++adjustIpcCount_;
+    if (MiscServices::TimeServiceClient::GetInstance()->AdjustTimer(true, interval) != ERR_OK) {
+        STANDBYSERVICE_LOGW("failed to align timer to interval %{public}u", interval);
+        alignInterval_ = lastInterval;
+        if (!isAligned_) {
+            // nothing is aligned, and StopAlignTimer will not run to revoke the exemption
+            SetTimerExemption(exemptionNames_, false);
+            exemptionNames_.clear();
+        }
+        return ERR_STRATEGY_DEPENDS_SA_NOT_AVAILABLE;
+    }
+    if (!isAligned_) {
+        alignStartTime_ = MiscServices::TimeServiceClient::GetInstance()->GetMonotonicTimeMs();
+        isAligned_ = true;
+    }
+    STANDBYSERVICE_LOGI("align timer to interval %{public}u, exempted size is %{public}d", interval,
+        static_cast<int32_t>(exemptionNames_.size()));
     return ERR_OK;
 }
 
+ErrCode TimerStrategy::StopAlignTimer()
+{
+    if (!isAligned_) {
+        return ERR_STANDBY_CURRENT_STATE_NOT_MATCH;
+    }
+    ++adjustIpcCount_;
+    if (MiscServices::TimeServiceClient::GetInstance()->AdjustTimer(false, 0) != ERR_OK) {
+        STANDBYSERVICE_LOGW("failed to restore aligned timer");
+    }
+    SetTimerExemption(exemptionNames_, false);
+    exemptionNames_.clear();
+    totalAlignedTime_ += MiscServices::TimeServiceClient::GetInstance()->GetMonotonicTimeMs() - alignStartTime_;
+    isAligned_ = false;
+    alignInterval_ = 0;
+    STANDBYSERVICE_LOGI("stop align timer, aligned window count is %{public}llu",
+        static_cast<unsigned long long>(alignedWindowCount_));
+    return ERR_OK;
+}
+
+void TimerStrategy::UpdateTimerExemption()
+{
+    if (alignInterval_ == 0) {
+        return;
+    }
+    std::unordered_set<std::string> exemptionNames {};
+    GetExemptionNames(exemptionNames);
+    std::unordered_set<std::string> addedNames {};
+    for (const auto& name : exemptionNames) {
+        if (exemptionNames_.find(name) == exemptionNames_.end()) {
+            addedNames.emplace(name);
+        }
+    }
+    std::unordered_set<std::string> removedNames {};
+    for (const auto& name : exemptionNames_) {
+        if (exemptionNames.find(name) == exemptionNames.end()) {
+            removedNames.emplace(name);
+        }
+    }
+    SetTimerExemption(removedNames, false);
+    SetTimerExemption(addedNames, true);
+    exemptionNames_ = std::move(exemptionNames);
+}
+
+void TimerStrategy::GetExemptionNames(std::unordered_set<std::string>& exemptionNames)
+{
+    // clock timer is triggered on time, timer whose period is shorter than interval is not delayed either
+    uint32_t condition = TimeProvider::GetCondition();
+    for (const auto& timerConfig : StandbyConfigManager::GetInstance()->GetTimerResConfig()) {
+        if (!timerConfig.isAllow_ || !IsConditionEligible(timerConfig.conditions_, condition)) {
+            continue;
+        }
+        for (const auto& timerClockApp : timerConfig.timerClockApps_) {
+            if (timerClockApp.isTimerClock_ || (timerClockApp.timerPeriod_ > 0 &&
+                static_cast<uint32_t>(timerClockApp.timerPeriod_) < alignInterval_)) {
+                exemptionNames.emplace(timerClockApp.name_);
+            }
+        }
+    }
+    for (const auto reasonCode : {ReasonCodeEnum::REASON_APP_API, ReasonCodeEnum::REASON_NATIVE_API}) {
+        std::vector<AllowInfo> allowInfoList {};
+        StandbyServiceImpl::GetInstance()->GetAllowListInner(AllowType::TIMER, allowInfoList, reasonCode);
+        for (const auto& info : allowInfoList) {
+            exemptionNames.emplace(info.GetName());
+        }
+    }
+}
+
+void TimerStrategy::SetTimerExemption(const std::unordered_set<std::string>& names, bool isExemption)
+{
+    if (names.empty()) {
+        return;
+    }
+    ++exemptionIpcCount_;
+    if (MiscServices::TimeServiceClient::GetInstance()->SetTimerExemption(names, isExemption) != ERR_OK) {
+        STANDBYSERVICE_LOGW("failed to set timer exemption of %{public}d apps, isExemption: %{public}d",
+            static_cast<int32_t>(names.size()), isExemption);
+    }
+}
+
 void TimerStrategy::ShellDump(const std::vector<std::string>& argsInStr, std::string& result)
 {
-    STANDBYSERVICE_LOGD("Timer Strategy Dump");
+    if (argsInStr[DUMP_FIRST_PARAM] == DUMP_DETAIL_INFO &&
+        argsInStr[DUMP_SECOND_PARAM] == DUMP_STRATGY_DETAIL) {
+        DumpShowDetailInfo(argsInStr, result);
+    }
+}
+
+void TimerStrategy::DumpShowDetailInfo(const std::vector<std::string>& argsInStr, std::string& result)
+{
+    int64_t alignedTime = totalAlignedTime_;
+    if (isAligned_) {
+        alignedTime += MiscServices::TimeServiceClient::GetInstance()->GetMonotonicTimeMs() - alignStartTime_;
+    }
+    result.append("=================Timer============================\n");
+    result.append("Timer Strategy:\n").append("isAligned: " + std::to_string(isAligned_))
+        .append(" align interval(s): " + std::to_string(alignInterval_)).append("\n");
+    result.append("aligned window count: ").append(std::to_string(alignedWindowCount_))
+        .append(" aligned time(ms): ").append(std::to_string(alignedTime))
+        .append(" adjust ipc count: ").append(std::to_string(adjustIpcCount_))
+        .append(" exemption ipc count: ").append(std::to_string(exemptionIpcCount_)).append("\n");
+    result.append("exempted names:");
+    for (const auto& name : exemptionNames_) {
+        result.append(" ").append(name);
+    }
+    result.append("\n");
 }
 }  // namespace DevStandbyMgr
-}  // namespace OHOS
\ No newline at end of file
+}  // namespace OHOS
@@ -14,24 +14,317 @@
  */
 
 #include "work_scheduler_strategy.h"
+
+#include <algorithm>
+#include <tuple>
+
+#include "allow_type.h"
+#include "common_constant.h"
+#include "standby_config_manager.h"
+#include "standby_service_impl.h"
 #include "standby_service_log.h"
+#include "standby_state.h"
+#include "time_service_client.h"
+#ifdef STANDBY_RSS_WORK_SCHEDULER_ENABLE
+#include "workscheduler_srv_client.h"
+#endif
 
 namespace OHOS {
 namespace DevStandbyMgr {
+namespace {
+const std::string WORK_MAX_CONCURRENCY = "work_max_concurrency";
+constexpr int32_t DEFAULT_WORK_MAX_CONCURRENCY = 3;
+const std::string RELEASE_DEFERRED_WORK_TASK = "ReleaseDeferredWorkTask";
+// deferred works are checked periodically in maintenance in case finish of work is not reported, in ms
+constexpr int64_t RELEASE_DEFERRED_WORK_INTERVAL = 10 * 1000;
+// released work holds its slot no longer than this, in ms
+constexpr int64_t RELEASED_WORK_TIMEOUT = 60 * 1000;
+constexpr size_t MAX_RECENT_BATCH_NUM = 10;
+}
+
 void WorkSchedulerStrategy::HandleEvent(const StandbyMessage& message)
 {
-    STANDBYSERVICE_LOGD("NetworkStrategy revceived message %{public}u, action: %{public}s",
+    STANDBYSERVICE_LOGD("WorkSchedulerStrategy revceived message %{public}u, action: %{public}s",
         message.eventId_, message.action_.c_str());
+    switch (message.eventId_) {
+        case StandbyMessageType::STATE_TRANSIT:
+            HandleStateTransit(message);
+            break;
+        case StandbyMessageType::BG_TASK_STATUS_CHANGE:
+            HandleWorkStatusChanged(message);
+            break;
+        default:
+            break;
+    }
 }
 
 ErrCode WorkSchedulerStrategy::OnCreated()
 {
+    maxConcurrency_ = StandbyConfigManager::GetInstance()->GetStandbyParam(WORK_MAX_CONCURRENCY);
+    if (maxConcurrency_ <= 0) {
+        maxConcurrency_ = DEFAULT_WORK_MAX_CONCURRENCY;
+    }
     return ERR_OK;
 }
 
 ErrCode WorkSchedulerStrategy::OnDestroy()
 {
+    RemoveReleaseTask();
+    if (isDeferring_) {
+        ReleaseAllDeferredWorks();
+    }
+    releasedWorks_.clear();
+    isDeferring_ = false;
+    isIdleMaintence_ = false;
+    return ERR_OK;
+}
+
+ErrCode WorkSchedulerStrategy::HandleStateTransit(const StandbyMessage& message)
+{
+    if (!message.want_.has_value()) {
+        return ERR_STANDBY_OBJECT_NULL;
+    }
+    uint32_t preState = static_cast<uint32_t>(message.want_->GetIntParam(PREVIOUS_STATE, 0));
+    uint32_t curState = static_cast<uint32_t>(message.want_->GetIntParam(CURRENT_STATE, 0));
+    if (curState == StandbyState::SLEEP) {
+        if (isIdleMaintence_) {
+            // exit maintenance, released works which are still running are deferred again
+            RemoveReleaseTask();
+            RecordBatchSize();
+            releasedWorks_.clear();
+            isIdleMaintence_ = false;
+        }
+        isDeferring_ = true;
+        DeferRunningWorks();
+    } else if (curState == StandbyState::MAINTENANCE && preState == StandbyState::SLEEP) {
+        if (!isDeferring_) {
+            return ERR_STANDBY_CURRENT_STATE_NOT_MATCH;
+        }
+        isIdleMaintence_ = true;
+        ReleaseDeferredWorks();
+    } else if (isDeferring_) {
+        RemoveReleaseTask();
+        RecordBatchSize();
+        ReleaseAllDeferredWorks();
+        releasedWorks_.clear();
+        isDeferring_ = false;
+        isIdleMaintence_ = false;
+    }
+    return ERR_OK;
+}
+
+ErrCode WorkSchedulerStrategy::HandleWorkStatusChanged(const StandbyMessage& message)
+{
+    if (!isDeferring_) {
+        return ERR_STANDBY_CURRENT_STATE_NOT_MATCH;
+    }
+    if (!message.want_.has_value() || message.want_->GetStringParam(BG_TASK_TYPE) != WORK_SCHEDULER) {
+        return ERR_STANDBY_KEY_INFO_NOT_MATCH;
+    }
+    bool started = message.want_->GetBoolParam(BG_TASK_STATUS, false);
+    int32_t uid = message.want_->GetIntParam(BG_TASK_UID, -1);
+    if (isIdleMaintence_) {
+        // finished work leaves its slot to the next deferred work
+        if (!started && releasedWorks_.erase(uid) > 0) {
+            ReleaseDeferredWorks();
+        }
+        return ERR_OK;
+    }
+    AppStateInfo appState {};
+    if (!started || !AppStateCache::GetInstance()->GetAppState(uid, appState)) {
+        return ERR_OK;
+    }
+    std::set<std::string> allowNames {};
+    std::set<std::string> restrictNames {};
+    GetExemptionConfig(allowNames, restrictNames);
+    DeferWork(appState, allowNames, restrictNames);
     return ERR_OK;
 }
+
+void WorkSchedulerStrategy::DeferRunningWorks()
+{
+    std::vector<AppStateInfo> runningWorkApps {};
+    AppStateCache::GetInstance()->ForEachRunningApp([&runningWorkApps](const AppStateInfo& appState) {
+        if (appState.runningWorkCount_ > 0) {
+            runningWorkApps.emplace_back(appState);
+        }
+    });
+    if (runningWorkApps.empty()) {
+        return;
+    }
+    std::set<std::string> allowNames {};
+    std::set<std::string> restrictNames {};
+    GetExemptionConfig(allowNames, restrictNames);
+    for (const auto& appState : runningWorkApps) {
+        DeferWork(appState, allowNames, restrictNames);
+    }
+    STANDBYSERVICE_LOGI("running work app size is %{public}d, deferred size is %{public}d",
+        static_cast<int32_t>(runningWorkApps.size()), static_cast<int32_t>(deferredWorks_.size()));
+}
+
+bool WorkSchedulerStrategy::DeferWork(const AppStateInfo& appState, const std::set<std::string>& allowNames,
+    const std::set<std::string>& restrictNames)
+{
+    if (deferredWorks_.find(appState.uid_) != deferredWorks_.end()) {
+        return true;
+    }
+    if (allowNames.find(appState.bundleName_) != allowNames.end()) {
+        return false;
+    }
+    #ifdef STANDBY_RSS_WORK_SCHEDULER_ENABLE
+    if (WorkScheduler::WorkSchedulerSrvClient::GetInstance().PauseRunningWorks(appState.uid_) != ERR_OK) {
+        STANDBYSERVICE_LOGW("failed to pause works of uid %{public}d", appState.uid_);
+        return false;
+    }
+    #else
+    return false;
+    #endif
+    DeferredWorkInfo workInfo {appState.uid_, appState.bundleName_};
+    if (restrictNames.find(appState.bundleName_) != restrictNames.end()) {
+        workInfo.priority_ = DeferredWorkPriority::RESTRICTED_APP;
+    } else if (appState.isSystemApp_) {
+        workInfo.priority_ = DeferredWorkPriority::SYSTEM_APP;
+    }
+    workInfo.deferTime_ = MiscServices::TimeServiceClient::GetInstance()->GetMonotonicTimeMs();
+    deferredWorks_.emplace(appState.uid_, std::move(workInfo));
+    ++deferredCount_;
+    return true;
+}
+
+void WorkSchedulerStrategy::ReleaseDeferredWorks()
+{
+    int64_t curTime = MiscServices::TimeServiceClient::GetInstance()->GetMonotonicTimeMs();
+    for (auto iter = releasedWorks_.begin(); iter != releasedWorks_.end();) {
+        if (curTime - iter->second >= RELEASED_WORK_TIMEOUT) {
+            iter = releasedWorks_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    if (deferredWorks_.empty()) {
+        return;
+    }
+    std::vector<DeferredWorkInfo> pendingWorks {};
+    pendingWorks.reserve(deferredWorks_.size());
+    for (const auto& [uid, workInfo] : deferredWorks_) {
+        pendingWorks.emplace_back(workInfo);
+    }
+    std::sort(pendingWorks.begin(), pendingWorks.end(), [](const auto& lhs, const auto& rhs) {
+        return std::tie(lhs.priority_, lhs.deferTime_, lhs.uid_) < std::tie(rhs.priority_, rhs.deferTime_, rhs.uid_);
+    });
+    for (const auto& workInfo : pendingWorks) {
+        if (static_cast<int32_t>(releasedWorks_.size()) >= maxConcurrency_) {
+            break;
+        }
+        ResumeWork(workInfo, curTime);
+        releasedWorks_.emplace(workInfo.uid_, curTime);
+        deferredWorks_.erase(workInfo.uid_);
+    }
+    STANDBYSERVICE_LOGI("release deferred works, running: %{public}d, remaining: %{public}d",
+        static_cast<int32_t>(releasedWorks_.size()), static_cast<int32_t>(deferredWorks_.size()));
+    if (!deferredWorks_.empty()) {
+        PostReleaseTask();
+    }
+}
+
+void WorkSchedulerStrategy::ReleaseAllDeferredWorks()
+{
+    int64_t curTime = MiscServices::TimeServiceClient::GetInstance()->GetMonotonicTimeMs();
+    for (const auto& [uid, workInfo] : deferredWorks_) {
+        ResumeWork(workInfo, curTime);
+    }
+    deferredWorks_.clear();
+    RecordBatchSize();
+}
+
+void WorkSchedulerStrategy::ResumeWork(const DeferredWorkInfo& workInfo, int64_t curTime)
+{
+    #ifdef STANDBY_RSS_WORK_SCHEDULER_ENABLE
+    if (WorkScheduler::WorkSchedulerSrvClient::GetInstance().ResumePausedWorks(workInfo.uid_) != ERR_OK) {
+        STANDBYSERVICE_LOGW("failed to resume works of uid %{public}d", workInfo.uid_);
+    }
+    #endif
+    int64_t deferLatency = curTime - workInfo.deferTime_;
+    totalDeferLatency_ += deferLatency;
+    maxDeferLatency_ = std::max(maxDeferLatency_, deferLatency);
+    ++releasedCount_;
+    ++curBatchSize_;
+}
+
+void WorkSchedulerStrategy::PostReleaseTask()
+{
+    auto handler = StandbyServiceImpl::GetInstance()->GetHandler();
+    if (handler == nullptr) {
+        return;
+    }
+    handler->RemoveTask(RELEASE_DEFERRED_WORK_TASK);
+    handler->PostTask([this]() {
+        if (isIdleMaintence_) {
+            ReleaseDeferredWorks();
+        }
+        }, RELEASE_DEFERRED_WORK_TASK, RELEASE_DEFERRED_WORK_INTERVAL);
+}
+
+void WorkSchedulerStrategy::RemoveReleaseTask()
+{
+    if (auto handler = StandbyServiceImpl::GetInstance()->GetHandler(); handler != nullptr) {
+        handler->RemoveTask(RELEASE_DEFERRED_WORK_TASK);
+    }
+}
+
+void WorkSchedulerStrategy::RecordBatchSize()
+{
+    if (curBatchSize_ == 0) {
+        return;
+    }
+    recentBatchSizes_.emplace_back(curBatchSize_);
+    if (recentBatchSizes_.size() > MAX_RECENT_BATCH_NUM) {
+        recentBatchSizes_.pop_front();
+    }
+    curBatchSize_ = 0;
+}
+
+void WorkSchedulerStrategy::GetExemptionConfig(std::set<std::string>& allowNames,
+    std::set<std::string>& restrictNames)
+{
+    std::vector<AllowInfo> allowInfoList {};
+    StandbyServiceImpl::GetInstance()->GetAllowListInner(AllowType::WORK_SCHEDULER, allowInfoList,
+        ReasonCodeEnum::REASON_APP_API);
+    for (const auto& info : allowInfoList) {
+        allowNames.emplace(info.GetName());
+    }
+    StandbyServiceImpl::GetInstance()->GetEligiableRestrictSet(AllowType::WORK_SCHEDULER, "WORK_SCHEDULER",
+        ReasonCodeEnum::REASON_APP_API, restrictNames);
+}
+
+void WorkSchedulerStrategy::ShellDump(const std::vector<std::string>& argsInStr, std::string& result)
+{
+    if (argsInStr[DUMP_FIRST_PARAM] == DUMP_DETAIL_INFO &&
+        argsInStr[DUMP_SECOND_PARAM] == DUMP_STRATGY_DETAIL) {
+        DumpShowDetailInfo(argsInStr, result);
+    }
+}
+
+void WorkSchedulerStrategy::DumpShowDetailInfo(const std::vector<std::string>& argsInStr, std::string& result)
+{
+    result.append("=================WorkScheduler====================\n");
+    result.append("Work Scheduler Strategy:\n").append("isDeferring: " + std::to_string(isDeferring_))
+        .append(" isIdleMaintence: " + std::to_string(isIdleMaintence_))
+        .append(" max concurrency: " + std::to_string(maxConcurrency_)).append("\n");
+    result.append("deferred count: ").append(std::to_string(deferredCount_))
+        .append(" released count: ").append(std::to_string(releasedCount_))
+        .append(" avg defer latency(ms): ").append(std::to_string(releasedCount_ == 0 ? 0 :
+            totalDeferLatency_ / static_cast<int64_t>(releasedCount_)))
+        .append(" max defer latency(ms): ").append(std::to_string(maxDeferLatency_)).append("\n");
+    result.append("recent batch sizes:");
+    for (const auto batchSize : recentBatchSizes_) {
+        result.append(" ").append(std::to_string(batchSize));
+    }
+    result.append("\n").append("deferred works: \n");
+    for (const auto& [uid, workInfo] : deferredWorks_) {
+        result.append("uid: ").append(std::to_string(uid)).append(" name: ").append(workInfo.name_)
+            .append(" priority: ").append(std::to_string(workInfo.priority_)).append("\n");
+    }
+}
 }  // namespace DevStandbyMgr
-}  // namespace OHOS
\ No newline at end of file
+}  // namespace OHOS
@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * offline evaluation of motion detectors on recorded accelerometer traces, run on the host.
+ *
+ * usage: motion_detector_eval [-w window_ms] [-r rest_ms] [-i interval_ms] [-n repeat_times]
+ *     [-e energy_threshold] [-v variance_threshold] [-j jerk_threshold] trace.csv...
+ *
+ * every line of a trace holds one sample: timestamp in ms, x, y and z in m/s^2, and 1 if the device moves at
+ * that time, otherwise 0. lines starting with # are skipped. thresholds are given as in detect_list of
+ * device_standby_config.json.
+ *
+ * samples are cut into detection windows separated by rest time, as MotionSensorMonitor does. every detector runs
+ * over every trace in its own thread, the report gives per trace and detector:
+ *   false positives: windows detected without moving samples in them.
+ *   missed windows: windows with moving samples that are not detected.
+ *   latency: time from the start of a moving period to its first detection, averaged over detected periods.
+ *   cost: time spent batching samples and in the detector per sample.
+ */
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "motion_detector.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+namespace {
+// as MotionSensorMonitor of nap state, see MOTION_DETECTION_TIMEOUT, REST_TIMEOUT and SENSOR_SAMPLING_RATE
+constexpr int64_t DEFAULT_WINDOW_TIME = 1500;
+constexpr int64_t DEFAULT_REST_TIME = 1000;
+constexpr int64_t DEFAULT_SAMPLING_INTERVAL = 200;
+constexpr size_t ACCEL_BATCH_SIZE = 5;
+constexpr int32_t DEFAULT_REPEAT_TIMES = 20;
+// defaults of detect_list, variance and jerk thresholds are in thousandths
+constexpr int32_t DEFAULT_ENERGY_THRESHOLD = 1;
+constexpr int32_t DEFAULT_VARIANCE_THRESHOLD = 50;
+constexpr int32_t DEFAULT_JERK_THRESHOLD = 3000;
+constexpr double MOTION_THRESHOLD_SCALE = 1000;
+constexpr int64_t NS_PER_MS = 1000000;
+
+struct Sample {
+    int64_t time_ {0};
+    MotionVector accel_ {};
+    bool isMoving_ {false};
+};
+
+struct Trace {
+    std::string name_ {};
+    std::vector<Sample> samples_ {};
+};
+
+struct EvalOption {
+    int64_t windowTime_ {DEFAULT_WINDOW_TIME};
+    int64_t restTime_ {DEFAULT_REST_TIME};
+    int64_t samplingInterval_ {DEFAULT_SAMPLING_INTERVAL};
+    int32_t repeatTimes_ {DEFAULT_REPEAT_TIMES};
+    double thresholds_[static_cast<size_t>(MotionDetectorType::END)] {DEFAULT_ENERGY_THRESHOLD,
+        DEFAULT_VARIANCE_THRESHOLD / MOTION_THRESHOLD_SCALE, DEFAULT_JERK_THRESHOLD / MOTION_THRESHOLD_SCALE, 0};
+};
+
+struct WindowResult {
+    bool isMoving_ {false};
+    // -1 if motion is not detected
+    int64_t detectionTime_ {-1};
+};
+
+struct EvalResult {
+    std::string detectorName_ {};
+    size_t windowNum_ {0};
+    size_t movingWindowNum_ {0};
+    size_t falsePositiveNum_ {0};
+    size_t missedWindowNum_ {0};
+    size_t movingPeriodNum_ {0};
+    size_t detectedPeriodNum_ {0};
+    double totalLatency_ {0};
+    double costPerSample_ {0};
+};
+
+bool ReadTrace(const std::string& path, Trace& trace)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+    trace.name_ = path.substr(path.find_last_of('/') + 1);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        long long time = 0;
+        int32_t isMoving = 0;
+        Sample sample {};
+        if (sscanf(line.c_str(), "%lld,%f,%f,%f,%d", &time, &sample.accel_.x_, &sample.accel_.y_,
+            &sample.accel_.z_, &isMoving) != 5) {
+            fprintf(stderr, "skip malformed line in %s: %s\n", path.c_str(), line.c_str());
+            continue;
+        }
+        sample.time_ = time;
+        sample.isMoving_ = isMoving != 0;
+        trace.samples_.emplace_back(sample);
+    }
+    return !trace.samples_.empty();
+}
+
+// run the detector once over the windows of the trace
+std::vector<WindowResult> RunWindows(IMotionDetector& detector, double threshold, const Trace& trace,
+    const EvalOption& option)
+{
+    const auto& samples = trace.samples_;
+    std::vector<WindowResult> windows {};
+    AccelSampleBatch batch {ACCEL_BATCH_SIZE};
+    size_t index = 0;
+    int64_t windowStart = samples.front().time_;
+    while (index < samples.size()) {
+        while (index < samples.size() && samples[index].time_ < windowStart) {
+            ++index;
+        }
+        if (index >= samples.size()) {
+            break;
+        }
+        int64_t windowEnd = windowStart + option.windowTime_;
+        detector.Reset(threshold, false);
+        MotionVector previous = samples[index].accel_;
+        bool isMoving = false;
+        int64_t detectionTime = -1;
+        for (; index < samples.size() && samples[index].time_ < windowEnd; ++index) {
+            isMoving = isMoving || samples[index].isMoving_;
+            batch.Add(samples[index].accel_.x_, samples[index].accel_.y_, samples[index].accel_.z_);
+            if (!batch.Full()) {
+                continue;
+            }
+            detector.AddSamples(batch, previous);
+            previous = batch.GetLast();
+            batch.Clear();
+            if (detectionTime < 0 && detector.IsMotionDetected()) {
+                detectionTime = samples[index].time_;
+            }
+        }
+        // samples left in the batch are flushed when the window ends
+        if (!batch.Empty()) {
+            detector.AddSamples(batch, previous);
+            batch.Clear();
+            if (detectionTime < 0 && detector.IsMotionDetected()) {
+                detectionTime = windowEnd;
+            }
+        }
+        windows.emplace_back(WindowResult {isMoving, detectionTime});
+        windowStart = windowEnd + option.restTime_;
+    }
+    return windows;
+}
+
+// a moving period is detected if motion is detected after its start, until the window after its end is flushed
+void CountLatency(const Trace& trace, const std::vector<WindowResult>& windows, const EvalOption& option,
+    EvalResult& result)
+{
+    std::vector<int64_t> detections {};
+    for (const auto& window : windows) {
+        if (window.detectionTime_ >= 0) {
+            detections.emplace_back(window.detectionTime_);
+        }
+    }
+    const auto& samples = trace.samples_;
+    for (size_t index = 0; index < samples.size(); ++index) {
+        if (!samples[index].isMoving_ || (index > 0 && samples[index - 1].isMoving_)) {
+            continue;
+        }
+        int64_t periodStart = samples[index].time_;
+        size_t endIndex = index;
+        while (endIndex + 1 < samples.size() && samples[endIndex + 1].isMoving_) {
+            ++endIndex;
+        }
+        ++result.movingPeriodNum_;
+        auto iter = std::lower_bound(detections.begin(), detections.end(), periodStart);
+        if (iter != detections.end() && *iter <= samples[endIndex].time_ + option.windowTime_) {
+            ++result.detectedPeriodNum_;
+            result.totalLatency_ += static_cast<double>(*iter - periodStart);
+        }
+    }
+}
+
+EvalResult Evaluate(MotionDetectorType type, const Trace& trace, const EvalOption& option)
+{
+    EvalResult result {};
+    auto detector = CreateMotionDetector(type, option.samplingInterval_ * NS_PER_MS);
+    double threshold = option.thresholds_[static_cast<size_t>(type)];
+    result.detectorName_ = detector->GetName();
+
+    auto windows = RunWindows(*detector, threshold, trace, option);
+    result.windowNum_ = windows.size();
+    for (const auto& window : windows) {
+        bool isDetected = window.detectionTime_ >= 0;
+        result.movingWindowNum_ += window.isMoving_ ? 1 : 0;
+        result.falsePositiveNum_ += !window.isMoving_ && isDetected ? 1 : 0;
+        result.missedWindowNum_ += window.isMoving_ && !isDetected ? 1 : 0;
+    }
+    CountLatency(trace, windows, option, result);
+
+    auto startTime = std::chrono::steady_clock::now();
+    for (int32_t round = 0; round < option.repeatTimes_; ++round) {
+        RunWindows(*detector, threshold, trace, option);
+    }
+    double cost = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+    result.costPerSample_ = cost / (static_cast<double>(option.repeatTimes_) * trace.samples_.size());
+    return result;
+}
+
+bool ParseOption(int argc, char* argv[], EvalOption& option)
+{
+    int32_t opt = 0;
+    while ((opt = getopt(argc, argv, "w:r:i:n:e:v:j:")) != -1) {
+        switch (opt) {
+            case 'w':
+                option.windowTime_ = atoll(optarg);
+                break;
+            case 'r':
+                option.restTime_ = atoll(optarg);
+                break;
+            case 'i':
+                option.samplingInterval_ = atoll(optarg);
+                break;
+            case 'n':
+                option.repeatTimes_ = std::max(atoi(optarg), 1);
+                break;
+            case 'e':
+                option.thresholds_[static_cast<size_t>(MotionDetectorType::ENERGY)] = atoi(optarg);
+                break;
+            case 'v':
+                option.thresholds_[static_cast<size_t>(MotionDetectorType::VARIANCE)] =
+                    atoi(optarg) / MOTION_THRESHOLD_SCALE;
+                break;
+            case 'j':
+                option.thresholds_[static_cast<size_t>(MotionDetectorType::JERK)] =
+                    atoi(optarg) / MOTION_THRESHOLD_SCALE;
+                break;
+            default:
+                return false;
+        }
+    }
+    return optind < argc && option.windowTime_ > 0 && option.restTime_ >= 0;
+}
+
+int32_t Run(int argc, char* argv[])
+{
+    EvalOption option {};
+    if (!ParseOption(argc, argv, option)) {
+        fprintf(stderr, "usage: %s [-w window_ms] [-r rest_ms] [-i interval_ms] [-n repeat_times] "
+            "[-e energy_threshold] [-v variance_threshold] [-j jerk_threshold] trace.csv...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    std::vector<Trace> traces {};
+    for (int32_t index = optind; index < argc; ++index) {
+        Trace trace {};
+        if (!ReadTrace(argv[index], trace)) {
+            fprintf(stderr, "failed to read samples from %s\n", argv[index]);
+            return EXIT_FAILURE;
+        }
+        traces.emplace_back(std::move(trace));
+    }
+
+    constexpr size_t detectorNum = static_cast<size_t>(MotionDetectorType::END);
+    std::vector<EvalResult> results(traces.size() * detectorNum);
+    std::vector<std::thread> workers {};
+    for (size_t traceIndex = 0; traceIndex < traces.size(); ++traceIndex) {
+        for (size_t type = 0; type < detectorNum; ++type) {
+            workers.emplace_back([&results, &traces, &option, traceIndex, type]() {
+                results[traceIndex * detectorNum + type] =
+                    Evaluate(static_cast<MotionDetectorType>(type), traces[traceIndex], option);
+            });
+        }
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    printf("%-24s %-20s %8s %8s %10s %8s %10s %12s %12s\n", "trace", "detector", "windows", "moving",
+        "false_pos", "missed", "periods", "latency_ms", "ns/sample");
+    for (size_t index = 0; index < results.size(); ++index) {
+        const auto& result = results[index];
+        std::string periods = std::to_string(result.detectedPeriodNum_) + "/" +
+            std::to_string(result.movingPeriodNum_);
+        double latency = result.detectedPeriodNum_ > 0 ? result.totalLatency_ / result.detectedPeriodNum_ : -1;
+        printf("%-24s %-20s %8zu %8zu %10zu %8zu %10s %12.1f %12.2f\n", traces[index / detectorNum].name_.c_str(),
+            result.detectorName_.c_str(), result.windowNum_, result.movingWindowNum_, result.falsePositiveNum_,
+            result.missedWindowNum_, periods.c_str(), latency, result.costPerSample_);
+    }
+    return EXIT_SUCCESS;
+}
+}
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
+
+int main(int argc, char* argv[])
+{
+    return OHOS::DevStandbyMgr::Run(argc, argv);
+}
@@ -77,5 +77,32 @@ HWTEST_F(ChargeStateMonitorTest, StopMonitoring, TestSize.Level1)
     std::shared_ptr<IConstraintMonitor> chargeMonitor = std::make_shared<ChargeStateMonitor>();
     chargeMonitor->StopMonitoring();
 }
+
+/**
+ * @tc.name: StartMonitoringWithChargeState
+ * @tc.desc: test the evaluation reads the cached charge state.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(ChargeStateMonitorTest, StartMonitoringWithChargeState, TestSize.Level1)
+{
+    auto originConstraintManager = StandbyServiceImpl::GetInstance()->constraintManager_;
+    auto constraintManager = std::make_shared<ConstraintManagerAdapter>();
+    StandbyServiceImpl::GetInstance()->constraintManager_ = constraintManager;
+    std::shared_ptr<IConstraintMonitor> chargeMonitor = std::make_shared<ChargeStateMonitor>();
+    ConstraintEvalParam params{StandbyState::WORKING, 0, StandbyState::DARK, 0};
+    constraintManager->RegisterConstraintCallback(params, chargeMonitor);
+
+    DeviceStateCache::GetInstance()->SetChargeState(true);
+    constraintManager->StartEvalution(params);
+    EXPECT_FALSE(constraintManager->isEvaluation_);
+    EXPECT_FALSE(constraintManager->lastEvalResult_);
+
+    DeviceStateCache::GetInstance()->SetChargeState(false);
+    constraintManager->StartEvalution(params);
+    EXPECT_TRUE(constraintManager->lastEvalResult_);
+    DeviceStateCache::GetInstance()->chargeState_ = ChargeState::UNKNOWN;
+    StandbyServiceImpl::GetInstance()->constraintManager_ = originConstraintManager;
+}
 }  // namespace DevStandbyMgr
 }  // namespace OHOS
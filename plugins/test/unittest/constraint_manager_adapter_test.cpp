@@ -18,11 +18,35 @@
 #include "constraint_manager_adapter.h"
 #include "state_manager_adapter.h"
 #include "standby_service_impl.h"
+#include "virtual_clock.h"
 
 using namespace testing::ext;
 
 namespace OHOS {
 namespace DevStandbyMgr {
+namespace {
+class MockConstraintMonitor : public IConstraintMonitor {
+public:
+    bool Init() override
+    {
+        return true;
+    }
+
+    void StartMonitoring() override
+    {
+        ++startCount_;
+    }
+
+    void StopMonitoring() override
+    {
+        ++stopCount_;
+    }
+
+    int32_t startCount_ {0};
+    int32_t stopCount_ {0};
+};
+}
+
 class ConstraintManagerAdapterTest : public testing::Test {
 public:
     static void SetUpTestCase();
@@ -111,9 +135,9 @@ HWTEST_F(ConstraintManagerAdapterTest, StartEvalution003, TestSize.Level1)
     constraintManagerAdapter->isEvaluation_ = false;
     std::shared_ptr<ChargeStateMonitor> monitor = nullptr;
     constraintManagerAdapter->RegisterConstraintCallback(params, monitor);
-    EXPECT_EQ(constraintManagerAdapter->constraintMap_.size(), 1);
+    EXPECT_EQ(constraintManagerAdapter->constraintMap_.size(), 0);
     ErrCode ret = constraintManagerAdapter->StartEvalution(params);
-    EXPECT_EQ(ret, ERR_OK);
+    EXPECT_EQ(ret, ERR_STATE_MANAGER_IS_NULLPTR);
 }
 
 /**
@@ -155,7 +179,7 @@ HWTEST_F(ConstraintManagerAdapterTest, StopEvalution002, TestSize.Level1)
 {
     std::shared_ptr<ConstraintManagerAdapter> constraintManagerAdapter = std::make_shared<ConstraintManagerAdapter>();
     constraintManagerAdapter->isEvaluation_ = true;
-    constraintManagerAdapter->curMonitor_ = nullptr;
+    constraintManagerAdapter->curMonitors_.clear();
     constraintManagerAdapter->StopEvalution();
 }
 
@@ -169,7 +193,7 @@ HWTEST_F(ConstraintManagerAdapterTest, StopEvalution003, TestSize.Level1)
 {
     std::shared_ptr<ConstraintManagerAdapter> constraintManagerAdapter = std::make_shared<ConstraintManagerAdapter>();
     constraintManagerAdapter->isEvaluation_ = true;
-    constraintManagerAdapter->curMonitor_ = std::make_shared<ChargeStateMonitor>();
+    constraintManagerAdapter->curMonitors_ = {ConstraintMonitorEntry {std::make_shared<ChargeStateMonitor>(), 0}};
     constraintManagerAdapter->StopEvalution();
 }
 
@@ -187,6 +211,107 @@ HWTEST_F(ConstraintManagerAdapterTest, RegisterConstraintCallback, TestSize.Leve
     constraintManagerAdapter->RegisterConstraintCallback(params, monitor);
 }
 
+/**
+ * @tc.name: CompositeEvalutionAllPass
+ * @tc.desc: test monitors of a transition run together, and all pass ends at the first failure.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(ConstraintManagerAdapterTest, CompositeEvalutionAllPass, TestSize.Level1)
+{
+    constexpr int64_t elapsedTime = 30;
+    auto clock = std::make_shared<VirtualClock>(0);
+    StandbyClock::SetInstance(clock);
+    auto constraintManagerAdapter = std::make_shared<ConstraintManagerAdapter>();
+    ConstraintEvalParam params;
+    auto firstMonitor = std::make_shared<MockConstraintMonitor>();
+    auto secondMonitor = std::make_shared<MockConstraintMonitor>();
+    auto thirdMonitor = std::make_shared<MockConstraintMonitor>();
+    constraintManagerAdapter->RegisterConstraintCallback(params, firstMonitor);
+    constraintManagerAdapter->RegisterConstraintCallback(params, secondMonitor);
+    constraintManagerAdapter->RegisterConstraintCallback(params, thirdMonitor);
+    EXPECT_EQ(constraintManagerAdapter->StartEvalution(params), ERR_OK);
+    EXPECT_EQ(firstMonitor->startCount_ + secondMonitor->startCount_ + thirdMonitor->startCount_, 3);
+
+    constraintManagerAdapter->EndEvalConstraint(firstMonitor, true);
+    EXPECT_TRUE(constraintManagerAdapter->isEvaluation_);
+    EXPECT_EQ(firstMonitor->stopCount_, 1);
+    clock->AdvanceBy(elapsedTime);
+    constraintManagerAdapter->EndEvalConstraint(secondMonitor, false);
+    EXPECT_FALSE(constraintManagerAdapter->isEvaluation_);
+    EXPECT_FALSE(constraintManagerAdapter->lastEvalResult_);
+    EXPECT_EQ(constraintManagerAdapter->lastEvalDuration_, elapsedTime);
+    EXPECT_EQ(thirdMonitor->stopCount_, 1);
+
+    // results after the evaluation has ended are ignored
+    constraintManagerAdapter->EndEvalConstraint(thirdMonitor, true);
+    EXPECT_EQ(thirdMonitor->stopCount_, 1);
+    EXPECT_FALSE(constraintManagerAdapter->lastEvalResult_);
+    StandbyClock::SetInstance(nullptr);
+}
+
+/**
+ * @tc.name: CompositeEvalutionAnyPass
+ * @tc.desc: test any pass ends at the first pass, and fails when every monitor fails.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(ConstraintManagerAdapterTest, CompositeEvalutionAnyPass, TestSize.Level1)
+{
+    auto constraintManagerAdapter = std::make_shared<ConstraintManagerAdapter>();
+    ConstraintEvalParam params;
+    auto firstMonitor = std::make_shared<MockConstraintMonitor>();
+    auto secondMonitor = std::make_shared<MockConstraintMonitor>();
+    constraintManagerAdapter->RegisterConstraintCallback(params, firstMonitor);
+    constraintManagerAdapter->RegisterConstraintCallback(params, secondMonitor);
+    constraintManagerAdapter->SetConstraintCombination(params, ConstraintCombination::ANY_PASS);
+
+    constraintManagerAdapter->StartEvalution(params);
+    constraintManagerAdapter->EndEvalConstraint(firstMonitor, false);
+    EXPECT_TRUE(constraintManagerAdapter->isEvaluation_);
+    constraintManagerAdapter->EndEvalConstraint(secondMonitor, false);
+    EXPECT_FALSE(constraintManagerAdapter->isEvaluation_);
+    EXPECT_FALSE(constraintManagerAdapter->lastEvalResult_);
+
+    constraintManagerAdapter->StartEvalution(params);
+    constraintManagerAdapter->EndEvalConstraint(secondMonitor, true);
+    EXPECT_FALSE(constraintManagerAdapter->isEvaluation_);
+    EXPECT_TRUE(constraintManagerAdapter->lastEvalResult_);
+    EXPECT_EQ(firstMonitor->stopCount_, 2);
+    EXPECT_EQ(secondMonitor->stopCount_, 2);
+}
+
+/**
+ * @tc.name: CompositeEvalutionTimeout
+ * @tc.desc: test a monitor fails when it has not ended before its timeout.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(ConstraintManagerAdapterTest, CompositeEvalutionTimeout, TestSize.Level1)
+{
+    constexpr int64_t timeout = 100;
+    auto clock = std::make_shared<VirtualClock>(0);
+    StandbyClock::SetInstance(clock);
+    auto constraintManagerAdapter = std::make_shared<ConstraintManagerAdapter>();
+    ConstraintEvalParam params;
+    auto firstMonitor = std::make_shared<MockConstraintMonitor>();
+    auto secondMonitor = std::make_shared<MockConstraintMonitor>();
+    constraintManagerAdapter->RegisterConstraintCallback(params, firstMonitor, timeout);
+    constraintManagerAdapter->RegisterConstraintCallback(params, secondMonitor, timeout * 2);
+
+    constraintManagerAdapter->StartEvalution(params);
+    EXPECT_EQ(clock->GetPendingCount(), 2);
+    constraintManagerAdapter->EndEvalConstraint(firstMonitor, true);
+    EXPECT_EQ(clock->GetPendingCount(), 1);
+    clock->AdvanceBy(timeout * 2);
+    EXPECT_FALSE(constraintManagerAdapter->isEvaluation_);
+    EXPECT_FALSE(constraintManagerAdapter->lastEvalResult_);
+    EXPECT_EQ(constraintManagerAdapter->lastEvalDuration_, timeout * 2);
+    EXPECT_EQ(secondMonitor->stopCount_, 1);
+    EXPECT_EQ(clock->GetPendingCount(), 0);
+    StandbyClock::SetInstance(nullptr);
+}
+
 /**
  * @tc.name: ShellDump
  * @tc.desc: test StopMonitoring.
@@ -199,6 +324,9 @@ HWTEST_F(ConstraintManagerAdapterTest, ShellDump, TestSize.Level1)
     std::vector<std::string> argsInStr;
     string result;
     constraintManagerAdapter->ShellDump(argsInStr, result);
+    argsInStr = {DUMP_DETAIL_INFO};
+    constraintManagerAdapter->ShellDump(argsInStr, result);
+    EXPECT_FALSE(result.empty());
 }
 }  // namespace DevStandbyMgr
 }  // namespace OHOS
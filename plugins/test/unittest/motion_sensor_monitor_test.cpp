@@ -13,7 +13,16 @@
  * limitations under the License.
  */
 
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
+#include "motion_detector.h"
+#include "motion_energy.h"
 #include "motion_sensor_monitor.h"
 #include "common_constant.h"
 #include "state_manager_adapter.h"
@@ -21,11 +30,54 @@
 #include "standby_config_manager.h"
 #include "standby_service_impl.h"
 #include "dark_state.h"
+#include "virtual_clock.h"
 
 using namespace testing::ext;
 
 namespace OHOS {
 namespace DevStandbyMgr {
+namespace {
+    constexpr size_t TRACE_SAMPLE_NUM = 1003;
+
+    // synthetic accelerometer trace at 5 Hz, a device at rest with noise, picked up every fourth 10 seconds
+    std::vector<AccelData> MakeAccelTrace(size_t sampleNum)
+    {
+        constexpr uint32_t multiplier = 1103515245;
+        constexpr uint32_t increment = 12345;
+        constexpr uint32_t noiseShift = 16;
+        constexpr uint32_t noiseRange = 100;
+        constexpr float noiseScale = 0.001f;
+        constexpr size_t segmentLength = 50;
+        constexpr size_t segmentNum = 4;
+        constexpr float motionFrequency = 0.7f;
+        constexpr float motionAmplitude = 2.0f;
+        constexpr float gravity = 9.8f;
+        std::vector<AccelData> trace {};
+        uint32_t seed = 1;
+        for (size_t index = 0; index < sampleNum; ++index) {
+            seed = seed * multiplier + increment;
+            float noise = static_cast<float>((seed >> noiseShift) % noiseRange) * noiseScale;
+            bool isMoving = (index / segmentLength) % segmentNum == segmentNum - 1;
+            float motion = isMoving ? std::sin(index * motionFrequency) * motionAmplitude : 0.0f;
+            trace.emplace_back(AccelData {noise + motion, noise - motion, gravity + noise});
+        }
+        return trace;
+    }
+
+    // energy computed sample by sample, as the callback did before samples were batched
+    double GetReferenceEnergy(const std::vector<AccelData>& trace)
+    {
+        double energy = 0;
+        for (size_t index = 1; index < trace.size(); ++index) {
+            float diffX = trace[index].x - trace[index - 1].x;
+            float diffY = trace[index].y - trace[index - 1].y;
+            float diffZ = trace[index].z - trace[index - 1].z;
+            energy += (diffX * diffX) + (diffY * diffY) + (diffZ * diffZ);
+        }
+        return energy;
+    }
+}
+
 class MotionSensorMonitorTest : public testing::Test {
 public:
     static void SetUpTestCase();
@@ -76,7 +128,8 @@ HWTEST_F(MotionSensorMonitorTest, AcceleromterCallback, TestSize.Level1)
     GravityData data = { 0, 0, 0 };
     event.sensorTypeId = SENSOR_TYPE_ID_NONE;
     event.data = reinterpret_cast<uint8_t *>(&data);
-    repeatedMotionConstraint->energy_ = 10000;
+    event.dataLen = sizeof(data);
+    repeatedMotionConstraint->score_ = 10000;
     repeatedMotionConstraint->AcceleromterCallback(&event);
     repeatedMotionConstraint->AcceleromterCallback(nullptr);
 }
@@ -97,8 +150,9 @@ HWTEST_F(MotionSensorMonitorTest, RepeatAcceleromterCallback, TestSize.Level1)
     GravityData data = { 0, 0, 0 };
     event.sensorTypeId = SENSOR_TYPE_ID_NONE;
     event.data = reinterpret_cast<uint8_t *>(&data);
+    event.dataLen = sizeof(data);
     repeatedMotionConstraint->RepeatAcceleromterCallback(&event);
-    repeatedMotionConstraint->energy_ = 10000;
+    repeatedMotionConstraint->score_ = 10000;
     repeatedMotionConstraint->RepeatAcceleromterCallback(&event);
     repeatedMotionConstraint->RepeatAcceleromterCallback(nullptr);
 }
@@ -119,19 +173,19 @@ HWTEST_F(MotionSensorMonitorTest, MotionSensorCallback, TestSize.Level1)
 }
 
 /**
- * @tc.name: SetEnergy
- * @tc.desc: test SetEnergy.
+ * @tc.name: SetScore
+ * @tc.desc: test SetScore.
  * @tc.type: FUNC
  * @tc.require:
  */
-HWTEST_F(MotionSensorMonitorTest, SetEnergy, TestSize.Level1)
+HWTEST_F(MotionSensorMonitorTest, SetScore, TestSize.Level1)
 {
     ConstraintEvalParam repeatedMotionParams{};
     auto repeatedMotionConstraint = std::make_shared<MotionSensorMonitor>(
         PERIODLY_TASK_DECTION_TIMEOUT, PERIODLY_TASK_REST_TIMEOUT, PERIODLY_TASK_TOTAL_TIMEOUT, repeatedMotionParams);
-    double energy = 10000;
-    repeatedMotionConstraint->SetEnergy(energy);
-    EXPECT_EQ(repeatedMotionConstraint->GetEnergy(), energy);
+    double score = 10000;
+    repeatedMotionConstraint->SetScore(score);
+    EXPECT_EQ(repeatedMotionConstraint->GetScore(), score);
 }
 
 /**
@@ -272,5 +326,263 @@ HWTEST_F(MotionSensorMonitorTest, StopSensor, TestSize.Level1)
     repeatedMotionConstraint->isMonitoring_ = true;
     repeatedMotionConstraint->StopSensor();
 }
+
+/**
+ * @tc.name: HandleAccelEvent
+ * @tc.desc: test samples of fifo events and single events are batched without changing the energy.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(MotionSensorMonitorTest, HandleAccelEvent, TestSize.Level1)
+{
+    constexpr size_t fifoSampleNum = 7;
+    constexpr double relativeError = 1e-5;
+    ConstraintEvalParam motionParams{};
+    auto motionConstraint = std::make_shared<MotionSensorMonitor>(
+        PERIODLY_TASK_DECTION_TIMEOUT, PERIODLY_TASK_REST_TIMEOUT, PERIODLY_TASK_TOTAL_TIMEOUT, motionParams);
+    auto trace = MakeAccelTrace(TRACE_SAMPLE_NUM);
+    motionConstraint->StopSensor();
+    motionConstraint->detector_->Reset(std::numeric_limits<double>::max(), false);
+    MotionSensorMonitor::activeMonitor_ = motionConstraint.get();
+    motionConstraint->isAccepting_ = true;
+
+    SensorEvent event {};
+    event.sensorTypeId = SENSOR_TYPE_ID_ACCELEROMETER;
+    event.data = reinterpret_cast<uint8_t *>(trace.data());
+    event.dataLen = sizeof(AccelData) * fifoSampleNum;
+    motionConstraint->AcceleromterCallback(&event);
+    for (size_t index = fifoSampleNum; index < trace.size(); ++index) {
+        event.data = reinterpret_cast<uint8_t *>(&trace[index]);
+        event.dataLen = sizeof(AccelData);
+        motionConstraint->RepeatAcceleromterCallback(&event);
+    }
+    // samples left in the batch are counted when the sensor stops
+    motionConstraint->isMonitoring_ = true;
+    motionConstraint->StopSensor();
+    motionConstraint->isMonitoring_ = false;
+    double referenceEnergy = GetReferenceEnergy(trace);
+    EXPECT_NEAR(motionConstraint->GetScore(), referenceEnergy, referenceEnergy * relativeError);
+    EXPECT_TRUE(motionConstraint->accelBatch_.Empty());
+    EXPECT_EQ(motionConstraint->GetDroppedSampleCount(), 0);
+}
+
+/**
+ * @tc.name: MotionDetectedLatch
+ * @tc.desc: test motion ends the evaluation once, and dropped and duplicate samples are counted.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(MotionSensorMonitorTest, MotionDetectedLatch, TestSize.Level1)
+{
+    constexpr int64_t sampleInterval = 200;
+    constexpr float motionAcceleration = 10.0f;
+    auto clock = std::make_shared<VirtualClock>(0);
+    StandbyClock::SetInstance(clock);
+    ConstraintEvalParam motionParams{};
+    auto motionConstraint = std::make_shared<MotionSensorMonitor>(
+        PERIODLY_TASK_DECTION_TIMEOUT, PERIODLY_TASK_REST_TIMEOUT, PERIODLY_TASK_TOTAL_TIMEOUT, motionParams);
+    MotionSensorMonitor::activeMonitor_ = motionConstraint.get();
+    AccelData data[] = {{0, 0, 0}, {motionAcceleration, 0, 0}};
+    SensorEvent event {};
+    event.sensorTypeId = SENSOR_TYPE_ID_ACCELEROMETER;
+    event.data = reinterpret_cast<uint8_t *>(data);
+    event.dataLen = sizeof(data);
+    event.timestamp = sampleInterval;
+    motionConstraint->AcceleromterCallback(&event);
+    EXPECT_EQ(motionConstraint->GetDroppedSampleCount(), 2);
+
+    motionConstraint->isAccepting_ = true;
+    motionConstraint->detector_->Reset(0, false);
+    for (size_t index = 0; index < AccelSampleBatch::CAPACITY; ++index) {
+        event.timestamp += sampleInterval;
+        motionConstraint->AcceleromterCallback(&event);
+    }
+    motionConstraint->MotionSensorCallback(&event);
+    EXPECT_EQ(clock->GetPendingCount(), 1);
+    EXPECT_EQ(motionConstraint->GetDroppedSampleCount(), 2 + 2 * (AccelSampleBatch::CAPACITY - 3));
+
+    motionConstraint->isMotionDetected_ = false;
+    event.timestamp = sampleInterval;
+    motionConstraint->AcceleromterCallback(&event);
+    EXPECT_EQ(motionConstraint->GetDuplicateSampleCount(), 2);
+    motionConstraint->PauseSampling();
+    StandbyClock::SetInstance(nullptr);
+}
+
+/**
+ * @tc.name: PauseSampling
+ * @tc.desc: test samples added on a sensor thread are all counted or dropped when sampling pauses meanwhile.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(MotionSensorMonitorTest, PauseSampling, TestSize.Level1)
+{
+    constexpr size_t roundNum = 100;
+    ConstraintEvalParam motionParams{};
+    auto motionConstraint = std::make_shared<MotionSensorMonitor>(
+        PERIODLY_TASK_DECTION_TIMEOUT, PERIODLY_TASK_REST_TIMEOUT, PERIODLY_TASK_TOTAL_TIMEOUT, motionParams);
+    motionConstraint->detector_->Reset(std::numeric_limits<double>::max(), false);
+    MotionSensorMonitor::activeMonitor_ = motionConstraint.get();
+    auto trace = MakeAccelTrace(TRACE_SAMPLE_NUM);
+    std::atomic<bool> isStopped {false};
+    std::thread sensorThread([&trace, &isStopped]() {
+        SensorEvent event {};
+        event.sensorTypeId = SENSOR_TYPE_ID_ACCELEROMETER;
+        event.dataLen = sizeof(AccelData);
+        size_t index = 0;
+        while (!isStopped.load()) {
+            event.data = reinterpret_cast<uint8_t *>(&trace[index]);
+            MotionSensorMonitor::AcceleromterCallback(&event);
+            index = (index + 1) % trace.size();
+        }
+    });
+    for (size_t round = 0; round < roundNum; ++round) {
+        motionConstraint->isAccepting_ = true;
+        std::this_thread::yield();
+        motionConstraint->PauseSampling();
+        motionConstraint->ProcessAccelBatch();
+        EXPECT_TRUE(motionConstraint->accelBatch_.Empty());
+    }
+    isStopped = true;
+    sensorThread.join();
+    MotionSensorMonitor::activeMonitor_ = nullptr;
+    EXPECT_FALSE(motionConstraint->isAccepting_);
+}
+
+/**
+ * @tc.name: CreateMotionDetector
+ * @tc.desc: test every type in detect_list creates its detector.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(MotionSensorMonitorTest, CreateMotionDetector, TestSize.Level1)
+{
+    for (int32_t type = 0; type < static_cast<int32_t>(MotionDetectorType::END); ++type) {
+        auto detector = CreateMotionDetector(static_cast<MotionDetectorType>(type), SENSOR_SAMPLING_RATE);
+        ASSERT_NE(detector, nullptr);
+        EXPECT_EQ(static_cast<int32_t>(detector->GetType()), type);
+        EXPECT_EQ(detector->UseAccelerometer(), detector->GetType() != MotionDetectorType::SIGNIFICANT_MOTION);
+    }
+    EXPECT_EQ(CreateMotionDetector(MotionDetectorType::END, SENSOR_SAMPLING_RATE), nullptr);
+}
+
+/**
+ * @tc.name: MotionDetectorScore
+ * @tc.desc: test accelerometer detectors find motion in the moving part of the trace only, with default thresholds.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(MotionSensorMonitorTest, MotionDetectorScore, TestSize.Level1)
+{
+    constexpr size_t windowLength = 50;
+    constexpr size_t restStart = 0;
+    constexpr size_t movingStart = 150;
+    const std::map<MotionDetectorType, double> thresholds = {
+        {MotionDetectorType::ENERGY, 1}, {MotionDetectorType::VARIANCE, 0.05}, {MotionDetectorType::JERK, 3}};
+    auto trace = MakeAccelTrace(TRACE_SAMPLE_NUM);
+    auto detectWindow = [&trace](IMotionDetector& detector, double threshold, size_t start) {
+        detector.Reset(threshold, false);
+        AccelSampleBatch batch {};
+        MotionVector previous {trace[start].x, trace[start].y, trace[start].z};
+        for (size_t index = start; index < start + windowLength; ++index) {
+            batch.Add(trace[index].x, trace[index].y, trace[index].z);
+            if (batch.Full()) {
+                detector.AddSamples(batch, previous);
+                previous = batch.GetLast();
+                batch.Clear();
+            }
+        }
+        detector.AddSamples(batch, previous);
+        return detector.IsMotionDetected();
+    };
+    for (const auto& [type, threshold] : thresholds) {
+        auto detector = CreateMotionDetector(type, SENSOR_SAMPLING_RATE);
+        EXPECT_FALSE(detectWindow(*detector, threshold, restStart)) << detector->GetName();
+        double restScore = detector->GetScore();
+        EXPECT_TRUE(detectWindow(*detector, threshold, movingStart)) << detector->GetName();
+        EXPECT_GT(detector->GetScore(), restScore);
+    }
+    auto detector = CreateMotionDetector(MotionDetectorType::SIGNIFICANT_MOTION, SENSOR_SAMPLING_RATE);
+    EXPECT_FALSE(detectWindow(*detector, 0, movingStart));
+}
+
+/**
+ * @tc.name: InitMotionDetector
+ * @tc.desc: test the detector and its threshold are read from detect_list.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(MotionSensorMonitorTest, InitMotionDetector, TestSize.Level1)
+{
+    constexpr int32_t unknownType = 100;
+    constexpr int32_t varianceThreshold = 200;
+    ConstraintEvalParam motionParams{};
+    auto motionConstraint = std::make_shared<MotionSensorMonitor>(
+        PERIODLY_TASK_DECTION_TIMEOUT, PERIODLY_TASK_REST_TIMEOUT, PERIODLY_TASK_TOTAL_TIMEOUT, motionParams);
+    auto& paraMap = StandbyConfigManager::GetInstance()->standbyParaMap_;
+    paraMap[MOTION_DETECTOR] = static_cast<int32_t>(MotionDetectorType::JERK);
+    motionConstraint->InitMotionDetector();
+    EXPECT_EQ(motionConstraint->detector_->GetType(), MotionDetectorType::JERK);
+    paraMap[MOTION_DETECTOR] = unknownType;
+    motionConstraint->InitMotionDetector();
+    EXPECT_EQ(motionConstraint->detector_->GetType(), MotionDetectorType::ENERGY);
+
+    paraMap[MOTION_DETECTOR] = static_cast<int32_t>(MotionDetectorType::VARIANCE);
+    motionConstraint->InitMotionDetector();
+    paraMap[MOTION_VARIANCE_THRESHOLD] = 0;
+    EXPECT_DOUBLE_EQ(motionConstraint->ReadMotionThreshold(), 0.05);
+    paraMap[MOTION_VARIANCE_THRESHOLD] = varianceThreshold;
+    EXPECT_DOUBLE_EQ(motionConstraint->ReadMotionThreshold(), 0.2);
+    paraMap[MOTION_DETECTOR] = static_cast<int32_t>(MotionDetectorType::ENERGY);
+}
+
+/**
+ * @tc.name: AccelEnergyBenchmark
+ * @tc.desc: measure the cost per sample of batched motion energy against the former per sample callback.
+ * @tc.type: PERF
+ * @tc.require:
+ */
+HWTEST_F(MotionSensorMonitorTest, AccelEnergyBenchmark, TestSize.Level1)
+{
+    constexpr size_t repeatTimes = 200;
+    auto trace = MakeAccelTrace(TRACE_SAMPLE_NUM);
+    double sampleNum = static_cast<double>(repeatTimes * trace.size());
+
+    AccelSampleBatch batch {};
+    MotionVector previous {trace[0].x, trace[0].y, trace[0].z};
+    double batchEnergy = 0;
+    auto startTime = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < repeatTimes; ++round) {
+        for (const auto& sample : trace) {
+            batch.Add(sample.x, sample.y, sample.z);
+            if (batch.Full()) {
+                batchEnergy += batch.AccumulateEnergy(previous);
+                batch.Clear();
+            }
+        }
+    }
+    batchEnergy += batch.AccumulateEnergy(previous);
+    double batchCost = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+
+    // the former callback read the threshold twice for every sample
+    double singleEnergy = 0;
+    int32_t exceededCount = 0;
+    startTime = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < repeatTimes; ++round) {
+        for (size_t index = 1; index < trace.size(); ++index) {
+            float diffX = trace[index].x - trace[index - 1].x;
+            float diffY = trace[index].y - trace[index - 1].y;
+            float diffZ = trace[index].z - trace[index - 1].z;
+            singleEnergy += (diffX * diffX) + (diffY * diffY) + (diffZ * diffZ);
+            exceededCount += singleEnergy > StandbyConfigManager::GetInstance()->GetStandbyParam(MOTION_THREADSHOLD) &&
+                singleEnergy > StandbyConfigManager::GetInstance()->GetStandbyParam(MOTION_THREADSHOLD) ? 1 : 0;
+        }
+    }
+    double singleCost = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+    GTEST_LOG_(INFO) << "motion energy per sample, batched: " << batchCost / sampleNum << " ns, one by one: " <<
+        singleCost / sampleNum << " ns, exceeded: " << exceededCount;
+    EXPECT_GT(batchEnergy, 0);
+    EXPECT_GT(singleEnergy, 0);
+}
 }  // namespace DevStandbyMgr
 }  // namespace OHOS
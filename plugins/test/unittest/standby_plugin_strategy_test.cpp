@@ -21,6 +21,16 @@
 #include "system_ability_definition.h"
 
 #include "running_lock_strategy.h"
+#include "timer_strategy.h"
+#include "work_scheduler_strategy.h"
+#include "sa_query_executor.h"
+#include "strategy_manager_adapter.h"
+#include "strategy_registry.h"
+#include "app_state_cache.h"
+#include "exemption_table.h"
+#include "freeze_strategy.h"
+#include "heartbeat_align_strategy.h"
+#include "heartbeat_scheduler.h"
 #ifdef STANDBY_COMMUNICATION_NETMANAGER_BASE_ENABLE
 #include "network_strategy.h"
 #include "base_network_strategy.h"
@@ -30,6 +40,8 @@
 #include "want.h"
 #include "workscheduler_srv_client.h"
 #include "standby_config_manager.h"
+#include "standby_state.h"
+#include "mock_ipc.h"
 
 using namespace testing::ext;
 using namespace testing::mt;
@@ -52,7 +64,67 @@ ErrCode WorkScheduler::WorkSchedulerSrvClient::GetAllRunningWorks
     }
 }
 
+ErrCode WorkScheduler::WorkSchedulerSrvClient::PauseRunningWorks(int32_t uid)
+{
+    return ERR_OK;
+}
+
+ErrCode WorkScheduler::WorkSchedulerSrvClient::ResumePausedWorks(int32_t uid)
+{
+    return ERR_OK;
+}
+
 namespace DevStandbyMgr {
+class CountingStrategy : public IBaseStrategy {
+public:
+    void HandleEvent(const StandbyMessage& message) override
+    {
+        ++handledCount_;
+    }
+    ErrCode OnCreated() override
+    {
+        return ERR_OK;
+    }
+    ErrCode OnDestroy() override
+    {
+        return ERR_OK;
+    }
+    void ShellDump(const std::vector<std::string>& argsInStr, std::string& result) override {}
+
+    uint32_t handledCount_ {0};
+};
+
+class FakeFreezeBackend : public IFreezeBackend {
+public:
+    ErrCode Init() override
+    {
+        return ERR_OK;
+    }
+    void Freeze(const std::vector<int32_t>& pids, std::vector<int32_t>& frozenPids) override
+    {
+        frozenPids_.insert(pids.begin(), pids.end());
+        frozenPids.insert(frozenPids.end(), pids.begin(), pids.end());
+    }
+    void Thaw(const std::vector<int32_t>& pids) override
+    {
+        for (const auto pid : pids) {
+            frozenPids_.erase(pid);
+        }
+    }
+    void Forget(int32_t pid) override
+    {
+        frozenPids_.erase(pid);
+        ++forgottenCount_;
+    }
+    std::string GetName() const override
+    {
+        return "fake";
+    }
+
+    std::set<int32_t> frozenPids_ {};
+    uint32_t forgottenCount_ {0};
+};
+
 class StandbyPluginStrategyTest : public testing::Test {
 public:
     static void SetUpTestCase();
@@ -81,18 +153,14 @@ HWTEST_F(StandbyPluginStrategyTest, StandbyPluginStrategyTest_001, TestSize.Leve
     int32_t uid = 1;
     int32_t pid = 1;
     std::string bundleName = "defaultBundleName";
-    std::string mapKey = std::to_string(uid) + "_" + bundleName;
-    struct ProxiedProcInfo procInfo = {
-        bundleName,
-        uid,
-        {pid}
-    };
-    runningLockStrategy->proxiedAppInfo_.emplace(mapKey, procInfo);
+    size_t row = runningLockStrategy->proxiedAppInfo_.Emplace(uid, bundleName).first;
+    runningLockStrategy->proxiedAppInfo_.AddPid(row, pid);
     runningLockStrategy->GetAndCreateAppInfo(uid, pid, bundleName);
+    EXPECT_EQ(runningLockStrategy->proxiedAppInfo_.GetPidCount(row), 1);
 
     uid = 2;
     runningLockStrategy->GetAndCreateAppInfo(uid, pid, bundleName);
-    EXPECT_NE(runningLockStrategy, nullptr);
+    EXPECT_EQ(runningLockStrategy->proxiedAppInfo_.Size(), 2);
 }
 
 /**
@@ -104,15 +172,10 @@ HWTEST_F(StandbyPluginStrategyTest, StandbyPluginStrategyTest_001, TestSize.Leve
 HWTEST_F(StandbyPluginStrategyTest, StandbyPluginStrategyTest_002, TestSize.Level1)
 {
     auto runningLockStrategy = std::make_shared<RunningLockStrategy>();
-    uint32_t uid = 1;
-    uint32_t pid = 1;
+    int32_t uid = 1;
     std::string bundleName = "defaultBundleName";
-    struct ProxiedProcInfo procInfo = {
-        bundleName,
-        uid,
-        {pid}
-    };
-    runningLockStrategy->GetExemptionConfigForApp(procInfo, bundleName);
+    size_t row = runningLockStrategy->proxiedAppInfo_.Emplace(uid, bundleName).first;
+    runningLockStrategy->GetExemptionConfigForApp(row, bundleName);
     EXPECT_NE(runningLockStrategy, nullptr);
 }
 
@@ -159,13 +222,8 @@ HWTEST_F(StandbyPluginStrategyTest, StandbyPluginStrategyTest_004, TestSize.Leve
     standbyMessage.want_->SetParam("isCreated", true);
 
     runningLockStrategy->isProxied_ = true;
-    std::string mapKey = std::to_string(uid) + "_" + bundleName;
-    struct ProxiedProcInfo procInfo = {
-        bundleName,
-        uid,
-        {pid}
-    };
-    runningLockStrategy->proxiedAppInfo_.emplace(mapKey, procInfo);
+    size_t row = runningLockStrategy->proxiedAppInfo_.Emplace(uid, bundleName).first;
+    runningLockStrategy->proxiedAppInfo_.AddPid(row, pid);
     runningLockStrategy->HandleProcessStatusChanged(standbyMessage);
 
     uid = 2;
@@ -282,9 +340,9 @@ HWTEST_F(StandbyPluginStrategyTest, StandbyPluginStrategyTest_011, TestSize.Leve
 {
     auto baseNetworkStrategy = std::make_shared<NetworkStrategy>();
     std::string bundleName = "defaultBundleName";
-    NetLimtedAppInfo appInfo {bundleName};
+    size_t row = baseNetworkStrategy->netLimitedAppInfo_.Emplace(1, bundleName).first;
 
-    baseNetworkStrategy->GetExemptionConfigForApp(appInfo, bundleName);
+    baseNetworkStrategy->GetExemptionConfigForApp(row, bundleName);
     EXPECT_NE(baseNetworkStrategy, nullptr);
 }
 
@@ -312,9 +370,10 @@ HWTEST_F(StandbyPluginStrategyTest, StandbyPluginStrategyTest_013, TestSize.Leve
     auto baseNetworkStrategy = std::make_shared<NetworkStrategy>();
     int32_t uid = 1;
     uint8_t flag = ExemptionTypeFlag::UNRESTRICTED;
-    NetLimtedAppInfo appInfo {"defaulBundleName"};
-    baseNetworkStrategy->netLimitedAppInfo_.emplace(uid, appInfo);
+    baseNetworkStrategy->netLimitedAppInfo_.Clear();
+    size_t row = baseNetworkStrategy->netLimitedAppInfo_.Emplace(uid, "defaulBundleName").first;
     baseNetworkStrategy->AddExemptionFlagByUid(uid, flag);
+    EXPECT_EQ(baseNetworkStrategy->netLimitedAppInfo_.GetFlag(row), flag);
 
     uid = 2;
     baseNetworkStrategy->AddExemptionFlagByUid(uid, flag);
@@ -343,6 +402,483 @@ HWTEST_F(StandbyPluginStrategyTest, StandbyPluginStrategyTest_014, TestSize.Leve
     flag |= ExemptionTypeFlag::CONTINUOUS_TASK;
     EXPECT_EQ(baseNetworkStrategy->IsFlagExempted(flag), true);
 }
+
+/**
+ * @tc.name: StandbyPluginStrategyTest_015
+ * @tc.desc: test AddPendingFirewallUid and FlushPendingFirewallList.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyPluginStrategyTest, StandbyPluginStrategyTest_015, TestSize.Level1)
+{
+    auto baseNetworkStrategy = std::make_shared<NetworkStrategy>();
+    baseNetworkStrategy->ClearPendingFirewallList();
+    baseNetworkStrategy->pendingAllowedUids_.emplace(1);
+    baseNetworkStrategy->AddPendingFirewallUid(1, false);
+    EXPECT_TRUE(baseNetworkStrategy->pendingAllowedUids_.empty());
+    EXPECT_TRUE(baseNetworkStrategy->pendingRemovedUids_.empty());
+
+    baseNetworkStrategy->ClearPendingFirewallList();
+    baseNetworkStrategy->pendingRemovedUids_.emplace(2);
+    baseNetworkStrategy->pendingRemovedUids_.emplace(3);
+    baseNetworkStrategy->pendingFirewallOpCount_ = 2;
+    baseNetworkStrategy->savedFirewallIpcCount_ = 0;
+    baseNetworkStrategy->FlushPendingFirewallList();
+    EXPECT_TRUE(baseNetworkStrategy->pendingRemovedUids_.empty());
+    EXPECT_EQ(baseNetworkStrategy->savedFirewallIpcCount_, 1);
+    EXPECT_EQ(baseNetworkStrategy->pendingFirewallOpCount_, 0);
+}
 #endif // STANDBY_COMMUNICATION_NETMANAGER_BASE_ENABLE
+
+/**
+ * @tc.name: StandbyPluginStrategyTest_016
+ * @tc.desc: test QueryAppStates of SaQueryExecutor.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyPluginStrategyTest, StandbyPluginStrategyTest_016, TestSize.Level1)
+{
+    std::shared_ptr<AppStateQueryResult> queryResult {nullptr};
+    EXPECT_EQ(SaQueryExecutor::GetInstance()->QueryAppStates(0, queryResult), ERR_OK);
+    EXPECT_NE(queryResult, nullptr);
+
+    #ifdef STANDBY_RSS_WORK_SCHEDULER_ENABLE
+    g_getAllRunningWorks = true;
+    EXPECT_EQ(SaQueryExecutor::GetInstance()->QueryAppStates(SaQueryType::WORK_SCHEDULER, queryResult), ERR_OK);
+    EXPECT_EQ(queryResult->workInfos_.size(), 2);
+    g_getAllRunningWorks = false;
+    EXPECT_NE(SaQueryExecutor::GetInstance()->QueryAppStates(SaQueryType::WORK_SCHEDULER, queryResult), ERR_OK);
+    EXPECT_EQ(queryResult, nullptr);
+    g_getAllRunningWorks = true;
+    #endif
+
+    std::string result {""};
+    SaQueryExecutor::GetInstance()->ShellDump(result);
+    EXPECT_NE(result.find("SaQuery"), std::string::npos);
+}
+
+/**
+ * @tc.name: StandbyPluginStrategyTest_017
+ * @tc.desc: test incremental update of AppStateCache.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyPluginStrategyTest, StandbyPluginStrategyTest_017, TestSize.Level1)
+{
+    auto appStateCache = AppStateCache::GetInstance();
+    appStateCache->Clear();
+    appStateCache->isLoaded_ = true;
+    int32_t uid = 20010001;
+
+    StandbyMessage processMessage {StandbyMessageType::PROCESS_STATE_CHANGED};
+    processMessage.want_ = AAFwk::Want {};
+    processMessage.want_->SetParam("uid", uid);
+    processMessage.want_->SetParam("pid", 1);
+    processMessage.want_->SetParam("name", std::string("defaultBundleName"));
+    processMessage.want_->SetParam("isCreated", true);
+    appStateCache->HandleEvent(processMessage);
+
+    StandbyMessage fgMessage {StandbyMessageType::APP_FOREGROUND_STATE_CHANGED};
+    fgMessage.want_ = AAFwk::Want {};
+    fgMessage.want_->SetParam("uid", uid);
+    fgMessage.want_->SetParam("isForeground", true);
+    appStateCache->HandleEvent(fgMessage);
+
+    StandbyMessage bgTaskMessage {StandbyMessageType::BG_TASK_STATUS_CHANGE};
+    bgTaskMessage.want_ = AAFwk::Want {};
+    bgTaskMessage.want_->SetParam(BG_TASK_TYPE, CONTINUOUS_TASK);
+    bgTaskMessage.want_->SetParam(BG_TASK_STATUS, true);
+    bgTaskMessage.want_->SetParam(BG_TASK_UID, uid);
+    bgTaskMessage.want_->SetParam(BG_TASK_TYPE_ID, 1);
+    appStateCache->HandleEvent(bgTaskMessage);
+
+    AppStateInfo appState {};
+    EXPECT_TRUE(appStateCache->GetAppState(uid, appState));
+    EXPECT_EQ(appState.bundleName_, "defaultBundleName");
+    EXPECT_TRUE(appState.isForeground_);
+    EXPECT_EQ(appState.continuousTaskTypeIds_.size(), 1);
+
+    // app with background task is kept after its last process died
+    processMessage.want_->SetParam("isCreated", false);
+    appStateCache->HandleEvent(processMessage);
+    EXPECT_TRUE(appStateCache->GetAppState(uid, appState));
+    EXPECT_TRUE(appState.pids_.empty());
+    bgTaskMessage.want_->SetParam(BG_TASK_STATUS, false);
+    appStateCache->HandleEvent(bgTaskMessage);
+    EXPECT_FALSE(appStateCache->GetAppState(uid, appState));
+    appStateCache->Clear();
+}
+
+/**
+ * @tc.name: StandbyPluginStrategyTest_018
+ * @tc.desc: test ProxyRunningLockList only sends changed pids.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyPluginStrategyTest, StandbyPluginStrategyTest_018, TestSize.Level1)
+{
+    auto runningLockStrategy = std::make_shared<RunningLockStrategy>();
+    runningLockStrategy->proxiedPidSet_.emplace(1, 1);
+    runningLockStrategy->ProxyRunningLockList(true, {std::make_pair(1, 1)});
+    EXPECT_EQ(runningLockStrategy->proxyIpcCount_, 0);
+    EXPECT_EQ(runningLockStrategy->skippedProxyPairCount_, 1);
+
+    runningLockStrategy->ProxyRunningLockList(false, {std::make_pair(2, 2)});
+    EXPECT_EQ(runningLockStrategy->proxyIpcCount_, 0);
+    EXPECT_EQ(runningLockStrategy->skippedProxyPairCount_, 2);
+
+    // the pid which is not proxied any more is unproxied, nothing is sent in maintenance
+    runningLockStrategy->isIdleMaintence_ = true;
+    runningLockStrategy->SyncProxiedPidList();
+    EXPECT_EQ(runningLockStrategy->proxyIpcCount_, 0);
+    runningLockStrategy->isIdleMaintence_ = false;
+    runningLockStrategy->SyncProxiedPidList();
+    EXPECT_EQ(runningLockStrategy->proxyIpcCount_, 1);
+    EXPECT_EQ(runningLockStrategy->proxyPairCount_, 1);
+}
+
+/**
+ * @tc.name: StandbyPluginStrategyTest_019
+ * @tc.desc: test ReevaluateExemptionConfig only recalculates condition sensitive apps.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyPluginStrategyTest, StandbyPluginStrategyTest_019, TestSize.Level1)
+{
+    auto runningLockStrategy = std::make_shared<RunningLockStrategy>();
+    auto& proxiedAppInfo = runningLockStrategy->proxiedAppInfo_;
+    proxiedAppInfo.SetFlag(proxiedAppInfo.Emplace(1, "bundleA").first,
+        ExemptionTypeFlag::EXEMPTION | ExemptionTypeFlag::FOREGROUND_APP);
+    proxiedAppInfo.SetFlag(proxiedAppInfo.Emplace(2, "bundleB").first, ExemptionTypeFlag::EXEMPTION);
+    runningLockStrategy->ReevaluateExemptionConfig({"bundleA"});
+    EXPECT_EQ(proxiedAppInfo.GetFlag(proxiedAppInfo.Find(1, "bundleA")), ExemptionTypeFlag::FOREGROUND_APP);
+    EXPECT_EQ(proxiedAppInfo.GetFlag(proxiedAppInfo.Find(2, "bundleB")), ExemptionTypeFlag::EXEMPTION);
+    EXPECT_EQ(runningLockStrategy->conditionReevaluatedCount_, 1);
+
+    // nothing is recalculated if no proxy is applied
+    EXPECT_EQ(runningLockStrategy->UpdateResourceConfig(), ERR_STANDBY_CURRENT_STATE_NOT_MATCH);
+}
+
+/**
+ * @tc.name: StandbyPluginStrategyTest_020
+ * @tc.desc: test TimerStrategy aligns timers in sleep and restores them when exiting.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyPluginStrategyTest, StandbyPluginStrategyTest_020, TestSize.Level1)
+{
+    StandbyConfigManager::GetInstance()->intervalListMap_[SLEEP_MAINT_DURATOIN] = {600, 300};
+    StandbyConfigManager::GetInstance()->timerResConfigList_.emplace_back(TimerResourceConfig {true,
+        {ConditionType::DAY_STANDBY, ConditionType::NIGHT_STANDBY}, {{"clockApp", 0, true}, {"periodApp", 60, false},
+        {"lazyApp", 3600, false}}});
+    auto timerStrategy = std::make_shared<TimerStrategy>();
+    StandbyMessage message(StandbyMessageType::STATE_TRANSIT);
+    message.want_ = AAFwk::Want {};
+    message.want_->SetParam(PREVIOUS_STATE, StandbyState::NAP);
+    message.want_->SetParam(CURRENT_STATE, StandbyState::SLEEP);
+    timerStrategy->HandleEvent(message);
+    EXPECT_TRUE(timerStrategy->isAligned_);
+    EXPECT_EQ(MockIpc::GetAdjustTimerInterval(), 300);
+    const auto& exemptionNames = MockIpc::GetTimerExemptionNames();
+    EXPECT_NE(exemptionNames.find("clockApp"), exemptionNames.end());
+    EXPECT_NE(exemptionNames.find("periodApp"), exemptionNames.end());
+    EXPECT_EQ(exemptionNames.find("lazyApp"), exemptionNames.end());
+
+    message.want_->SetParam(PREVIOUS_STATE, StandbyState::SLEEP);
+    message.want_->SetParam(CURRENT_STATE, StandbyState::MAINTENANCE);
+    timerStrategy->HandleEvent(message);
+    EXPECT_EQ(timerStrategy->alignedWindowCount_, 1);
+
+    message.want_->SetParam(PREVIOUS_STATE, StandbyState::MAINTENANCE);
+    message.want_->SetParam(CURRENT_STATE, StandbyState::WORKING);
+    timerStrategy->HandleEvent(message);
+    EXPECT_FALSE(timerStrategy->isAligned_);
+    EXPECT_EQ(MockIpc::GetAdjustTimerInterval(), 0);
+    EXPECT_TRUE(MockIpc::GetTimerExemptionNames().empty());
+    StandbyConfigManager::GetInstance()->intervalListMap_.erase(SLEEP_MAINT_DURATOIN);
+    StandbyConfigManager::GetInstance()->timerResConfigList_.pop_back();
+}
+
+/**
+ * @tc.name: StandbyPluginStrategyTest_021
+ * @tc.desc: test WorkSchedulerStrategy releases deferred works by priority with concurrency cap.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyPluginStrategyTest, StandbyPluginStrategyTest_021, TestSize.Level1)
+{
+    auto workStrategy = std::make_shared<WorkSchedulerStrategy>();
+    workStrategy->maxConcurrency_ = 1;
+    workStrategy->isDeferring_ = true;
+    workStrategy->isIdleMaintence_ = true;
+    workStrategy->deferredWorks_.emplace(1, DeferredWorkInfo {1, "normalApp", DeferredWorkPriority::NORMAL_APP, 0});
+    workStrategy->deferredWorks_.emplace(2, DeferredWorkInfo {2, "systemApp", DeferredWorkPriority::SYSTEM_APP, 1});
+    workStrategy->ReleaseDeferredWorks();
+    EXPECT_EQ(workStrategy->releasedWorks_.size(), 1);
+    EXPECT_NE(workStrategy->releasedWorks_.find(2), workStrategy->releasedWorks_.end());
+    EXPECT_EQ(workStrategy->deferredWorks_.size(), 1);
+
+    // finished work leaves its slot to the next deferred work
+    StandbyMessage message(StandbyMessageType::BG_TASK_STATUS_CHANGE);
+    message.want_ = AAFwk::Want {};
+    message.want_->SetParam(BG_TASK_TYPE, WORK_SCHEDULER);
+    message.want_->SetParam(BG_TASK_STATUS, false);
+    message.want_->SetParam(BG_TASK_UID, 2);
+    workStrategy->HandleEvent(message);
+    EXPECT_NE(workStrategy->releasedWorks_.find(1), workStrategy->releasedWorks_.end());
+    EXPECT_TRUE(workStrategy->deferredWorks_.empty());
+    EXPECT_EQ(workStrategy->releasedCount_, 2);
+
+    message = StandbyMessage(StandbyMessageType::STATE_TRANSIT);
+    message.want_ = AAFwk::Want {};
+    message.want_->SetParam(PREVIOUS_STATE, StandbyState::MAINTENANCE);
+    message.want_->SetParam(CURRENT_STATE, StandbyState::WORKING);
+    workStrategy->HandleEvent(message);
+    EXPECT_FALSE(workStrategy->isDeferring_);
+    ASSERT_EQ(workStrategy->recentBatchSizes_.size(), 1);
+    EXPECT_EQ(workStrategy->recentBatchSizes_.front(), 2);
+}
+
+/**
+ * @tc.name: StandbyPluginStrategyTest_022
+ * @tc.desc: test StrategyManagerAdapter dispatches transition concurrently and records timing of each strategy.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyPluginStrategyTest, StandbyPluginStrategyTest_022, TestSize.Level1)
+{
+    auto strategyManager = std::make_shared<StrategyManagerAdapter>();
+    auto runningLockStrategy = std::make_shared<RunningLockStrategy>();
+    auto timerStrategy = std::make_shared<TimerStrategy>();
+    strategyManager->strategyList_.emplace_back(runningLockStrategy);
+    strategyManager->strategyList_.emplace_back(timerStrategy);
+    strategyManager->isConcurrent_ = true;
+
+    StandbyMessage message(StandbyMessageType::STATE_TRANSIT);
+    message.want_ = AAFwk::Want {};
+    message.want_->SetParam(PREVIOUS_STATE, StandbyState::WORKING);
+    message.want_->SetParam(CURRENT_STATE, StandbyState::DARK);
+    strategyManager->HandleEvent(message);
+    EXPECT_EQ(strategyManager->concurrentEventCount_, 1);
+    EXPECT_EQ(strategyManager->timingMap_[runningLockStrategy.get()].count_, 1);
+    EXPECT_EQ(strategyManager->timingMap_[timerStrategy.get()].count_, 1);
+
+    // other messages are still handled on current thread
+    strategyManager->HandleEvent(StandbyMessage(StandbyMessageType::SYS_ABILITY_STATUS_CHANGED));
+    EXPECT_EQ(strategyManager->concurrentEventCount_, 1);
+    EXPECT_EQ(strategyManager->timingMap_[timerStrategy.get()].count_, 2);
+    std::string result {""};
+    strategyManager->DumpStrategyTiming(result);
+    EXPECT_NE(result.find("concurrent event count: 1"), std::string::npos);
+    strategyManager->strategyList_.clear();
+}
+
+/**
+ * @tc.name: StandbyPluginStrategyTest_023
+ * @tc.desc: test strategies registered in StrategyRegistry are created on demand and filtered by event mask.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyPluginStrategyTest, StandbyPluginStrategyTest_023, TestSize.Level1)
+{
+    auto registry = StrategyRegistry::GetInstance();
+    uint32_t createdCount {0};
+    std::shared_ptr<CountingStrategy> countingStrategy {nullptr};
+    EXPECT_TRUE(registry->RegisterStrategy({"COUNTING", [&createdCount, &countingStrategy]() {
+            ++createdCount;
+            countingStrategy = std::make_shared<CountingStrategy>();
+            return countingStrategy;
+        }, StrategyRegistry::GetEventMask({StandbyMessageType::STATE_TRANSIT}), {}}));
+    EXPECT_FALSE(registry->RegisterStrategy({"COUNTING", []() { return std::make_shared<CountingStrategy>(); }}));
+    EXPECT_EQ(createdCount, 0);
+
+    auto strategyManager = std::make_shared<StrategyManagerAdapter>();
+    strategyManager->RegisterPolicy({"COUNTING", "NOT_REGISTERED"});
+    ASSERT_EQ(strategyManager->strategyList_.size(), 1);
+    EXPECT_EQ(createdCount, 1);
+    strategyManager->HandleEvent(StandbyMessage(StandbyMessageType::ALLOW_LIST_CHANGED));
+    EXPECT_EQ(countingStrategy->handledCount_, 0);
+    strategyManager->HandleEvent(StandbyMessage(StandbyMessageType::STATE_TRANSIT));
+    EXPECT_EQ(countingStrategy->handledCount_, 1);
+
+    strategyManager->strategyList_.clear();
+    registry->UnregisterStrategy("COUNTING");
+    uint64_t eventMask {0};
+    EXPECT_EQ(registry->CreateStrategy("COUNTING", eventMask), nullptr);
+    EXPECT_NE(registry->CreateStrategy("TIMER", eventMask), nullptr);
+    EXPECT_TRUE(StrategyRegistry::IsEventConsumed(eventMask, StandbyMessageType::STATE_TRANSIT));
+    EXPECT_FALSE(StrategyRegistry::IsEventConsumed(eventMask, StandbyMessageType::PHASE_TRANSIT));
+}
+
+/**
+ * @tc.name: StandbyPluginStrategyTest_024
+ * @tc.desc: test rows, pid ranges and flag scans of ExemptionTable.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyPluginStrategyTest, StandbyPluginStrategyTest_024, TestSize.Level1)
+{
+    ExemptionTable table {};
+    size_t rowB = table.Emplace(20, "bundleB").first;
+    table.AddPid(rowB, 200);
+    table.Emplace(10, "bundleA");
+    table.Emplace(20, "procB");
+    EXPECT_FALSE(table.Emplace(10, "bundleA").second);
+    ASSERT_EQ(table.Size(), 3);
+    EXPECT_EQ(table.Find(20), 1);
+    EXPECT_EQ(table.Find(20, "procB"), 2);
+    EXPECT_EQ(table.Find(30), ExemptionTable::NPOS);
+
+    table.AddPid(0, 101);
+    table.AddPid(0, 100);
+    table.AddPid(2, 201);
+    EXPECT_EQ(*table.GetPids(0).first, 100);
+    EXPECT_EQ(table.GetPidCount(1), 1);
+    table.SetFlag(1, ExemptionTypeFlag::FOREGROUND_APP);
+    table.SetFlag(2, ExemptionTypeFlag::RESTRICTED);
+
+    ExemptionFlagFilter filter {};
+    for (size_t flag = 0; flag < filter.size(); ++flag) {
+        filter[flag] = !ExemptionTypeFlag::IsExempted(static_cast<uint8_t>(flag));
+    }
+    std::vector<std::pair<int32_t, int32_t>> pids {};
+    table.CollectPids(filter, pids);
+    EXPECT_EQ(pids.size(), 3);
+    std::vector<uint32_t> uids {};
+    table.CollectUids(filter, uids);
+    EXPECT_EQ(uids.size(), 2);
+
+    table.Erase(0);
+    EXPECT_EQ(table.GetUid(0), 20);
+    EXPECT_TRUE(table.RemovePid(1, 201));
+    EXPECT_EQ(*table.GetPids(0).first, 200);
+    EXPECT_GT(table.GetMemoryUsage(), 0);
+    table.Clear();
+    EXPECT_TRUE(table.Empty());
+}
+
+/**
+ * @tc.name: StandbyPluginStrategyTest_025
+ * @tc.desc: test FreezeStrategy freezes background apps in sleep and thaws them in maintenance.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyPluginStrategyTest, StandbyPluginStrategyTest_025, TestSize.Level1)
+{
+    auto appStateCache = AppStateCache::GetInstance();
+    appStateCache->Clear();
+    appStateCache->isLoaded_ = true;
+    appStateCache->appStateMap_[20010001] = AppStateInfo {20010001, "bundleA", "bundleA", {101, 102}};
+    appStateCache->appStateMap_[20010002] = AppStateInfo {20010002, "bundleB", "bundleB", {201}};
+    appStateCache->appStateMap_[20010002].isForeground_ = true;
+    appStateCache->appStateMap_[20010003] = AppStateInfo {20010003, "bundleC", "bundleC", {301}};
+    appStateCache->appStateMap_[20010003].isSystemApp_ = true;
+
+    auto backend = std::make_shared<FakeFreezeBackend>();
+    auto freezeStrategy = std::make_shared<FreezeStrategy>(backend);
+    EXPECT_EQ(freezeStrategy->OnCreated(), ERR_OK);
+    freezeStrategy->batchSize_ = 1;
+    StandbyMessage phaseMessage {StandbyMessageType::PHASE_TRANSIT};
+    phaseMessage.want_ = AAFwk::Want {};
+    phaseMessage.want_->SetParam(CURRENT_STATE, static_cast<int32_t>(StandbyState::SLEEP));
+    phaseMessage.want_->SetParam(CURRENT_PHASE, static_cast<int32_t>(SleepStatePhase::APP_RES_DEEP));
+    freezeStrategy->HandleEvent(phaseMessage);
+    EXPECT_TRUE(freezeStrategy->isFreezing_);
+    EXPECT_EQ(backend->frozenPids_.size(), 1);
+    freezeStrategy->FreezeNextBatch();
+    EXPECT_EQ(backend->frozenPids_, std::set<int32_t>({101, 102}));
+
+    StandbyMessage processMessage {StandbyMessageType::PROCESS_STATE_CHANGED};
+    processMessage.want_ = AAFwk::Want {};
+    processMessage.want_->SetParam("pid", 102);
+    processMessage.want_->SetParam("isCreated", false);
+    freezeStrategy->HandleEvent(processMessage);
+    EXPECT_EQ(backend->forgottenCount_, 1);
+    EXPECT_EQ(backend->frozenPids_, std::set<int32_t>({101}));
+
+    StandbyMessage fgMessage {StandbyMessageType::APP_FOREGROUND_STATE_CHANGED};
+    fgMessage.want_ = AAFwk::Want {};
+    fgMessage.want_->SetParam("uid", 20010001);
+    fgMessage.want_->SetParam("isForeground", true);
+    freezeStrategy->HandleEvent(fgMessage);
+    EXPECT_TRUE(backend->frozenPids_.empty());
+
+    StandbyMessage stateMessage {StandbyMessageType::STATE_TRANSIT};
+    stateMessage.want_ = AAFwk::Want {};
+    stateMessage.want_->SetParam(PREVIOUS_STATE, static_cast<int32_t>(StandbyState::MAINTENANCE));
+    stateMessage.want_->SetParam(CURRENT_STATE, static_cast<int32_t>(StandbyState::SLEEP));
+    freezeStrategy->HandleEvent(stateMessage);
+    EXPECT_EQ(backend->frozenPids_.size(), 1);
+    stateMessage.want_->SetParam(PREVIOUS_STATE, static_cast<int32_t>(StandbyState::SLEEP));
+    stateMessage.want_->SetParam(CURRENT_STATE, static_cast<int32_t>(StandbyState::MAINTENANCE));
+    freezeStrategy->HandleEvent(stateMessage);
+    EXPECT_TRUE(backend->frozenPids_.empty());
+    EXPECT_TRUE(freezeStrategy->isIdleMaintence_);
+    EXPECT_EQ(freezeStrategy->recentCycleFrozenCounts_.size(), 2);
+
+    std::string result {""};
+    freezeStrategy->DumpShowDetailInfo({"-D", "-S"}, result);
+    EXPECT_NE(result.find("backend: fake"), std::string::npos);
+    EXPECT_EQ(freezeStrategy->OnDestroy(), ERR_OK);
+    EXPECT_FALSE(freezeStrategy->isFreezing_);
+    appStateCache->Clear();
+}
+
+/**
+ * @tc.name: StandbyPluginStrategyTest_026
+ * @tc.desc: test heartbeats of tags are aligned with each other and with maintenance windows.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyPluginStrategyTest, StandbyPluginStrategyTest_026, TestSize.Level1)
+{
+    HeartbeatScheduler scheduler {25};
+    scheduler.SetInterval("a", 100, 0);
+    scheduler.SetInterval("b", 110, 0);
+    scheduler.SetInterval("c", 400, 0);
+    EXPECT_EQ(scheduler.GetNextWakeup(), 100);
+    scheduler.Advance(100);
+    EXPECT_EQ(scheduler.GetBeatCount(), 2);
+    EXPECT_EQ(scheduler.GetWakeupCount(), 1);
+
+    // beats due at 200 and 210 may be moved into the window, no wakeup of their own
+    scheduler.AddMaintenanceWindow(190, 250);
+    EXPECT_EQ(scheduler.GetNextWakeup(), 190);
+    scheduler.Advance(300);
+    EXPECT_EQ(scheduler.GetBeatCount(), 6);
+    EXPECT_EQ(scheduler.GetWakeupCount(), 2);
+    EXPECT_EQ(scheduler.GetWakeupSavedCount(), 4);
+    EXPECT_TRUE(scheduler.GetMaintenanceWindows().empty());
+    for (const auto& tag : scheduler.GetTags()) {
+        EXPECT_EQ(tag.alignedBeat_, 390);
+    }
+    scheduler.OnTraffic(350);
+    EXPECT_EQ(scheduler.GetNextWakeup(), 450);
+    scheduler.SetInterval("b", 0, 350);
+    EXPECT_EQ(scheduler.GetTags().size(), 2);
+
+    auto heartbeatStrategy = std::make_shared<HeartbeatAlignStrategy>();
+    EXPECT_EQ(heartbeatStrategy->OnCreated(), ERR_OK);
+    StandbyMessage natMessage {StandbyMessageType::NAT_DETECT_INTERVAL_CHANGED};
+    natMessage.want_ = AAFwk::Want {};
+    natMessage.want_->SetParam(MESSAGE_TYPE, 1);
+    natMessage.want_->SetParam(MESSAGE_ENABLE, true);
+    natMessage.want_->SetParam(MESSAGE_INTERVAL, 300);
+    heartbeatStrategy->HandleEvent(natMessage);
+    StandbyMessage heartbeatMessage {StandbyMessageType::HEART_BEAT_VALUE_CHANGE};
+    heartbeatMessage.want_ = AAFwk::Want {};
+    heartbeatMessage.want_->SetParam("tag", std::string("push"));
+    heartbeatMessage.want_->SetParam("timesTamp", 600);
+    heartbeatStrategy->HandleEvent(heartbeatMessage);
+    EXPECT_EQ(heartbeatStrategy->scheduler_->GetTags().size(), 1);
+    std::string result {""};
+    heartbeatStrategy->DumpShowDetailInfo({"-D", "-S"}, result);
+    EXPECT_NE(result.find("tag: nat_1"), std::string::npos);
+    EXPECT_NE(result.find("projected wakeups saved"), std::string::npos);
+    natMessage.want_->SetParam(MESSAGE_ENABLE, false);
+    heartbeatStrategy->HandleEvent(natMessage);
+    EXPECT_EQ(heartbeatStrategy->scheduler_->GetTags().size(), 0);
+    EXPECT_EQ(heartbeatStrategy->OnDestroy(), ERR_OK);
+}
 }  // namespace DevStandbyMgr
 }  // namespace OHOS
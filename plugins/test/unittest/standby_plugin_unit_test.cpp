@@ -17,6 +17,7 @@
 
 #include <functional>
 #include <chrono>
+#include <cstdio>
 #include <thread>
 #include <message_parcel.h>
 
@@ -53,6 +54,8 @@
 #include "input_manager_listener.h"
 #include "common_constant.h"
 #include "dark_state.h"
+#include "state_history.h"
+#include "state_transition_table.h"
 
 using namespace testing::ext;
 using namespace testing::mt;
@@ -232,7 +235,7 @@ HWTEST_F(StandbyPluginUnitTest, StandbyPluginUnitTest_006, TestSize.Level1)
     constraintManager_->isEvaluation_ = true;
     constraintManager_->StopEvalution();
     constraintManager_->isEvaluation_ = false;
-    constraintManager_->curMonitor_ = nullptr;
+    constraintManager_->curMonitors_.clear();
     constraintManager_->StopEvalution();
     constraintManager_->isEvaluation_ = true;
     ConstraintEvalParam params;
@@ -452,7 +455,7 @@ HWTEST_F(StandbyPluginUnitTest, StandbyPluginUnitTest_0016, TestSize.Level1)
     auto repeatedMotionConstraint = std::make_shared<MotionSensorMonitor>(PERIODLY_TASK_DECTION_TIMEOUT,
             PERIODLY_TASK_REST_TIMEOUT, PERIODLY_TASK_TOTAL_TIMEOUT, repeatedMotionParams);
     repeatedMotionConstraint->PeriodlyStartMotionDetection();
-    repeatedMotionConstraint->energy_ = 1;
+    repeatedMotionConstraint->score_ = 1;
     repeatedMotionConstraint->PeriodlyStartMotionDetection();
     EXPECT_TRUE(repeatedMotionConstraint->StartMonitoringInner() == ERR_OK);
     repeatedMotionConstraint->isMonitoring_ = false;
@@ -740,8 +743,8 @@ HWTEST_F(StandbyPluginUnitTest, StandbyPluginUnitTest_0032, TestSize.Level1)
     event.sensorTypeId = SENSOR_TYPE_ID_NONE;
     event.data = reinterpret_cast<uint8_t*>(&data);
     repeatedMotionConstraint->AcceleromterCallback(&event);
-    EXPECT_TRUE(repeatedMotionConstraint->GetEnergy() == 0);
-    repeatedMotionConstraint->energy_ = 10000;
+    EXPECT_TRUE(repeatedMotionConstraint->GetScore() == 0);
+    repeatedMotionConstraint->score_ = 10000;
     repeatedMotionConstraint->AcceleromterCallback(&event);
     repeatedMotionConstraint->AcceleromterCallback(nullptr);
 }
@@ -763,8 +766,9 @@ HWTEST_F(StandbyPluginUnitTest, StandbyPluginUnitTest_0033, TestSize.Level1)
     event.sensorTypeId = SENSOR_TYPE_ID_NONE;
     event.data = reinterpret_cast<uint8_t*>(&data);
     repeatedMotionConstraint->RepeatAcceleromterCallback(&event);
-    EXPECT_NE(repeatedMotionConstraint->GetEnergy(), 0);
-    repeatedMotionConstraint->energy_ = 10000;
+    // the monitor is not monitoring, the event does not reach it
+    EXPECT_EQ(repeatedMotionConstraint->GetScore(), 0);
+    repeatedMotionConstraint->score_ = 10000;
     repeatedMotionConstraint->RepeatAcceleromterCallback(&event);
     repeatedMotionConstraint->RepeatAcceleromterCallback(nullptr);
 }
@@ -1017,5 +1021,111 @@ HWTEST_F(StandbyPluginUnitTest, StandbyPluginUnitTest_045, TestSize.Level1)
     stateManager->IsScrOffHalfHourCtrl();
     EXPECT_NE(standbyStateManager_, nullptr);
 }
+
+/**
+ * @tc.name: StandbyPluginUnitTest_046
+ * @tc.desc: test state transitions follow STATE_TRANSITION_TABLE and are recorded with durations.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyPluginUnitTest, StandbyPluginUnitTest_046, TestSize.Level1)
+{
+    static_assert(GetTransitionAction(StandbyState::NAP, StandbyState::SLEEP) == TransitionAction::ENTER_STANDBY);
+    static_assert(!IsTransitionValid(StandbyState::WORKING, StandbyState::MAINTENANCE));
+    for (auto &statePtr : standbyStateManager_->indexToState_) {
+        for (uint32_t nextState = StandbyState::WORKING; nextState <= StandbyState::SLEEP; ++nextState) {
+            EXPECT_EQ(statePtr->CheckTransitionValid(nextState),
+                IsTransitionValid(statePtr->GetCurState(), nextState));
+        }
+        EXPECT_FALSE(statePtr->CheckTransitionValid(STANDBY_STATE_NUM));
+    }
+
+    standbyStateManager_->curStatePtr_ = standbyStateManager_->workingStatePtr_;
+    EXPECT_NE(standbyStateManager_->TransitToState(StandbyState::MAINTENANCE), ERR_OK);
+    uint64_t count = standbyStateManager_->transitionStats_[StandbyState::WORKING][StandbyState::DARK].count_;
+    standbyStateManager_->TransitToStateInner(StandbyState::DARK);
+    EXPECT_EQ(standbyStateManager_->transitionStats_[StandbyState::WORKING][StandbyState::DARK].count_, count + 1);
+    StateHistoryRecord record {};
+    EXPECT_TRUE(standbyStateManager_->stateHistory_.GetRecentRecord(0, record));
+    EXPECT_EQ(record.curState_, StandbyState::DARK);
+    EXPECT_EQ(standbyStateManager_->TransitToState(StandbyState::WORKING), ERR_OK);
+
+    std::string result {""};
+    standbyStateManager_->DumpShowDetailInfo({"-D", "-S"}, result);
+    EXPECT_NE(result.find("dark -> working [exit_standby]"), std::string::npos);
+    EXPECT_EQ(result.find("working -> maintenance"), std::string::npos);
+}
+
+/**
+ * @tc.name: StandbyPluginUnitTest_047
+ * @tc.desc: test state history wraps around, survives remapping and sums residency over a window.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyPluginUnitTest, StandbyPluginUnitTest_047, TestSize.Level1)
+{
+    const std::string historyPath = "/data/local/tmp/standby_state_history_test";
+    constexpr uint32_t capacity = 4;
+    std::remove(historyPath.c_str());
+    StateHistory stateHistory {};
+    stateHistory.Init(historyPath, capacity);
+    // working from 0, dark from 100, nap from 300, maintenance from 600, sleep from 700, working from 1000
+    const std::vector<std::pair<int64_t, uint32_t>> transitions = {{0, StandbyState::WORKING},
+        {100, StandbyState::DARK}, {300, StandbyState::NAP}, {600, StandbyState::MAINTENANCE},
+        {700, StandbyState::SLEEP}, {1000, StandbyState::WORKING}};
+    for (const auto& [wallTime, state] : transitions) {
+        StateHistoryRecord record {};
+        record.wallTime_ = wallTime;
+        record.curState_ = static_cast<uint8_t>(state);
+        record.trigger_ = static_cast<uint8_t>(TransitionTrigger::TIMEOUT);
+        stateHistory.Append(record);
+    }
+    EXPECT_EQ(stateHistory.Size(), capacity);
+    EXPECT_EQ(stateHistory.GetWriteCount(), transitions.size());
+    StateHistoryRecord record {};
+    EXPECT_TRUE(stateHistory.GetRecentRecord(capacity - 1, record));
+    EXPECT_EQ(record.curState_, StandbyState::NAP);
+    EXPECT_FALSE(stateHistory.GetRecentRecord(capacity, record));
+
+    // records before nap are overwritten, and the last working state lasts until now
+    StateResidency residency {};
+    stateHistory.GetResidency(0, 1200, 1100, residency);
+    EXPECT_EQ(residency[StandbyState::DARK], 0);
+    EXPECT_EQ(residency[StandbyState::NAP], 300);
+    EXPECT_EQ(residency[StandbyState::MAINTENANCE], 100);
+    EXPECT_EQ(residency[StandbyState::SLEEP], 300);
+    EXPECT_EQ(residency[StandbyState::WORKING], 100);
+    stateHistory.GetResidency(650, 800, 1100, residency);
+    EXPECT_EQ(residency[StandbyState::MAINTENANCE], 50);
+    EXPECT_EQ(residency[StandbyState::SLEEP], 100);
+
+    // the service restarts at 1500, the downtime is not counted as residency of working
+    record = StateHistoryRecord {};
+    record.wallTime_ = 1500;
+    record.curState_ = static_cast<uint8_t>(StandbyState::WORKING);
+    record.trigger_ = static_cast<uint8_t>(TransitionTrigger::SERVICE_START);
+    stateHistory.Append(record);
+    stateHistory.GetResidency(0, 2000, 1600, residency);
+    EXPECT_EQ(residency[StandbyState::SLEEP], 300);
+    EXPECT_EQ(residency[StandbyState::WORKING], 100);
+
+    if (stateHistory.IsPersistent()) {
+        StateHistory reopenedHistory {};
+        EXPECT_TRUE(reopenedHistory.Init(historyPath, capacity));
+        EXPECT_EQ(reopenedHistory.GetWriteCount(), transitions.size() + 1);
+        EXPECT_TRUE(reopenedHistory.GetRecentRecord(0, record));
+        EXPECT_EQ(record.wallTime_, 1500);
+        EXPECT_TRUE(reopenedHistory.Init(historyPath, capacity * 2));
+        EXPECT_EQ(reopenedHistory.Size(), 0);
+    }
+    stateHistory.UnInit();
+    EXPECT_EQ(stateHistory.Size(), 0);
+    std::remove(historyPath.c_str());
+
+    std::vector<int64_t> stateResidency {};
+    EXPECT_EQ(standbyStateManager_->GetStateResidency(1, 0, stateResidency), ERR_STANDBY_INVALID_PARAM);
+    EXPECT_EQ(standbyStateManager_->GetStateResidency(0, INT64_MAX, stateResidency), ERR_OK);
+    EXPECT_EQ(stateResidency.size(), STANDBY_STATE_NUM);
+}
 }  // namespace DevStandbyMgr
 }  // namespace OHOS
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_SERVICES_COMMON_INCLUDE_STANDBY_CLOCK_H
+#define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_SERVICES_COMMON_INCLUDE_STANDBY_CLOCK_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "event_handler.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+/**
+ * source of time, system timers and delayed tasks of standby. time is in ms, trigger time of system timers is
+ * wall time like that of TimeServiceClient.
+ */
+class IStandbyClock {
+public:
+    virtual ~IStandbyClock() = default;
+    virtual int64_t GetWallTimeMs() = 0;
+    virtual int64_t GetMonotonicTimeMs() = 0;
+    virtual int64_t GetBootTimeMs() = 0;
+
+    /**
+     * @brief create a one-shot system timer of type, which may wake the device up.
+     *
+     * @return id of the timer, 0 if failed.
+     */
+    virtual uint64_t CreateTimer(int type, const std::function<void()>& callBack) = 0;
+    virtual bool StartTimer(uint64_t timerId, uint64_t triggerTime) = 0;
+    virtual bool StopTimer(uint64_t timerId) = 0;
+    virtual bool DestroyTimer(uint64_t timerId) = 0;
+
+    /**
+     * @brief run task on handler after delayTime, tasks of the same name are removed together.
+     */
+    virtual void PostTask(const std::shared_ptr<AppExecFwk::EventHandler>& handler,
+        const std::function<void()>& task, const std::string& name, int64_t delayTime = 0) = 0;
+    virtual void RemoveTask(const std::shared_ptr<AppExecFwk::EventHandler>& handler, const std::string& name) = 0;
+};
+
+/**
+ * TimeService and EventHandler.
+ */
+class SystemClock : public IStandbyClock {
+public:
+    int64_t GetWallTimeMs() override;
+    int64_t GetMonotonicTimeMs() override;
+    int64_t GetBootTimeMs() override;
+    uint64_t CreateTimer(int type, const std::function<void()>& callBack) override;
+    bool StartTimer(uint64_t timerId, uint64_t triggerTime) override;
+    bool StopTimer(uint64_t timerId) override;
+    bool DestroyTimer(uint64_t timerId) override;
+    void PostTask(const std::shared_ptr<AppExecFwk::EventHandler>& handler, const std::function<void()>& task,
+        const std::string& name, int64_t delayTime = 0) override;
+    void RemoveTask(const std::shared_ptr<AppExecFwk::EventHandler>& handler, const std::string& name) override;
+};
+
+class StandbyClock {
+public:
+    static std::shared_ptr<IStandbyClock> GetInstance();
+
+    /**
+     * @brief replace the clock used by standby, nullptr restores SystemClock. for simulation only.
+     */
+    static void SetInstance(const std::shared_ptr<IStandbyClock>& clock);
+};
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_SERVICES_COMMON_INCLUDE_STANDBY_CLOCK_H
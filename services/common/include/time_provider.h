@@ -48,15 +48,22 @@ enum TimeConstant : int64_t {
 class TimeProvider {
 public:
     static bool ConvertTimeStampToLocalTime(int64_t curTimeStamp, struct tm& curLocalTime);
+    /**
+     * @brief day or night standby condition, the current one is cached until the next day and night boundary.
+     */
     static uint32_t GetCondition(int64_t afterNextSeconds = 0);
+    // drop the cached condition, called when wall time, time zone or clock changes
+    static void ResetCondition();
     static int64_t GetNapTimeOut();
     static bool TimeDiffToDayNightSwitch(int64_t& timeDiff);
     static int32_t GetRandomDelay(int32_t low, int32_t high);
     static bool DiffToFixedClock(int64_t curTimeStamp, int32_t tmHour, int32_t tmMin, int64_t& timeDiff);
     static int32_t GetCurrentDate();
 
-#ifdef STANDBY_POWER_MANAGER_ENABLE
 private:
+    // condition at wallTime, and ms from wallTime to the next boundary, 0 if unknown
+    static uint32_t CalculateCondition(int64_t wallTime, int64_t& timeToBoundary);
+#ifdef STANDBY_POWER_MANAGER_ENABLE
     static bool IsPowerSaveMode();
 #endif
 };
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_SERVICES_COMMON_INCLUDE_TIMER_MULTIPLEXER_H
+#define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_SERVICES_COMMON_INCLUDE_TIMER_MULTIPLEXER_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "singleton.h"
+#include "wakeup_planner.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+/**
+ * all standby deadlines of the same timer type are kept in one local WakeupPlanner, and share one TimeService
+ * timer armed for the next planned wakeup. creating, starting and stopping a deadline is local, TimeService is
+ * only called when the planned wakeup of a type changes. when a system timer fires, every deadline whose
+ * tolerance window is open fires with it, whatever its type. ids and trigger time are used like those of
+ * TimeServiceClient, trigger time is wall time in ms.
+ */
+class TimerMultiplexer : public std::enable_shared_from_this<TimerMultiplexer> {
+DECLARE_DELAYED_SINGLETON(TimerMultiplexer);
+public:
+    static std::shared_ptr<TimerMultiplexer> GetInstance();
+
+    /**
+     * @brief create a deadline, the timer type is the same as TimedTask created with the same parameters.
+     *
+     * @return id of the deadline, never 0.
+     */
+    uint64_t CreateTimer(bool repeat, uint64_t interval, bool isExact, bool isIdle,
+        const std::function<void()>& callBack);
+    uint64_t CreateTimer(bool repeat, uint64_t interval, int type, const std::function<void()>& callBack);
+
+    /**
+     * @brief start or reschedule a deadline.
+     *
+     * @return false if the deadline does not exist, or the system timer can not be armed.
+     */
+    bool StartTimer(uint64_t timerId, uint64_t triggerTime);
+    bool StopTimer(uint64_t timerId);
+    bool DestroyTimer(uint64_t timerId);
+
+    /**
+     * @brief let a flexible deadline fire up to earlyTolerance ms before or lateTolerance ms after its trigger
+     * time, so that it can share the wakeup of another deadline. takes effect from the next start.
+     */
+    bool SetTimerTolerance(uint64_t timerId, uint64_t earlyTolerance, uint64_t lateTolerance);
+
+    // calls to TimeService made since the process started
+    uint64_t GetTimerIpcCount();
+    // times the system timers fired with due deadlines
+    uint64_t GetWakeupCount();
+    // wakeups the fired deadlines would have needed without tolerance
+    uint64_t GetUncoalescedWakeupCount();
+    void ShellDump(std::string& result);
+
+private:
+    struct Deadline {
+        int type_ {0};
+        bool repeat_ {false};
+        uint64_t interval_ {0};
+        uint64_t earlyTolerance_ {0};
+        uint64_t lateTolerance_ {0};
+        // 0 if the deadline is not started
+        uint64_t triggerTime_ {0};
+        std::function<void()> callBack_ {nullptr};
+    };
+
+    struct TimerChannel {
+        uint64_t systemTimerId_ {0};
+        // trigger time the system timer is armed for, 0 if it is not armed
+        uint64_t armedTime_ {0};
+        // started deadlines
+        WakeupPlanner planner_ {};
+    };
+
+    void OnSystemTimerTriggered(int type);
+    // fire a due deadline and plan its next period, called with timerMutex_ held
+    void TakeDeadline(TimerChannel& channel, uint64_t timerId, uint64_t now, std::set<uint64_t>& triggerTimes,
+        std::vector<std::function<void()>>& callBacks);
+    // arm the system timer of type for its earliest deadline, called with timerMutex_ held
+    bool ArmChannel(int type);
+    void RemoveFromPlanner(uint64_t timerId, Deadline& deadline);
+
+private:
+    std::mutex timerMutex_ {};
+    uint64_t nextTimerId_ {1};
+    std::map<uint64_t, Deadline> deadlineMap_ {};
+    std::map<int, TimerChannel> channelMap_ {};
+    uint64_t timerIpcCount_ {0};
+    uint64_t localOperationCount_ {0};
+    uint64_t triggeredCount_ {0};
+    uint64_t wakeupCount_ {0};
+    uint64_t uncoalescedWakeupCount_ {0};
+};
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_SERVICES_COMMON_INCLUDE_TIMER_MULTIPLEXER_H
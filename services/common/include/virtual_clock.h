@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_SERVICES_COMMON_INCLUDE_VIRTUAL_CLOCK_H
+#define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_SERVICES_COMMON_INCLUDE_VIRTUAL_CLOCK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "standby_clock.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+/**
+ * deterministic clock for simulation. time only moves in Advance, which runs due timers and tasks one by one in
+ * the order of their time and of posting, and jumps over the time between them. all handlers share one queue,
+ * tasks run on the thread calling Advance. the device never suspends, boot time equals monotonic time.
+ */
+class VirtualClock : public IStandbyClock {
+public:
+    explicit VirtualClock(int64_t wallTime, int64_t monotonicTime = 0);
+
+    int64_t GetWallTimeMs() override;
+    int64_t GetMonotonicTimeMs() override;
+    int64_t GetBootTimeMs() override;
+    uint64_t CreateTimer(int type, const std::function<void()>& callBack) override;
+    bool StartTimer(uint64_t timerId, uint64_t triggerTime) override;
+    bool StopTimer(uint64_t timerId) override;
+    bool DestroyTimer(uint64_t timerId) override;
+    void PostTask(const std::shared_ptr<AppExecFwk::EventHandler>& handler, const std::function<void()>& task,
+        const std::string& name, int64_t delayTime = 0) override;
+    void RemoveTask(const std::shared_ptr<AppExecFwk::EventHandler>& handler, const std::string& name) override;
+
+    /**
+     * @brief run everything due in the next duration ms, including what is posted meanwhile.
+     *
+     * @return number of timers and tasks run.
+     */
+    uint64_t AdvanceBy(int64_t duration);
+    uint64_t AdvanceTo(int64_t monotonicTime);
+
+    // monotonic time of the next timer or task, -1 if there is none
+    int64_t GetNextEventTime();
+    size_t GetPendingCount();
+    // timers and tasks run since the clock was created
+    uint64_t GetExecutedCount();
+
+private:
+    struct Event {
+        // 0 for tasks
+        uint64_t timerId_ {0};
+        std::string name_ {};
+        std::function<void()> task_ {nullptr};
+    };
+
+    struct Timer {
+        std::function<void()> callBack_ {nullptr};
+        bool isArmed_ {false};
+        // key of the event in eventMap_ while armed
+        std::pair<int64_t, uint64_t> eventKey_ {0, 0};
+    };
+
+    void AddEvent(int64_t time, Event&& event, std::pair<int64_t, uint64_t>& eventKey);
+    void DisarmTimer(Timer& timer);
+
+private:
+    std::mutex clockMutex_ {};
+    int64_t monotonicTime_ {0};
+    // wall time minus monotonic time
+    int64_t wallTimeOffset_ {0};
+    uint64_t nextTimerId_ {1};
+    uint64_t nextSequence_ {0};
+    uint64_t executedCount_ {0};
+    std::map<uint64_t, Timer> timerMap_ {};
+    // (monotonic time, sequence of posting) to event
+    std::map<std::pair<int64_t, uint64_t>, Event> eventMap_ {};
+};
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_SERVICES_COMMON_INCLUDE_VIRTUAL_CLOCK_H
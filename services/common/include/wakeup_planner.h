@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_SERVICES_COMMON_INCLUDE_WAKEUP_PLANNER_H
+#define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_SERVICES_COMMON_INCLUDE_WAKEUP_PLANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace OHOS {
+namespace DevStandbyMgr {
+/**
+ * plan wakeups for pending deadlines. every deadline may fire anywhere in its tolerance window
+ * [triggerTime - earlyTolerance, triggerTime + lateTolerance]. the device wakes up at the trigger time of the
+ * earliest deadline, later only to meet other deadlines inside its window, and every deadline whose window is
+ * already open fires in the same wakeup.
+ */
+class WakeupPlanner {
+public:
+    void Add(uint64_t id, uint64_t triggerTime, uint64_t earlyTolerance = 0, uint64_t lateTolerance = 0);
+    void Remove(uint64_t id);
+    bool Empty() const;
+    size_t Size() const;
+
+    /**
+     * @brief time the device has to wake up at, 0 if there is no deadline.
+     */
+    uint64_t GetWakeupTime() const;
+
+    /**
+     * @brief remove deadlines whose window is open at now.
+     *
+     * @return ids of removed deadlines, ordered by the time their window closes.
+     */
+    std::vector<uint64_t> TakeDue(uint64_t now);
+
+private:
+    struct Window {
+        uint64_t earliest_ {0};
+        uint64_t trigger_ {0};
+        uint64_t latest_ {0};
+    };
+
+    std::map<uint64_t, Window> windowMap_ {};
+    // (trigger, id), the first one decides the next wakeup
+    std::set<std::pair<uint64_t, uint64_t>> triggerQueue_ {};
+    // (latest, id), the order due deadlines are taken in
+    std::set<std::pair<uint64_t, uint64_t>> latestQueue_ {};
+};
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_SERVICES_COMMON_INCLUDE_WAKEUP_PLANNER_H
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "standby_clock.h"
+
+#include <mutex>
+
+#include "time_provider.h"
+#include "time_service_client.h"
+#include "timed_task.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+namespace {
+std::mutex g_clockMutex;
+std::shared_ptr<IStandbyClock> g_clock = nullptr;
+}
+
+int64_t SystemClock::GetWallTimeMs()
+{
+    return MiscServices::TimeServiceClient::GetInstance()->GetWallTimeMs();
+}
+
+int64_t SystemClock::GetMonotonicTimeMs()
+{
+    return MiscServices::TimeServiceClient::GetInstance()->GetMonotonicTimeMs();
+}
+
+int64_t SystemClock::GetBootTimeMs()
+{
+    return MiscServices::TimeServiceClient::GetInstance()->GetBootTimeMs();
+}
+
+uint64_t SystemClock::CreateTimer(int type, const std::function<void()>& callBack)
+{
+    auto timedTask = std::make_shared<TimedTask>(false, 0, type);
+    timedTask->SetCallbackInfo(callBack);
+    return MiscServices::TimeServiceClient::GetInstance()->CreateTimer(timedTask);
+}
+
+bool SystemClock::StartTimer(uint64_t timerId, uint64_t triggerTime)
+{
+    return MiscServices::TimeServiceClient::GetInstance()->StartTimer(timerId, triggerTime);
+}
+
+bool SystemClock::StopTimer(uint64_t timerId)
+{
+    return MiscServices::TimeServiceClient::GetInstance()->StopTimer(timerId);
+}
+
+bool SystemClock::DestroyTimer(uint64_t timerId)
+{
+    return MiscServices::TimeServiceClient::GetInstance()->DestroyTimer(timerId);
+}
+
+void SystemClock::PostTask(const std::shared_ptr<AppExecFwk::EventHandler>& handler,
+    const std::function<void()>& task, const std::string& name, int64_t delayTime)
+{
+    if (handler == nullptr) {
+        return;
+    }
+    handler->PostTask(task, name, delayTime);
+}
+
+void SystemClock::RemoveTask(const std::shared_ptr<AppExecFwk::EventHandler>& handler, const std::string& name)
+{
+    if (handler == nullptr) {
+        return;
+    }
+    handler->RemoveTask(name);
+}
+
+std::shared_ptr<IStandbyClock> StandbyClock::GetInstance()
+{
+    std::lock_guard<std::mutex> lock(g_clockMutex);
+    if (g_clock == nullptr) {
+        g_clock = std::make_shared<SystemClock>();
+    }
+    return g_clock;
+}
+
+void StandbyClock::SetInstance(const std::shared_ptr<IStandbyClock>& clock)
+{
+    {
+        std::lock_guard<std::mutex> lock(g_clockMutex);
+        g_clock = clock;
+    }
+    // the cached condition expires in boot time of the previous clock
+    TimeProvider::ResetCondition();
+}
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
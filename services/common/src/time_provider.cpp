@@ -15,8 +15,10 @@
 
 #include "time_provider.h"
 
+#include <algorithm>
+#include <atomic>
 #include <random>
-#include "time_service_client.h"
+#include "standby_clock.h"
 #include "timed_task.h"
 #include "standby_service_log.h"
 #include "standby_config_manager.h"
@@ -43,6 +45,15 @@ namespace {
 #ifdef STANDBY_POWER_MANAGER_ENABLE
     constexpr int32_t SAVE_MODE_ENTRANCE_MIN = 1;
 #endif
+    constexpr int64_t DAY_ENTRANCE_SEC = DAY_ENTRANCE_HOUR * SEC_PER_HOUR + DAY_ENTRANCE_MIN * SEC_PER_MIN;
+    constexpr int64_t NIGHT_ENTRANCE_SEC = NIGHT_ENTRANCE_HOUR * SEC_PER_HOUR + NIGHT_ENTRANCE_MIN * SEC_PER_MIN;
+    // local offset may change without any event, e.g. daylight saving, the condition is checked again hourly
+    constexpr int64_t MAX_CONDITION_CACHE_TIME = MSEC_PER_HOUR;
+    constexpr int32_t CONDITION_BITS = 2;
+    constexpr int64_t CONDITION_MASK = (1 << CONDITION_BITS) - 1;
+    // boot time in ms the condition is valid until, shifted by CONDITION_BITS, and the condition in the low bits.
+    // packed into one atomic so that a lookup is a single load and comparison, 0 if nothing is cached
+    std::atomic<int64_t> g_conditionCache {0};
 }
 
 bool TimeProvider::ConvertTimeStampToLocalTime(int64_t curTimeStamp, struct tm& curLocalTime)
@@ -57,25 +68,56 @@ bool TimeProvider::ConvertTimeStampToLocalTime(int64_t curTimeStamp, struct tm&
 
 uint32_t TimeProvider::GetCondition(int64_t afterNextSeconds)
 {
-    int64_t curSecTimeStamp = MiscServices::TimeServiceClient::GetInstance()->GetWallTimeMs() / MSEC_PER_SEC;
+    int64_t timeToBoundary {0};
+    if (afterNextSeconds != 0) {
+        return CalculateCondition(StandbyClock::GetInstance()->GetWallTimeMs() + afterNextSeconds * MSEC_PER_SEC,
+            timeToBoundary);
+    }
+    // boot time keeps going in suspend, the boundary is not missed when the device wakes up
+    int64_t now = StandbyClock::GetInstance()->GetBootTimeMs();
+    int64_t conditionCache = g_conditionCache.load(std::memory_order_acquire);
+    if (now < (conditionCache >> CONDITION_BITS)) {
+        return static_cast<uint32_t>(conditionCache & CONDITION_MASK);
+    }
+    uint32_t condition = CalculateCondition(StandbyClock::GetInstance()->GetWallTimeMs(), timeToBoundary);
+    if (timeToBoundary > 0) {
+        int64_t expireTime = now + std::min(timeToBoundary, MAX_CONDITION_CACHE_TIME);
+        g_conditionCache.store((expireTime << CONDITION_BITS) | condition, std::memory_order_release);
+    }
+    return condition;
+}
+
+uint32_t TimeProvider::CalculateCondition(int64_t wallTime, int64_t& timeToBoundary)
+{
+    timeToBoundary = 0;
     struct tm curLocalTime {};
-    curSecTimeStamp += afterNextSeconds;
-    if (!ConvertTimeStampToLocalTime(curSecTimeStamp, curLocalTime)) {
+    if (!ConvertTimeStampToLocalTime(wallTime / MSEC_PER_SEC, curLocalTime)) {
         STANDBYSERVICE_LOGE("convert time stamp to local time failed");
         return ConditionType::DAY_STANDBY;
     }
     STANDBYSERVICE_LOGD("current local time info: %{public}02d:%{public}02d:%{public}02d", curLocalTime.tm_hour,
         curLocalTime.tm_min, curLocalTime.tm_sec);
-    if ((curLocalTime.tm_hour < NIGHT_ENTRANCE_HOUR || curLocalTime.tm_min < NIGHT_ENTRANCE_MIN) &&
-        (curLocalTime.tm_hour >= DAY_ENTRANCE_HOUR)) {
-        return ConditionType::DAY_STANDBY;
+    int64_t secOfDay = curLocalTime.tm_hour * SEC_PER_HOUR + curLocalTime.tm_min * SEC_PER_MIN + curLocalTime.tm_sec;
+    uint32_t condition = ConditionType::NIGHT_STANDBY;
+    int64_t boundary = DAY_ENTRANCE_SEC;
+    if (secOfDay >= DAY_ENTRANCE_SEC && secOfDay < NIGHT_ENTRANCE_SEC) {
+        condition = ConditionType::DAY_STANDBY;
+        boundary = NIGHT_ENTRANCE_SEC;
+    } else if (secOfDay >= NIGHT_ENTRANCE_SEC) {
+        boundary = DAY_ENTRANCE_SEC + SEC_PER_DAY;
     }
-    return ConditionType::NIGHT_STANDBY;
+    timeToBoundary = (boundary - secOfDay) * MSEC_PER_SEC - wallTime % MSEC_PER_SEC;
+    return condition;
+}
+
+void TimeProvider::ResetCondition()
+{
+    g_conditionCache.store(0, std::memory_order_release);
 }
 
 bool TimeProvider::TimeDiffToDayNightSwitch(int64_t& timeDiff)
 {
-    int64_t curSecTimeStamp = MiscServices::TimeServiceClient::GetInstance()->GetWallTimeMs() / MSEC_PER_SEC;
+    int64_t curSecTimeStamp = StandbyClock::GetInstance()->GetWallTimeMs() / MSEC_PER_SEC;
     bool res {false};
     STANDBYSERVICE_LOGD("condition is %{public}u", GetCondition());
     if (GetCondition() == ConditionType::NIGHT_STANDBY) {
@@ -112,7 +154,7 @@ bool TimeProvider::DiffToFixedClock(int64_t curTimeStamp, int32_t tmHour, int32_
 
 int64_t TimeProvider::GetNapTimeOut()
 {
-    int64_t curSecTimeStamp = MiscServices::TimeServiceClient::GetInstance()->GetWallTimeMs() / MSEC_PER_SEC;
+    int64_t curSecTimeStamp = StandbyClock::GetInstance()->GetWallTimeMs() / MSEC_PER_SEC;
     int32_t napTimeOut = TWENTY_MIN_ENTRANCE_MIN;
     struct tm curLocalTime {};
 #ifdef STANDBY_POWER_MANAGER_ENABLE
@@ -15,10 +15,12 @@
 
 #include "timed_task.h"
 
+#include "standby_clock.h"
 #include "standby_service_log.h"
 #include "common_constant.h"
 #include "time_provider.h"
 #include "standby_config_manager.h"
+#include "timer_multiplexer.h"
 
 namespace OHOS {
 namespace DevStandbyMgr {
@@ -115,8 +117,8 @@ bool WEAK_FUNC TimedTask::StartDayNightSwitchTimer(uint64_t& timeId)
     timeDiff += TimeProvider::GetRandomDelay(LOW_DELAY_TIME_INTERVAL, HIGH_DELAY_TIME_INTERVAL);
     STANDBYSERVICE_LOGI("start next day and night switch after " SPUBI64 " ms", timeDiff);
 
-    auto curTimeStamp = MiscServices::TimeServiceClient::GetInstance()->GetWallTimeMs();
-    if (!MiscServices::TimeServiceClient::GetInstance()->StartTimer(timeId, curTimeStamp + timeDiff)) {
+    auto curTimeStamp = StandbyClock::GetInstance()->GetWallTimeMs();
+    if (!TimerMultiplexer::GetInstance()->StartTimer(timeId, curTimeStamp + timeDiff)) {
         STANDBYSERVICE_LOGE("day and night switch observer start failed");
         return false;
     }
@@ -126,7 +128,7 @@ bool WEAK_FUNC TimedTask::StartDayNightSwitchTimer(uint64_t& timeId)
 bool WEAK_FUNC TimedTask::RegisterDayNightSwitchTimer(uint64_t& timeId, bool repeat, uint64_t interval,
     const std::function<void()>& callBack)
 {
-    timeId = CreateTimer(repeat, interval, false, false, callBack);
+    timeId = TimerMultiplexer::GetInstance()->CreateTimer(repeat, interval, false, false, callBack);
     if (timeId == 0) {
         STANDBYSERVICE_LOGE("create timer failed");
         return false;
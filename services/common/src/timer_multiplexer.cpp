@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "timer_multiplexer.h"
+
+#include <vector>
+
+#include "standby_clock.h"
+#include "standby_service_log.h"
+#include "timed_task.h"
+
+namespace OHOS {
+namespace DevStandbyMgr {
+namespace {
+// deadlines this close to the fired one are handled in the same wakeup, in ms
+constexpr uint64_t TRIGGER_TOLERANCE = 10;
+}
+
+TimerMultiplexer::TimerMultiplexer() {}
+
+TimerMultiplexer::~TimerMultiplexer() {}
+
+std::shared_ptr<TimerMultiplexer> TimerMultiplexer::GetInstance()
+{
+    return DelayedSingleton<TimerMultiplexer>::GetInstance();
+}
+
+uint64_t TimerMultiplexer::CreateTimer(bool repeat, uint64_t interval, bool isExact, bool isIdle,
+    const std::function<void()>& callBack)
+{
+    // the type is decided by TimedTask, so that a multiplexed deadline behaves like a timer of its own
+    TimedTask timedTask(repeat, interval, isExact, isIdle);
+    return CreateTimer(repeat, interval, timedTask.type, callBack);
+}
+
+uint64_t TimerMultiplexer::CreateTimer(bool repeat, uint64_t interval, int type,
+    const std::function<void()>& callBack)
+{
+    std::lock_guard<std::mutex> lock(timerMutex_);
+    uint64_t timerId = nextTimerId_++;
+    deadlineMap_.emplace(timerId, Deadline {type, repeat, interval, 0, 0, 0, callBack});
+    ++localOperationCount_;
+    return timerId;
+}
+
+bool TimerMultiplexer::StartTimer(uint64_t timerId, uint64_t triggerTime)
+{
+    std::lock_guard<std::mutex> lock(timerMutex_);
+    auto iter = deadlineMap_.find(timerId);
+    if (iter == deadlineMap_.end() || triggerTime == 0) {
+        STANDBYSERVICE_LOGW("timer " SPUBI64 " does not exist", timerId);
+        return false;
+    }
+    ++localOperationCount_;
+    auto& deadline = iter->second;
+    RemoveFromPlanner(timerId, deadline);
+    deadline.triggerTime_ = triggerTime;
+    channelMap_[deadline.type_].planner_.Add(timerId, triggerTime, deadline.earlyTolerance_,
+        deadline.lateTolerance_);
+    if (!ArmChannel(deadline.type_)) {
+        RemoveFromPlanner(timerId, deadline);
+        return false;
+    }
+    return true;
+}
+
+bool TimerMultiplexer::SetTimerTolerance(uint64_t timerId, uint64_t earlyTolerance, uint64_t lateTolerance)
+{
+    std::lock_guard<std::mutex> lock(timerMutex_);
+    auto iter = deadlineMap_.find(timerId);
+    if (iter == deadlineMap_.end()) {
+        return false;
+    }
+    iter->second.earlyTolerance_ = earlyTolerance;
+    iter->second.lateTolerance_ = lateTolerance;
+    return true;
+}
+
+bool TimerMultiplexer::StopTimer(uint64_t timerId)
+{
+    std::lock_guard<std::mutex> lock(timerMutex_);
+    auto iter = deadlineMap_.find(timerId);
+    if (iter == deadlineMap_.end()) {
+        return false;
+    }
+    ++localOperationCount_;
+    int type = iter->second.type_;
+    RemoveFromPlanner(timerId, iter->second);
+    return ArmChannel(type);
+}
+
+bool TimerMultiplexer::DestroyTimer(uint64_t timerId)
+{
+    std::lock_guard<std::mutex> lock(timerMutex_);
+    auto iter = deadlineMap_.find(timerId);
+    if (iter == deadlineMap_.end()) {
+        return false;
+    }
+    ++localOperationCount_;
+    int type = iter->second.type_;
+    RemoveFromPlanner(timerId, iter->second);
+    deadlineMap_.erase(iter);
+    return ArmChannel(type);
+}
+
+void TimerMultiplexer::OnSystemTimerTriggered(int type)
+{
+    std::vector<std::function<void()>> callBacks {};
+    {
+        std::lock_guard<std::mutex> lock(timerMutex_);
+        // the system timer is one-shot, it is not armed any more
+        channelMap_[type].armedTime_ = 0;
+        uint64_t now = static_cast<uint64_t>(StandbyClock::GetInstance()->GetWallTimeMs());
+        // the device is awake anyway, deadlines of other types whose window is open ride on this wakeup
+        std::set<uint64_t> triggerTimes {};
+        for (auto& [channelType, channel] : channelMap_) {
+            auto dueIds = channel.planner_.TakeDue(now + TRIGGER_TOLERANCE);
+            for (const auto timerId : dueIds) {
+                TakeDeadline(channel, timerId, now, triggerTimes, callBacks);
+            }
+            if (!dueIds.empty() || channelType == type) {
+                ArmChannel(channelType);
+            }
+        }
+        if (!triggerTimes.empty()) {
+            ++wakeupCount_;
+            // without tolerance, deadlines of different trigger time would have woken the device up separately
+            uncoalescedWakeupCount_ += triggerTimes.size();
+        }
+    }
+    // callbacks may start or stop timers again, so they are invoked without the lock
+    for (const auto& callBack : callBacks) {
+        if (callBack != nullptr) {
+            callBack();
+        }
+    }
+}
+
+void TimerMultiplexer::TakeDeadline(TimerChannel& channel, uint64_t timerId, uint64_t now,
+    std::set<uint64_t>& triggerTimes, std::vector<std::function<void()>>& callBacks)
+{
+    auto& deadline = deadlineMap_[timerId];
+    uint64_t triggerTime = deadline.triggerTime_;
+    triggerTimes.emplace(triggerTime);
+    callBacks.emplace_back(deadline.callBack_);
+    ++triggeredCount_;
+    if (!deadline.repeat_ || deadline.interval_ == 0) {
+        deadline.triggerTime_ = 0;
+        return;
+    }
+    // repeating deadlines keep their own period, firing early or late does not shift them
+    uint64_t nextTime = triggerTime + deadline.interval_;
+    deadline.triggerTime_ = nextTime > now ? nextTime : now + deadline.interval_;
+    channel.planner_.Add(timerId, deadline.triggerTime_, deadline.earlyTolerance_, deadline.lateTolerance_);
+}
+
+bool TimerMultiplexer::ArmChannel(int type)
+{
+    auto& channel = channelMap_[type];
+    if (channel.planner_.Empty()) {
+        if (channel.armedTime_ != 0) {
+            ++timerIpcCount_;
+            StandbyClock::GetInstance()->StopTimer(channel.systemTimerId_);
+            channel.armedTime_ = 0;
+        }
+        return true;
+    }
+    uint64_t earliestTime = channel.planner_.GetWakeupTime();
+    if (earliestTime == channel.armedTime_) {
+        return true;
+    }
+    if (channel.systemTimerId_ == 0) {
+        ++timerIpcCount_;
+        channel.systemTimerId_ = StandbyClock::GetInstance()->CreateTimer(type,
+            [weakMultiplexer = weak_from_this(), type]() {
+                if (auto multiplexer = weakMultiplexer.lock(); multiplexer != nullptr) {
+                    multiplexer->OnSystemTimerTriggered(type);
+                }
+            });
+        if (channel.systemTimerId_ == 0) {
+            STANDBYSERVICE_LOGE("failed to create system timer of type %{public}d", type);
+            return false;
+        }
+    }
+    ++timerIpcCount_;
+    if (!StandbyClock::GetInstance()->StartTimer(channel.systemTimerId_, earliestTime)) {
+        STANDBYSERVICE_LOGE("failed to start system timer of type %{public}d", type);
+        channel.armedTime_ = 0;
+        return false;
+    }
+    channel.armedTime_ = earliestTime;
+    return true;
+}
+
+void TimerMultiplexer::RemoveFromPlanner(uint64_t timerId, Deadline& deadline)
+{
+    if (deadline.triggerTime_ == 0) {
+        return;
+    }
+    channelMap_[deadline.type_].planner_.Remove(timerId);
+    deadline.triggerTime_ = 0;
+}
+
+uint64_t TimerMultiplexer::GetTimerIpcCount()
+{
+    std::lock_guard<std::mutex> lock(timerMutex_);
+    return timerIpcCount_;
+}
+
+uint64_t TimerMultiplexer::GetWakeupCount()
+{
+    std::lock_guard<std::mutex> lock(timerMutex_);
+    return wakeupCount_;
+}
+
+uint64_t TimerMultiplexer::GetUncoalescedWakeupCount()
+{
+    std::lock_guard<std::mutex> lock(timerMutex_);
+    return uncoalescedWakeupCount_;
+}
+
+void TimerMultiplexer::ShellDump(std::string& result)
+{
+    std::lock_guard<std::mutex> lock(timerMutex_);
+    result.append("timer multiplexer, deadlines: ").append(std::to_string(deadlineMap_.size()))
+        .append(" timer ipc: ").append(std::to_string(timerIpcCount_))
+        .append(" local operations: ").append(std::to_string(localOperationCount_))
+        .append(" triggered: ").append(std::to_string(triggeredCount_))
+        .append(" wakeups: ").append(std::to_string(wakeupCount_))
+        .append(" uncoalesced wakeups: ").append(std::to_string(uncoalescedWakeupCount_)).append("\n");
+    for (const auto& [type, channel] : channelMap_) {
+        result.append("  type: ").append(std::to_string(type))
+            .append(" system timer: ").append(std::to_string(channel.systemTimerId_))
+            .append(" armed time: ").append(std::to_string(channel.armedTime_))
+            .append(" started deadlines: ").append(std::to_string(channel.planner_.Size())).append("\n");
+    }
+}
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
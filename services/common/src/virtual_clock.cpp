@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "virtual_clock.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace DevStandbyMgr {
+VirtualClock::VirtualClock(int64_t wallTime, int64_t monotonicTime)
+    : monotonicTime_(monotonicTime), wallTimeOffset_(wallTime - monotonicTime) {}
+
+int64_t VirtualClock::GetWallTimeMs()
+{
+    std::lock_guard<std::mutex> lock(clockMutex_);
+    return monotonicTime_ + wallTimeOffset_;
+}
+
+int64_t VirtualClock::GetMonotonicTimeMs()
+{
+    std::lock_guard<std::mutex> lock(clockMutex_);
+    return monotonicTime_;
+}
+
+int64_t VirtualClock::GetBootTimeMs()
+{
+    return GetMonotonicTimeMs();
+}
+
+uint64_t VirtualClock::CreateTimer(int type, const std::function<void()>& callBack)
+{
+    std::lock_guard<std::mutex> lock(clockMutex_);
+    uint64_t timerId = nextTimerId_++;
+    timerMap_.emplace(timerId, Timer {callBack, false, {0, 0}});
+    return timerId;
+}
+
+bool VirtualClock::StartTimer(uint64_t timerId, uint64_t triggerTime)
+{
+    std::lock_guard<std::mutex> lock(clockMutex_);
+    auto iter = timerMap_.find(timerId);
+    if (iter == timerMap_.end()) {
+        return false;
+    }
+    DisarmTimer(iter->second);
+    // a trigger time in the past fires at once, like that of TimeService
+    int64_t time = std::max(static_cast<int64_t>(triggerTime) - wallTimeOffset_, monotonicTime_);
+    AddEvent(time, Event {timerId, "", nullptr}, iter->second.eventKey_);
+    iter->second.isArmed_ = true;
+    return true;
+}
+
+bool VirtualClock::StopTimer(uint64_t timerId)
+{
+    std::lock_guard<std::mutex> lock(clockMutex_);
+    auto iter = timerMap_.find(timerId);
+    if (iter == timerMap_.end()) {
+        return false;
+    }
+    DisarmTimer(iter->second);
+    return true;
+}
+
+bool VirtualClock::DestroyTimer(uint64_t timerId)
+{
+    std::lock_guard<std::mutex> lock(clockMutex_);
+    auto iter = timerMap_.find(timerId);
+    if (iter == timerMap_.end()) {
+        return false;
+    }
+    DisarmTimer(iter->second);
+    timerMap_.erase(iter);
+    return true;
+}
+
+void VirtualClock::PostTask(const std::shared_ptr<AppExecFwk::EventHandler>& handler,
+    const std::function<void()>& task, const std::string& name, int64_t delayTime)
+{
+    std::lock_guard<std::mutex> lock(clockMutex_);
+    std::pair<int64_t, uint64_t> eventKey {};
+    AddEvent(monotonicTime_ + std::max(delayTime, static_cast<int64_t>(0)), Event {0, name, task}, eventKey);
+}
+
+void VirtualClock::RemoveTask(const std::shared_ptr<AppExecFwk::EventHandler>& handler, const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(clockMutex_);
+    for (auto iter = eventMap_.begin(); iter != eventMap_.end();) {
+        if (iter->second.timerId_ == 0 && iter->second.name_ == name) {
+            iter = eventMap_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+uint64_t VirtualClock::AdvanceBy(int64_t duration)
+{
+    return AdvanceTo(GetMonotonicTimeMs() + std::max(duration, static_cast<int64_t>(0)));
+}
+
+uint64_t VirtualClock::AdvanceTo(int64_t monotonicTime)
+{
+    uint64_t executedCount = 0;
+    while (true) {
+        std::function<void()> task {nullptr};
+        {
+            std::lock_guard<std::mutex> lock(clockMutex_);
+            if (eventMap_.empty() || eventMap_.begin()->first.first > monotonicTime) {
+                monotonicTime_ = std::max(monotonicTime_, monotonicTime);
+                break;
+            }
+            auto iter = eventMap_.begin();
+            monotonicTime_ = std::max(monotonicTime_, iter->first.first);
+            if (iter->second.timerId_ != 0) {
+                auto& timer = timerMap_[iter->second.timerId_];
+                timer.isArmed_ = false;
+                task = timer.callBack_;
+            } else {
+                task = std::move(iter->second.task_);
+            }
+            eventMap_.erase(iter);
+            ++executedCount_;
+        }
+        ++executedCount;
+        // the task may post tasks or start timers again, so it is run without the lock
+        if (task != nullptr) {
+            task();
+        }
+    }
+    return executedCount;
+}
+
+int64_t VirtualClock::GetNextEventTime()
+{
+    std::lock_guard<std::mutex> lock(clockMutex_);
+    return eventMap_.empty() ? -1 : eventMap_.begin()->first.first;
+}
+
+size_t VirtualClock::GetPendingCount()
+{
+    std::lock_guard<std::mutex> lock(clockMutex_);
+    return eventMap_.size();
+}
+
+uint64_t VirtualClock::GetExecutedCount()
+{
+    std::lock_guard<std::mutex> lock(clockMutex_);
+    return executedCount_;
+}
+
+void VirtualClock::AddEvent(int64_t time, Event&& event, std::pair<int64_t, uint64_t>& eventKey)
+{
+    eventKey = {time, nextSequence_++};
+    eventMap_.emplace(eventKey, std::move(event));
+}
+
+void VirtualClock::DisarmTimer(Timer& timer)
+{
+    if (!timer.isArmed_) {
+        return;
+    }
+    eventMap_.erase(timer.eventKey_);
+    timer.isArmed_ = false;
+}
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
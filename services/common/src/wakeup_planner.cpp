@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "wakeup_planner.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace DevStandbyMgr {
+void WakeupPlanner::Add(uint64_t id, uint64_t triggerTime, uint64_t earlyTolerance, uint64_t lateTolerance)
+{
+    Remove(id);
+    Window window {triggerTime > earlyTolerance ? triggerTime - earlyTolerance : 0, triggerTime,
+        triggerTime + lateTolerance};
+    windowMap_.emplace(id, window);
+    triggerQueue_.emplace(window.trigger_, id);
+    latestQueue_.emplace(window.latest_, id);
+}
+
+void WakeupPlanner::Remove(uint64_t id)
+{
+    auto iter = windowMap_.find(id);
+    if (iter == windowMap_.end()) {
+        return;
+    }
+    triggerQueue_.erase(std::make_pair(iter->second.trigger_, id));
+    latestQueue_.erase(std::make_pair(iter->second.latest_, id));
+    windowMap_.erase(iter);
+}
+
+bool WakeupPlanner::Empty() const
+{
+    return windowMap_.empty();
+}
+
+size_t WakeupPlanner::Size() const
+{
+    return windowMap_.size();
+}
+
+uint64_t WakeupPlanner::GetWakeupTime() const
+{
+    if (triggerQueue_.empty()) {
+        return 0;
+    }
+    // waking up at the latest edge would delay every deadline by its whole tolerance, so the wakeup only moves
+    // on to the trigger time of the next deadline while that is still inside every window passed so far
+    uint64_t wakeupTime = triggerQueue_.begin()->first;
+    uint64_t latest = UINT64_MAX;
+    for (const auto& [triggerTime, id] : triggerQueue_) {
+        if (triggerTime > latest) {
+            break;
+        }
+        wakeupTime = triggerTime;
+        latest = std::min(latest, windowMap_.at(id).latest_);
+    }
+    return wakeupTime;
+}
+
+std::vector<uint64_t> WakeupPlanner::TakeDue(uint64_t now)
+{
+    std::vector<uint64_t> dueIds {};
+    for (auto iter = latestQueue_.begin(); iter != latestQueue_.end();) {
+        auto windowIter = windowMap_.find(iter->second);
+        if (windowIter->second.earliest_ > now) {
+            ++iter;
+            continue;
+        }
+        dueIds.emplace_back(iter->second);
+        triggerQueue_.erase(std::make_pair(windowIter->second.trigger_, iter->second));
+        windowMap_.erase(windowIter);
+        iter = latestQueue_.erase(iter);
+    }
+    return dueIds;
+}
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
@@ -19,6 +19,7 @@
 #include <list>
 #include <string>
 #include <cstdint>
+#include "name_interner.h"
 #include "nlohmann/json.hpp"
 
 namespace OHOS {
@@ -35,7 +36,11 @@ struct AllowTime {
 struct AllowRecord {
     AllowRecord() = default;
     AllowRecord(int32_t uid, int32_t pid, const std::string& name, uint32_t allowType)
-        : uid_(uid), pid_(pid), name_(name), allowType_(allowType) {}
+        : uid_(uid), pid_(pid), nameId_(NameInterner::GetInstance().Intern(name)), allowType_(allowType) {}
+    const std::string& GetName() const
+    {
+        return NameInterner::GetInstance().GetName(nameId_);
+    }
     nlohmann::json ParseToJson();
     bool setAllowTime(const nlohmann::json& persistTime);
     bool setAllowRecordField(const nlohmann::json& value);
@@ -43,7 +48,8 @@ struct AllowRecord {
 
     int32_t uid_ {-1};
     int32_t pid_ {-1};
-    std::string name_ {""};
+    // interned bundle or process name, shared with strategies and config
+    NameId nameId_ {INVALID_NAME_ID};
     uint32_t allowType_ {0};
     std::list<AllowTime> allowTimeList_ {};
     uint32_t reasonCode_ {0};
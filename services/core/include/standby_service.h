@@ -71,6 +71,7 @@ public:
     ErrCode ReportPowerOverused(const std::string &module, uint32_t level) override;
     ErrCode PushProxyStateChanged(const uint32_t type, const bool enable) override;
     ErrCode HeartBeatValueChanged(const std::string &tag, int32_t timesTamp) override;
+    ErrCode GetStateResidency(int64_t beginTime, int64_t endTime, std::vector<int64_t>& residency) override;
 private:
     StandbyService(const StandbyService&) = delete;
     StandbyService& operator= (const StandbyService&) = delete;
@@ -22,6 +22,7 @@
 #endif
 
 #include <array>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <list>
@@ -127,6 +128,7 @@ public:
     ErrCode ReportPowerOverused(const std::string &module, uint32_t level);
     ErrCode ReportSceneInfo(uint32_t resType, int64_t value, const std::string &sceneInfo);
     ErrCode HeartBeatValueChanged(const std::string &tag, int32_t timesTamp);
+    ErrCode GetStateResidency(int64_t beginTime, int64_t endTime, std::vector<int64_t>& residency);
 
     void RegisterPluginInner(IConstraintManagerAdapter* constraintManager,
         IListenerManagerAdapter* listenerManager,
@@ -245,12 +247,29 @@ private:
     bool debugMode_ {false};
 };
 
+enum class ChargeState : int32_t {
+    UNKNOWN = 0,
+    CHARGING,
+    DISCHARGING,
+};
+
 class DeviceStateCache {
 DECLARE_DELAYED_SINGLETON(DeviceStateCache);
 public:
     static std::shared_ptr<DeviceStateCache> GetInstance();
     bool SetDeviceState(int32_t type, bool enabled);
     bool GetDeviceState(int32_t type);
+
+    // set by charging and discharging events
+    void SetChargeState(bool isCharging);
+
+    /**
+     * @brief set by a query of the battery service, which may return after a newer event.
+     *
+     * @return true if the state was unknown and is set.
+     */
+    bool InitChargeState(bool isCharging);
+    ChargeState GetChargeState() const;
 private:
     DeviceStateCache(const DeviceStateCache&) = delete;
     DeviceStateCache& operator= (const DeviceStateCache&) = delete;
@@ -259,6 +278,8 @@ private:
     std::mutex mutex_ {};
     const static std::int32_t DEVICE_STATE_NUM = 3;
     std::array<bool, DEVICE_STATE_NUM> deviceState_;
+    // kept apart from deviceState_, which clients report through ReportDeviceStateChanged
+    std::atomic<ChargeState> chargeState_ {ChargeState::UNKNOWN};
 };
 }  // namespace DevStandbyMgr
 }  // namespace OHOS
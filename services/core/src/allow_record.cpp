@@ -22,7 +22,7 @@ nlohmann::json AllowRecord::ParseToJson()
     nlohmann::json value;
     value["uid"] = uid_;
     value["pid"] = pid_;
-    value["name"] = name_;
+    value["name"] = GetName();
     value["allowType"] = allowType_;
     value["reasonCode"] = reasonCode_;
     if (!allowTimeList_.empty()) {
@@ -69,7 +69,7 @@ bool AllowRecord::setAllowRecordField(const nlohmann::json& value)
     }
     this->uid_ = value.at("uid").get<int32_t>();
     this->pid_ = value.at("pid").get<int32_t>();
-    this->name_ = value.at("name").get<std::string>();
+    this->nameId_ = NameInterner::GetInstance().Intern(value.at("name").get<std::string>());
     this->allowType_ = value.at("allowType").get<uint32_t>();
     this->reasonCode_ = value.at("reasonCode").get<uint32_t>();
     return true;
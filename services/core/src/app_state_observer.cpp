@@ -86,6 +86,17 @@ void AppStateObserver::OnForegroundApplicationChanged(const AppExecFwk::AppState
     auto state = appStateData.state;
     auto isFocused = appStateData.isFocused;
     STANDBYSERVICE_LOGD("fg app changed, state: %{public}d, bunddlename: %{public}s", state, bundleName.c_str());
+    if (state == static_cast<int32_t>(AppExecFwk::ApplicationState::APP_STATE_FOREGROUND) ||
+        state == static_cast<int32_t>(AppExecFwk::ApplicationState::APP_STATE_BACKGROUND)) {
+        bool isForeground = state == static_cast<int32_t>(AppExecFwk::ApplicationState::APP_STATE_FOREGROUND);
+        handler_->PostTask([uid = appStateData.uid, isForeground]() {
+            StandbyMessage message(StandbyMessageType::APP_FOREGROUND_STATE_CHANGED);
+            message.want_ = AAFwk::Want{};
+            message.want_->SetParam("uid", uid);
+            message.want_->SetParam("isForeground", isForeground);
+            StandbyServiceImpl::GetInstance()->DispatchEvent(message);
+        });
+    }
     if (state == static_cast<int32_t>(AppExecFwk::ApplicationState::APP_STATE_FOREGROUND) && isFocused) {
         handler_->PostTask([pid, bundleName]() {
             StandbyMessage message(StandbyMessageType::FG_APPLICATION_CHANGED);
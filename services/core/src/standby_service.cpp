@@ -336,6 +336,16 @@ ErrCode StandbyService::HeartBeatValueChanged(const std::string &tag, int32_t ti
     return StandbyServiceImpl::GetInstance()->HeartBeatValueChanged(tag, timesTamp);
 }
 
+ErrCode StandbyService::GetStateResidency(int64_t beginTime, int64_t endTime, std::vector<int64_t>& residency)
+{
+    StandbyHitraceChain traceChain(__func__);
+    if (state_.load() != ServiceRunningState::STATE_RUNNING) {
+        STANDBYSERVICE_LOGW("standby service is not running");
+        return ERR_STANDBY_SYS_NOT_READY;
+    }
+    return StandbyServiceImpl::GetInstance()->GetStateResidency(beginTime, endTime, residency);
+}
+
 void StandbyService::AddPluginSysAbilityListener(int32_t systemAbilityId)
 {
     std::lock_guard<std::mutex> pluginListenerLock(listenedSALock_);
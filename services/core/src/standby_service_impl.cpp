@@ -42,13 +42,14 @@
 #include "json_utils.h"
 #include "res_common_util.h"
 #include "res_sched_event_reporter.h"
+#include "standby_clock.h"
 #include "standby_config_manager.h"
 #include "standby_service.h"
 #include "standby_service_log.h"
 #include "system_ability_definition.h"
 #include "timed_task.h"
+#include "timer_multiplexer.h"
 #include "time_provider.h"
-#include "time_service_client.h"
 #include "tokenid_kit.h"
 #ifdef STANDBY_SERVICE_NETMANAGER_BASE_ENABLE
 #include "net_policy_client.h"
@@ -262,10 +263,7 @@ ErrCode StandbyServiceImpl::UnregisterCommEventObserver()
 ErrCode StandbyServiceImpl::UnregisterTimeObserver()
 {
     std::lock_guard<std::recursive_mutex> lock(timerObserverMutex_);
-    if (!MiscServices::TimeServiceClient::GetInstance()->StopTimer(dayNightSwitchTimerId_)) {
-        STANDBYSERVICE_LOGE("day and night switch observer stop failed");
-    }
-    if (!MiscServices::TimeServiceClient::GetInstance()->DestroyTimer(dayNightSwitchTimerId_)) {
+    if (!TimerMultiplexer::GetInstance()->DestroyTimer(dayNightSwitchTimerId_)) {
         STANDBYSERVICE_LOGE("day and night switch observer destroy failed");
     }
     dayNightSwitchTimerId_ = 0;
@@ -407,7 +405,7 @@ bool StandbyServiceImpl::ParsePersistentData()
     }
     for (auto iter = allowInfoMap_.begin(); iter != allowInfoMap_.end();) {
         auto pidNameIter = pidNameMap.find(iter->second->pid_);
-        if (pidNameIter == pidNameMap.end() || pidNameIter->second != iter->second->name_) {
+        if (pidNameIter == pidNameMap.end() || pidNameIter->second != iter->second->GetName()) {
             allowInfoMap_.erase(iter++);
         } else {
             iter++;
@@ -451,11 +449,11 @@ void StandbyServiceImpl::RecoverTimeLimitedTask()
     for (auto iter = allowInfoMap_.begin(); iter != allowInfoMap_.end(); ++iter) {
         auto &allowTimeList = iter->second->allowTimeList_;
         for (auto allowTimeIter = allowTimeList.begin(); allowTimeIter != allowTimeList.end(); ++allowTimeIter) {
-            auto task = [mgr, uid = iter->second->uid_, name = iter->second->name_] () {
+            auto task = [mgr, uid = iter->second->uid_, name = iter->second->GetName()] () {
                 mgr->UnapplyAllowResInner(uid, name, MAX_ALLOW_TYPE_NUMBER, false);
             };
             int32_t timeOut = static_cast<int32_t>(allowTimeIter->endTime_ -
-                MiscServices::TimeServiceClient::GetInstance()->GetMonotonicTimeMs());
+                StandbyClock::GetInstance()->GetMonotonicTimeMs());
             handler_->PostTask(task, std::max(0, timeOut));
         }
     }
@@ -817,7 +815,7 @@ void StandbyServiceImpl::UpdateRecord(std::shared_ptr<AllowRecord>& allowRecord,
     const std::string& name = resourceRequest.GetName();
     uint32_t allowType = resourceRequest.GetAllowType();
     bool isApp = (resourceRequest.GetReasonCode() == ReasonCodeEnum::REASON_APP_API);
-    int64_t curTime = MiscServices::TimeServiceClient::GetInstance()->GetBootTimeMs();
+    int64_t curTime = StandbyClock::GetInstance()->GetBootTimeMs();
     int64_t endTime {0};
     uint32_t condition = TimeProvider::GetCondition();
     STANDBYSERVICE_LOGI(
@@ -901,7 +899,7 @@ void StandbyServiceImpl::UnapplyAllowResInner(int32_t uid, const std::string& na
     auto& allowRecordPtr = iter->second;
     auto& allowTimeList = allowRecordPtr->allowTimeList_;
     uint32_t removedNumber = 0;
-    int64_t curTime = MiscServices::TimeServiceClient::GetInstance()->GetBootTimeMs();
+    int64_t curTime = StandbyClock::GetInstance()->GetBootTimeMs();
     for (auto it = allowTimeList.begin(); it != allowTimeList.end();) {
         uint32_t allowNumber = allowType & (1 << it->allowTypeIndex_);
         if (allowNumber != 0 && (removeAll || curTime >= it->endTime_)) {
@@ -995,7 +993,7 @@ void StandbyServiceImpl::GetAllowListInner(uint32_t allowType, std::vector<Allow
 void StandbyServiceImpl::GetTemporaryAllowList(uint32_t allowTypeIndex, std::vector<AllowInfo>&
     allowInfoList, uint32_t reasonCode)
 {
-    int64_t curTime = MiscServices::TimeServiceClient::GetInstance()->GetBootTimeMs();
+    int64_t curTime = StandbyClock::GetInstance()->GetBootTimeMs();
     auto findRecordTask = [allowTypeIndex](const auto& it) { return it.allowTypeIndex_ == allowTypeIndex; };
     for (auto& [key, allowRecordPtr] : allowInfoMap_) {
         if ((allowRecordPtr->allowType_ & (1 << allowTypeIndex)) == 0) {
@@ -1011,10 +1009,10 @@ void StandbyServiceImpl::GetTemporaryAllowList(uint32_t allowTypeIndex, std::vec
         }
         int64_t duration =  std::max(static_cast<int64_t>(it->endTime_ - curTime), static_cast<int64_t>(0L));
         if (duration > 0) {
-            allowInfoList.emplace_back((1 << allowTypeIndex), allowRecordPtr->name_, duration);
+            allowInfoList.emplace_back((1 << allowTypeIndex), allowRecordPtr->GetName(), duration);
         } else {
             auto task = [this, allowRecordPtr = allowRecordPtr] () {
-                this->UnapplyAllowResInner(allowRecordPtr->uid_, allowRecordPtr->name_,
+                this->UnapplyAllowResInner(allowRecordPtr->uid_, allowRecordPtr->GetName(),
                     allowRecordPtr->allowType_, false);
             };
             handler_->PostTask(task);
@@ -1056,6 +1054,23 @@ ErrCode StandbyServiceImpl::IsDeviceInStandby(bool& isStandby)
     return ERR_OK;
 }
 
+ErrCode StandbyServiceImpl::GetStateResidency(int64_t beginTime, int64_t endTime, std::vector<int64_t>& residency)
+{
+    if (auto checkRet = CheckCallerPermission(); checkRet != ERR_OK) {
+        STANDBYSERVICE_LOGE("caller permission denied.");
+        return checkRet;
+    }
+
+    if (!IsServiceReady()) {
+        return ERR_STANDBY_SYS_NOT_READY;
+    }
+    ErrCode ret = ERR_OK;
+    handler_->PostSyncTask([this, beginTime, endTime, &residency, &ret]() {
+        ret = standbyStateManager_->GetStateResidency(beginTime, endTime, residency);
+        }, AppExecFwk::EventQueue::Priority::HIGH);
+    return ret;
+}
+
 ErrCode StandbyServiceImpl::GetEligiableRestrictSet(uint32_t allowType, const std::string& strategyName,
     uint32_t resonCode, std::set<std::string>& restrictSet)
 {
@@ -1252,6 +1267,8 @@ void StandbyServiceImpl::HandleScreenStateChanged(const int64_t value)
 
 void StandbyServiceImpl::HandleChargeStateChanged(const int64_t value)
 {
+    // the cache is updated before the event is handled, constraints read it during evaluation
+    DeviceStateCache::GetInstance()->SetChargeState(value == 0);
     auto event = value == 0 ? EventFwk::CommonEventSupport::COMMON_EVENT_CHARGING :
         EventFwk::CommonEventSupport::COMMON_EVENT_DISCHARGING;
     DispatchEvent(StandbyMessage(StandbyMessageType::COMMON_EVENT, event));
@@ -1646,6 +1663,7 @@ void StandbyServiceImpl::AppEventHandler(const uint32_t resType, const int64_t v
                resType == ResourceSchedule::ResType::RES_TYPE_NITZ_TIMEZONE_CHANGED ||
                resType == ResourceSchedule::ResType::RES_TYPE_TIME_CHANGED ||
                resType == ResourceSchedule::ResType::RES_TYPE_NITZ_TIME_CHANGED) {
+        TimeProvider::ResetCondition();
         handler_->PostTask([]() {StandbyServiceImpl::GetInstance()->ResetTimeObserver(); });
     }
 }
@@ -1737,6 +1755,7 @@ void StandbyServiceImpl::DumpUsage(std::string& result)
     "        --config                                            show all info, including config\n"
     "        --reset_state                                       reset parameter, validate debug parameter\n"
     "        --strategy                                          dump strategy info\n"
+    "        --residency {begin} {end}                           time spent in every state, wall time in ms\n"
     "    -E                                                 enter the specified state:\n"
     "        {name of state} {whether skip evalution}       enter the specified state, respectively named\n"
     "                                                            woking, dark, nap, maintenance, sleep\n"
@@ -1789,11 +1808,11 @@ void StandbyServiceImpl::DumpAllowListInfo(std::string& result)
         stream << "No." << index << "\n";
         stream << "\tuid: " << iter->first << "\n";
         stream << "\tallow record: " << "\n";
-        stream << "\t\tname: " << iter->second->name_ << "\n";
+        stream << "\t\tname: " << iter->second->GetName() << "\n";
         stream << "\t\tpid: " << iter->second->pid_ << "\n";
         stream << "\t\tallow type: " << iter->second->allowType_ << "\n";
         stream << "\t\treason code: " << iter->second->reasonCode_ << "\n";
-        int64_t curTime = MiscServices::TimeServiceClient::GetInstance()->GetMonotonicTimeMs();
+        int64_t curTime = StandbyClock::GetInstance()->GetMonotonicTimeMs();
         auto &allowTimeList = iter->second->allowTimeList_;
         for (auto unitIter = allowTimeList.begin();
             unitIter != allowTimeList.end(); ++unitIter) {
@@ -1960,5 +1979,23 @@ bool DeviceStateCache::GetDeviceState(int32_t type)
     STANDBYSERVICE_LOGD("get device state %{public}d, enabled is %{public}d", type, deviceState_[type]);
     return deviceState_[type];
 }
+
+void DeviceStateCache::SetChargeState(bool isCharging)
+{
+    STANDBYSERVICE_LOGD("set charge state, isCharging is %{public}d", isCharging);
+    chargeState_.store(isCharging ? ChargeState::CHARGING : ChargeState::DISCHARGING);
+}
+
+bool DeviceStateCache::InitChargeState(bool isCharging)
+{
+    ChargeState expected = ChargeState::UNKNOWN;
+    return chargeState_.compare_exchange_strong(expected,
+        isCharging ? ChargeState::CHARGING : ChargeState::DISCHARGING);
+}
+
+ChargeState DeviceStateCache::GetChargeState() const
+{
+    return chargeState_.load();
+}
 }  // namespace DevStandbyMgr
 }  // namespace OHOS
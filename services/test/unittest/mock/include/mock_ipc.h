@@ -15,6 +15,11 @@
 
 #ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICES_TEST_MOCK_IPC_H
 #define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICES_TEST_MOCK_IPC_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+
 namespace OHOS {
 namespace DevStandbyMgr {
 class MockIpc {
@@ -23,6 +28,9 @@ public:
     virtual ~MockIpc();
     static void MockStartTimer(bool mockRet);
     static void MockGetTokenTypeFlag(bool mockRet);
+    // interval of aligned timers in local time service, 0 if timers are not aligned
+    static uint32_t GetAdjustTimerInterval();
+    static const std::unordered_set<std::string>& GetTimerExemptionNames();
 };
 }  // namespace DevStandbyMgr
 }  // namespace OHOS
@@ -21,6 +21,8 @@
 namespace {
     bool g_mockStartTimer = true;
     bool g_mockGetTokenTypeFlag = true;
+    uint32_t g_adjustTimerInterval = 0;
+    std::unordered_set<std::string> g_timerExemptionNames {};
 }
 
 namespace OHOS {
@@ -59,6 +61,30 @@ bool TimeServiceClient::DestroyTimer(uint64_t timerId)
 {
     return g_mockStartTimer;
 }
+
+int32_t TimeServiceClient::AdjustTimer(bool isAdjust, uint32_t interval)
+{
+    if (!g_mockStartTimer) {
+        return -1;
+    }
+    g_adjustTimerInterval = isAdjust ? interval : 0;
+    return 0;
+}
+
+int32_t TimeServiceClient::SetTimerExemption(const std::unordered_set<std::string>& nameArr, bool isExemption)
+{
+    if (!g_mockStartTimer) {
+        return -1;
+    }
+    for (const auto& name : nameArr) {
+        if (isExemption) {
+            g_timerExemptionNames.emplace(name);
+        } else {
+            g_timerExemptionNames.erase(name);
+        }
+    }
+    return 0;
+}
 } // namespace MiscServices
 
 namespace Security {
@@ -83,5 +109,15 @@ void MockIpc::MockGetTokenTypeFlag(bool mockRet)
 {
     g_mockGetTokenTypeFlag = mockRet;
 }
+
+uint32_t MockIpc::GetAdjustTimerInterval()
+{
+    return g_adjustTimerInterval;
+}
+
+const std::unordered_set<std::string>& MockIpc::GetTimerExemptionNames()
+{
+    return g_timerExemptionNames;
+}
 }
 }  // namespace OHOS
@@ -14,6 +14,8 @@
  */
 #include <functional>
 #include <chrono>
+#include <map>
+#include <set>
 #include <thread>
 #include <message_parcel.h>
 #include <climits>
@@ -26,6 +28,9 @@
 
 #include "device_standby_switch.h"
 #include "time_provider.h"
+#include "timer_multiplexer.h"
+#include "virtual_clock.h"
+#include "wakeup_planner.h"
 #include "common_event_support.h"
 #include "common_event_observer.h"
 
@@ -83,6 +88,52 @@ namespace {
     {
         g_logMsg = msg;
     }
+
+    /**
+     * replay eight hours of sleep with motion detection every ten minutes and growing maintenance intervals,
+     * return the number of wakeups, and the number of distinct trigger times fired in uncoalescedCount.
+     */
+    uint64_t ReplaySleepNight(bool isFlexible, uint64_t& uncoalescedCount)
+    {
+        constexpr uint64_t detectionId = 0;
+        constexpr uint64_t maintId = 1;
+        constexpr uint64_t nightTime = 8 * TimeConstant::MSEC_PER_HOUR;
+        constexpr uint64_t detectionInterval = 10 * TimeConstant::MSEC_PER_MIN;
+        const std::vector<uint64_t> maintIntervals = {17 * TimeConstant::MSEC_PER_MIN,
+            33 * TimeConstant::MSEC_PER_MIN, 47 * TimeConstant::MSEC_PER_MIN, 95 * TimeConstant::MSEC_PER_MIN};
+        WakeupPlanner planner {};
+        std::map<uint64_t, uint64_t> triggerTimeMap {};
+        size_t maintIndex = 0;
+        auto startDetection = [&](uint64_t triggerTime) {
+            uint64_t tolerance = isFlexible ? TimeConstant::MSEC_PER_MIN : 0;
+            triggerTimeMap[detectionId] = triggerTime;
+            planner.Add(detectionId, triggerTime, tolerance, tolerance);
+        };
+        auto startMaint = [&](uint64_t now) {
+            uint64_t interval = maintIntervals[maintIndex];
+            maintIndex = std::min(maintIndex + 1, maintIntervals.size() - 1);
+            triggerTimeMap[maintId] = now + interval;
+            planner.Add(maintId, now + interval, 0, isFlexible ? interval / 10 : 0);
+        };
+        startDetection(detectionInterval);
+        startMaint(0);
+        uint64_t wakeupCount = 0;
+        uncoalescedCount = 0;
+        for (uint64_t now = planner.GetWakeupTime(); now <= nightTime; now = planner.GetWakeupTime()) {
+            ++wakeupCount;
+            std::set<uint64_t> triggerTimes {};
+            for (const auto id : planner.TakeDue(now)) {
+                triggerTimes.emplace(triggerTimeMap[id]);
+                if (id == detectionId) {
+                    startDetection(triggerTimeMap[id] + detectionInterval);
+                } else {
+                    startMaint(now);
+                }
+            }
+            uncoalescedCount += triggerTimes.size();
+        }
+        return wakeupCount;
+    }
 }
 
 class StandbyServiceUnitTest : public testing::Test {
@@ -1564,5 +1615,223 @@ HWTEST_F(StandbyServiceUnitTest, StandbyServiceUnitTest_069, TestSize.Level1)
     StandbyServiceImpl::GetInstance()->HandleAudioCapturerChanged(value, sceneInfo);
     EXPECT_NE(g_logMsg.find("uid param is invalid"), std::string::npos);
 }
+
+/**
+ * @tc.name: StandbyServiceUnitTest_070
+ * @tc.desc: test deadlines share one system timer and only moving the earliest calls TimeService.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyServiceUnitTest, StandbyServiceUnitTest_070, TestSize.Level1)
+{
+    // a type of its own keeps the channel apart from timers created by other cases
+    constexpr int testTimerType = 1 << 10;
+    auto multiplexer = TimerMultiplexer::GetInstance();
+    uint64_t ipcCount = multiplexer->GetTimerIpcCount();
+    int32_t triggeredCount = 0;
+    auto callBack = [&triggeredCount]() { ++triggeredCount; };
+    uint64_t firstId = multiplexer->CreateTimer(false, 0, testTimerType, callBack);
+    uint64_t secondId = multiplexer->CreateTimer(false, 0, testTimerType, callBack);
+    uint64_t repeatId = multiplexer->CreateTimer(true, TimeConstant::MSEC_PER_MIN, testTimerType, callBack);
+    EXPECT_EQ(multiplexer->GetTimerIpcCount(), ipcCount);
+
+    uint64_t now = static_cast<uint64_t>(MiscServices::TimeServiceClient::GetInstance()->GetWallTimeMs());
+    EXPECT_TRUE(multiplexer->StartTimer(firstId, now + TimeConstant::MSEC_PER_SEC));
+    EXPECT_EQ(multiplexer->GetTimerIpcCount(), ipcCount + 2);
+    EXPECT_TRUE(multiplexer->StartTimer(secondId, now + TimeConstant::MSEC_PER_MIN));
+    EXPECT_TRUE(multiplexer->StartTimer(repeatId, now + TimeConstant::MSEC_PER_HOUR));
+    EXPECT_TRUE(multiplexer->StopTimer(secondId));
+    EXPECT_EQ(multiplexer->GetTimerIpcCount(), ipcCount + 2);
+
+    EXPECT_TRUE(multiplexer->StartTimer(firstId, now - 1));
+    EXPECT_EQ(multiplexer->GetTimerIpcCount(), ipcCount + 3);
+    multiplexer->OnSystemTimerTriggered(testTimerType);
+    EXPECT_EQ(triggeredCount, 1);
+    EXPECT_EQ(multiplexer->GetTimerIpcCount(), ipcCount + 4);
+
+    EXPECT_TRUE(multiplexer->DestroyTimer(repeatId));
+    EXPECT_EQ(multiplexer->GetTimerIpcCount(), ipcCount + 5);
+    EXPECT_FALSE(multiplexer->StartTimer(repeatId, now));
+    multiplexer->DestroyTimer(firstId);
+    multiplexer->DestroyTimer(secondId);
+    std::string result {""};
+    multiplexer->ShellDump(result);
+    EXPECT_NE(result.find("timer multiplexer"), std::string::npos);
+}
+
+/**
+ * @tc.name: StandbyServiceUnitTest_071
+ * @tc.desc: test deadlines with tolerance windows share wakeups.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyServiceUnitTest, StandbyServiceUnitTest_071, TestSize.Level1)
+{
+    // 48 detections and 7 maintenance windows, the one at 50 minutes falls on a detection
+    constexpr uint64_t exactWakeupCount = 54;
+    // maintenance waits for a detection only when one falls inside its window, and 5 wakeups are saved
+    constexpr uint64_t flexibleWakeupCount = 49;
+    uint64_t uncoalescedCount = 0;
+    EXPECT_EQ(ReplaySleepNight(false, uncoalescedCount), exactWakeupCount);
+    EXPECT_EQ(uncoalescedCount, exactWakeupCount);
+    EXPECT_EQ(ReplaySleepNight(true, uncoalescedCount), flexibleWakeupCount);
+    EXPECT_EQ(uncoalescedCount, flexibleWakeupCount + 4);
+
+    // a lone deadline wakes up on time, and moves later only to meet another deadline inside its window
+    WakeupPlanner planner {};
+    planner.Add(0, TimeConstant::MSEC_PER_HOUR, 0, TimeConstant::MSEC_PER_MIN * 6);
+    EXPECT_EQ(planner.GetWakeupTime(), TimeConstant::MSEC_PER_HOUR);
+    planner.Add(1, TimeConstant::MSEC_PER_HOUR + TimeConstant::MSEC_PER_MIN * 5);
+    EXPECT_EQ(planner.GetWakeupTime(), TimeConstant::MSEC_PER_HOUR + TimeConstant::MSEC_PER_MIN * 5);
+    planner.Add(1, TimeConstant::MSEC_PER_HOUR + TimeConstant::MSEC_PER_MIN * 7);
+    EXPECT_EQ(planner.GetWakeupTime(), TimeConstant::MSEC_PER_HOUR);
+
+    // the device woken up for an exact deadline also fires an open window of another type
+    constexpr int exactTimerType = 1 << 11;
+    constexpr int flexibleTimerType = 1 << 12;
+    auto multiplexer = TimerMultiplexer::GetInstance();
+    uint64_t wakeupCount = multiplexer->GetWakeupCount();
+    uint64_t uncoalescedWakeupCount = multiplexer->GetUncoalescedWakeupCount();
+    int32_t triggeredCount = 0;
+    auto callBack = [&triggeredCount]() { ++triggeredCount; };
+    uint64_t exactId = multiplexer->CreateTimer(false, 0, exactTimerType, callBack);
+    uint64_t flexibleId = multiplexer->CreateTimer(false, 0, flexibleTimerType, callBack);
+    EXPECT_TRUE(multiplexer->SetTimerTolerance(flexibleId, TimeConstant::MSEC_PER_HOUR, 0));
+    EXPECT_FALSE(multiplexer->SetTimerTolerance(0, 0, 0));
+    uint64_t now = static_cast<uint64_t>(MiscServices::TimeServiceClient::GetInstance()->GetWallTimeMs());
+    EXPECT_TRUE(multiplexer->StartTimer(exactId, now - 1));
+    EXPECT_TRUE(multiplexer->StartTimer(flexibleId, now + TimeConstant::MSEC_PER_MIN));
+    multiplexer->OnSystemTimerTriggered(exactTimerType);
+    EXPECT_EQ(triggeredCount, 2);
+    EXPECT_EQ(multiplexer->GetWakeupCount(), wakeupCount + 1);
+    EXPECT_EQ(multiplexer->GetUncoalescedWakeupCount(), uncoalescedWakeupCount + 2);
+    multiplexer->DestroyTimer(exactId);
+    multiplexer->DestroyTimer(flexibleId);
+}
+
+/**
+ * @tc.name: StandbyServiceUnitTest_072
+ * @tc.desc: test GetStateResidency.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyServiceUnitTest, StandbyServiceUnitTest_072, TestSize.Level1)
+{
+    StandbyService::GetInstance()->state_ = ServiceRunningState::STATE_RUNNING;
+    std::vector<int64_t> residency {};
+    EXPECT_EQ(StandbyService::GetInstance()->GetStateResidency(0, INT64_MAX, residency), ERR_OK);
+    EXPECT_EQ(residency.size(), StandbyState::SLEEP + 1);
+    EXPECT_EQ(StandbyService::GetInstance()->GetStateResidency(1, 0, residency), ERR_STANDBY_INVALID_PARAM);
+
+    StandbyService::GetInstance()->state_ = ServiceRunningState::STATE_NOT_START;
+    EXPECT_EQ(StandbyService::GetInstance()->GetStateResidency(0, INT64_MAX, residency), ERR_STANDBY_SYS_NOT_READY);
+}
+
+/**
+ * @tc.name: StandbyServiceUnitTest_073
+ * @tc.desc: test a day of deadlines and delayed tasks is simulated on VirtualClock.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyServiceUnitTest, StandbyServiceUnitTest_073, TestSize.Level1)
+{
+    auto clock = std::make_shared<VirtualClock>(MiscServices::TimeServiceClient::GetInstance()->GetWallTimeMs());
+    StandbyClock::SetInstance(clock);
+    // a multiplexer of its own, system timers of the shared one are created by TimeService
+    auto multiplexer = std::make_shared<TimerMultiplexer>();
+    constexpr int testTimerType = 1 << 13;
+    int32_t detectionCount = 0;
+    uint64_t detectionId = multiplexer->CreateTimer(true, TimeConstant::MSEC_PER_MIN * 10, testTimerType,
+        [&detectionCount]() { ++detectionCount; });
+    EXPECT_TRUE(multiplexer->StartTimer(detectionId, clock->GetWallTimeMs() + TimeConstant::MSEC_PER_MIN * 10));
+
+    // hourly maintenance is chained through delayed tasks, and sees both day and night
+    int32_t maintCount = 0;
+    std::set<uint32_t> conditions {};
+    std::function<void()> maintTask = nullptr;
+    maintTask = [&]() {
+        ++maintCount;
+        conditions.emplace(TimeProvider::GetCondition());
+        clock->PostTask(nullptr, maintTask, "maint", TimeConstant::MSEC_PER_HOUR);
+    };
+    clock->PostTask(nullptr, maintTask, "maint", TimeConstant::MSEC_PER_HOUR);
+    clock->PostTask(nullptr, []() {}, "removed", TimeConstant::MSEC_PER_HOUR);
+    clock->RemoveTask(nullptr, "removed");
+
+    EXPECT_EQ(clock->AdvanceBy(TimeConstant::MSEC_PER_DAY), 168);
+    EXPECT_EQ(detectionCount, 144);
+    EXPECT_EQ(maintCount, 24);
+    EXPECT_EQ(conditions.size(), 2);
+    EXPECT_EQ(clock->GetMonotonicTimeMs(), TimeConstant::MSEC_PER_DAY);
+    EXPECT_EQ(multiplexer->GetWakeupCount(), 144);
+
+    clock->RemoveTask(nullptr, "maint");
+    EXPECT_EQ(clock->GetNextEventTime(), TimeConstant::MSEC_PER_DAY + TimeConstant::MSEC_PER_MIN * 10);
+    EXPECT_TRUE(multiplexer->DestroyTimer(detectionId));
+    EXPECT_EQ(clock->GetPendingCount(), 0);
+    StandbyClock::SetInstance(nullptr);
+}
+
+/**
+ * @tc.name: StandbyServiceUnitTest_074
+ * @tc.desc: test the cached day and night condition changes exactly at the boundaries.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyServiceUnitTest, StandbyServiceUnitTest_074, TestSize.Level1)
+{
+    constexpr int32_t halfSecond = 500;
+    time_t curTime = std::time(nullptr);
+    struct tm localTime {};
+    EXPECT_TRUE(TimeProvider::ConvertTimeStampToLocalTime(curTime, localTime));
+    localTime.tm_hour = 23;
+    localTime.tm_min = 44;
+    localTime.tm_sec = 59;
+    localTime.tm_isdst = -1;
+    int64_t beforeNight = static_cast<int64_t>(std::mktime(&localTime)) * TimeConstant::MSEC_PER_SEC + halfSecond;
+    localTime.tm_mday += 1;
+    localTime.tm_hour = 6;
+    localTime.tm_min = 0;
+    localTime.tm_sec = 0;
+    localTime.tm_isdst = -1;
+    int64_t dayEntrance = static_cast<int64_t>(std::mktime(&localTime)) * TimeConstant::MSEC_PER_SEC;
+
+    auto clock = std::make_shared<VirtualClock>(beforeNight, TimeConstant::MSEC_PER_SEC);
+    StandbyClock::SetInstance(clock);
+    EXPECT_EQ(TimeProvider::GetCondition(), ConditionType::DAY_STANDBY);
+    clock->AdvanceBy(halfSecond - 1);
+    EXPECT_EQ(TimeProvider::GetCondition(), ConditionType::DAY_STANDBY);
+    clock->AdvanceBy(1);
+    EXPECT_EQ(TimeProvider::GetCondition(), ConditionType::NIGHT_STANDBY);
+    clock->AdvanceBy(dayEntrance - 1 - clock->GetWallTimeMs());
+    EXPECT_EQ(TimeProvider::GetCondition(), ConditionType::NIGHT_STANDBY);
+    clock->AdvanceBy(1);
+    EXPECT_EQ(TimeProvider::GetCondition(), ConditionType::DAY_STANDBY);
+    TimeProvider::ResetCondition();
+    EXPECT_EQ(TimeProvider::GetCondition(), ConditionType::DAY_STANDBY);
+    StandbyClock::SetInstance(nullptr);
+}
+
+/**
+ * @tc.name: StandbyServiceUnitTest_075
+ * @tc.desc: test charge state of DeviceStateCache follows charging events, and a late query does not override them.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyServiceUnitTest, StandbyServiceUnitTest_075, TestSize.Level1)
+{
+    auto deviceStateCache = DeviceStateCache::GetInstance();
+    deviceStateCache->chargeState_ = ChargeState::UNKNOWN;
+    EXPECT_TRUE(deviceStateCache->InitChargeState(false));
+    EXPECT_EQ(deviceStateCache->GetChargeState(), ChargeState::DISCHARGING);
+    EXPECT_FALSE(deviceStateCache->InitChargeState(true));
+    EXPECT_EQ(deviceStateCache->GetChargeState(), ChargeState::DISCHARGING);
+
+    StandbyServiceImpl::GetInstance()->HandleChargeStateChanged(0);
+    EXPECT_EQ(deviceStateCache->GetChargeState(), ChargeState::CHARGING);
+    StandbyServiceImpl::GetInstance()->HandleChargeStateChanged(1);
+    EXPECT_EQ(deviceStateCache->GetChargeState(), ChargeState::DISCHARGING);
+    deviceStateCache->chargeState_ = ChargeState::UNKNOWN;
+}
 }  // namespace DevStandbyMgr
 }  // namespace OHOS
@@ -546,5 +546,75 @@ HWTEST_F(StandbyUtilsUnitTest, StandbyUtilsUnitTest_028, TestSize.Level1)
     result = StandbyConfigManager::GetInstance()->GetStandbyLadderBatteryList(TAG_BATTERY_THRESHOLD);
     EXPECT_EQ(result.size(), 0);
 }
+
+/**
+ * @tc.name: StandbyUtilsUnitTest_029
+ * @tc.desc: test GetStandbyListParaSet of StandbyConfigManager.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyUtilsUnitTest, StandbyUtilsUnitTest_029, TestSize.Level1)
+{
+    nlohmann::json listParaConfig = nlohmann::json::parse(
+        "{\"test_list_para\":[\"bundleA\",\"bundleB\",1]}", nullptr, false);
+    EXPECT_TRUE(StandbyConfigManager::GetInstance()->ParseStandbyListParaConfig(listParaConfig));
+    auto nameSet = StandbyConfigManager::GetInstance()->GetStandbyListParaSet("test_list_para");
+    ASSERT_NE(nameSet, nullptr);
+    EXPECT_EQ(nameSet->size(), 2);
+    EXPECT_NE(nameSet->find(NameInterner::GetInstance().Find("bundleA")), nameSet->end());
+    EXPECT_EQ(StandbyConfigManager::GetInstance()->GetStandbyListParaSet("not_exist_list_para"), nullptr);
+    StandbyConfigManager::GetInstance()->standbyListParaMap_.erase("test_list_para");
+    StandbyConfigManager::GetInstance()->standbyListParaSetMap_.erase("test_list_para");
+}
+
+/**
+ * @tc.name: StandbyUtilsUnitTest_030
+ * @tc.desc: test GetConditionSensitiveNames of StandbyConfigManager.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyUtilsUnitTest, StandbyUtilsUnitTest_030, TestSize.Level1)
+{
+    std::string content = "[{\"action\":\"allow\",\"condition\":[\"day_standby\",\"night_standby\"],"\
+        "\"apps\":[\"bundleA\"]},{\"action\":\"allow\",\"condition\":[\"day_standby\"],"\
+        "\"apps\":[\"bundleB\",\"bundleC\"]},{\"action\":\"allow\",\"condition\":[\"night_standby\"],"\
+        "\"apps\":[\"bundleC\"]},{\"action\":\"restrict\",\"condition\":[\"night_standby\"],"\
+        "\"processes\":[\"processD\"]}]";
+    nlohmann::json resConfigArray = nlohmann::json::parse(content, nullptr, false);
+    EXPECT_TRUE(StandbyConfigManager::GetInstance()->ParseDefaultResCtrlConfig("TEST_CONDITION", resConfigArray));
+    auto sensitiveNames = StandbyConfigManager::GetInstance()->GetConditionSensitiveNames("TEST_CONDITION");
+    ASSERT_NE(sensitiveNames, nullptr);
+    EXPECT_EQ(sensitiveNames->size(), 2);
+    EXPECT_NE(sensitiveNames->find(NameInterner::GetInstance().Find("bundleB")), sensitiveNames->end());
+    EXPECT_NE(sensitiveNames->find(NameInterner::GetInstance().Find("processD")), sensitiveNames->end());
+    EXPECT_EQ(sensitiveNames->find(NameInterner::GetInstance().Find("bundleC")), sensitiveNames->end());
+    StandbyConfigManager::GetInstance()->defaultResourceConfigMap_.erase("TEST_CONDITION");
+    StandbyConfigManager::GetInstance()->conditionSensitiveNameMap_.erase("TEST_CONDITION");
+}
+
+/**
+ * @tc.name: StandbyUtilsUnitTest_031
+ * @tc.desc: test Intern, Find and GetName of NameInterner.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StandbyUtilsUnitTest, StandbyUtilsUnitTest_031, TestSize.Level1)
+{
+    auto& interner = NameInterner::GetInstance();
+    EXPECT_EQ(interner.Intern(""), INVALID_NAME_ID);
+    EXPECT_EQ(interner.Find("test.interner.never.interned"), INVALID_NAME_ID);
+    size_t size = interner.Size();
+    NameId nameId = interner.Intern("test.interner.bundle");
+    EXPECT_NE(nameId, INVALID_NAME_ID);
+    EXPECT_EQ(interner.Intern(std::string("test.interner.bundle")), nameId);
+    EXPECT_EQ(interner.Find("test.interner.bundle"), nameId);
+    EXPECT_EQ(interner.GetName(nameId), "test.interner.bundle");
+    EXPECT_TRUE(interner.GetName(UINT32_MAX).empty());
+    EXPECT_EQ(interner.Size(), size + 1);
+    NameIdSet nameIds {};
+    interner.FindAll(std::vector<std::string> {"test.interner.bundle", "test.interner.never.interned"}, nameIds);
+    EXPECT_EQ(nameIds.size(), 1);
+    EXPECT_GT(interner.GetMemoryUsage(), 0);
+}
 }  // namespace DevStandbyMgr
 }  // namespace OHOS
@@ -31,6 +31,7 @@ extern const std::string DEFAULT_PLUGIN_NAME;
 
 extern const std::string DETECT_MOTION_CONFIG;
 extern const int32_t REPEATED_MOTION_DETECTION_INTERVAL;
+extern const int32_t REPEATED_MOTION_DETECTION_TOLERANCE;
 extern const std::string DARK_TIMEOUT;
 extern const std::string NAP_TIMEOUT;
 extern const std::string NAP_MAINT_DURATION;
@@ -41,6 +42,9 @@ extern const std::string SLEEP_MAINT_TIMEOUT;
 extern const std::vector<std::string> STATE_NAME_LIST;
 
 extern const std::string MOTION_THREADSHOLD;
+extern const std::string MOTION_DETECTOR;
+extern const std::string MOTION_VARIANCE_THRESHOLD;
+extern const std::string MOTION_JERK_THRESHOLD;
 
 extern const std::string MOTION_DECTION_TASK;
 extern const int32_t MOTION_DETECTION_TIMEOUT;
@@ -52,10 +56,12 @@ extern const int32_t PERIODLY_TASK_TOTAL_TIMEOUT;
 extern const int64_t SENSOR_SAMPLING_RATE;
 extern const int64_t SENSOR_REPORTING_RATE;
 extern const int64_t HALF_HOUR;
+extern const int64_t HALF_HOUR_TOLERANCE;
 
 extern const std::string NAP_SWITCH;
 extern const std::string SLEEP_SWITCH;
 extern const std::string S3_SWITCH;
+extern const std::string STRATEGY_CONCURRENT_SWITCH;
 extern const std::string DEVICE_STANGDY_MODE;
 
 extern const std::string PREVIOUS_STATE;
@@ -103,6 +109,7 @@ extern const std::string DUMP_DAYTIME_SLEEP_MODE;
 extern const std::string DUMP_NIGHTTIME_SLEEP_MODE;
 extern const std::string DUMP_DEBUG_SWITCH;
 extern const std::string DUMP_RESET_STATE;
+extern const std::string DUMP_STATE_RESIDENCY;
 extern const std::string DUMP_DETAIL_CONFIG;
 extern const std::string DUMP_STRATGY_DETAIL;
 extern const std::string DUMP_POWEROFF_STRATEGY;
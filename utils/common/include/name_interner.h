@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_UTILS_COMMON_INCLUDE_NAME_INTERNER_H
+#define FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_UTILS_COMMON_INCLUDE_NAME_INTERNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace OHOS {
+namespace DevStandbyMgr {
+// id of an interned bundle or process name, equal names always get the same id
+using NameId = uint32_t;
+using NameIdSet = std::unordered_set<NameId>;
+constexpr NameId INVALID_NAME_ID = 0;
+
+/**
+ * bundle and process names shared by the whole process. a name is stored once and never released, so
+ * ids and the strings they refer to stay valid until the process exits.
+ */
+class NameInterner {
+public:
+    static NameInterner& GetInstance();
+
+    /**
+     * @brief get id of name, name is stored if it is seen for the first time.
+     *
+     * @return INVALID_NAME_ID if name is empty.
+     */
+    NameId Intern(std::string_view name);
+
+    /**
+     * @brief get id of name without storing it.
+     *
+     * @return INVALID_NAME_ID if name is empty or never interned.
+     */
+    NameId Find(std::string_view name) const;
+
+    /**
+     * @brief collect ids of names already interned, names never interned are skipped.
+     */
+    template<typename Names>
+    void FindAll(const Names& names, NameIdSet& nameIds) const
+    {
+        for (const auto& name : names) {
+            if (NameId nameId = Find(name); nameId != INVALID_NAME_ID) {
+                nameIds.emplace(nameId);
+            }
+        }
+    }
+
+    /**
+     * @brief get the name of id, empty string if id is invalid.
+     */
+    const std::string& GetName(NameId nameId) const;
+
+    size_t Size() const;
+
+    /**
+     * @brief bytes reserved by the interned names and the index over them.
+     */
+    size_t GetMemoryUsage() const;
+
+private:
+    NameInterner();
+    ~NameInterner() = default;
+    NameInterner(const NameInterner&) = delete;
+    NameInterner& operator= (const NameInterner&) = delete;
+
+private:
+    mutable std::shared_mutex nameMutex_ {};
+    // deque keeps names in place, so that the keys of nameIdMap_ and returned references stay valid
+    std::deque<std::string> names_ {};
+    std::unordered_map<std::string_view, NameId> nameIdMap_ {};
+};
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
+#endif  // FOUNDATION_RESOURCESCHEDULE_STANDBY_SERVICE_UTILS_COMMON_INCLUDE_NAME_INTERNER_H
@@ -91,6 +91,7 @@ enum : int32_t {
     ERR_STANDBY_RESTRICTION_CONDITION_NOT_MATCH,
     RR_DATASHARE_OBJECT_NULLPTR,
     RR_DATASHARE_QUERY_FAILED,
+    ERR_STRATEGY_FREEZE_BACKEND_FAILED,
 };
 
 enum ParamErr: int32_t {
@@ -23,6 +23,7 @@ const std::string REPEATED_MOTION_DETECTION_TASK = "MotionDetectionPeriodlyTask"
 
 const std::string DEFAULT_PLUGIN_NAME = "libstandby_plugin.z.so";
 const int32_t REPEATED_MOTION_DETECTION_INTERVAL = 10 * 60 * 1000;
+const int32_t REPEATED_MOTION_DETECTION_TOLERANCE = 60 * 1000;
 const std::string DARK_TIMEOUT = "dark_timeout";
 const std::string NAP_TIMEOUT = "nap_timeout";
 const std::string NAP_MAINTENANCE_TIMEOUT = "nap_maintenance_timeout";
@@ -34,11 +35,15 @@ const std::vector<std::string> STATE_NAME_LIST = {"working", "dark", "nap", "mai
 
 const std::string DETECT_MOTION_CONFIG = "detect_motion";
 const std::string MOTION_THREADSHOLD = "motion_threshold";
+const std::string MOTION_DETECTOR = "motion_detector";
+const std::string MOTION_VARIANCE_THRESHOLD = "motion_variance_threshold";
+const std::string MOTION_JERK_THRESHOLD = "motion_jerk_threshold";
 const std::string MOTION_DECTION_TASK = "motion_dection_task";
 
 const std::string NAP_SWITCH = "nap_switch";
 const std::string SLEEP_SWITCH = "sleep_switch";
 const std::string S3_SWITCH = "s3_switch";
+const std::string STRATEGY_CONCURRENT_SWITCH = "strategy_concurrent_switch";
 const std::string DEVICE_STANGDY_MODE = "device_standby_mode";
 
 const int32_t MOTION_DETECTION_TIMEOUT = 1500;
@@ -52,6 +57,7 @@ const int32_t PERIODLY_TASK_TOTAL_TIMEOUT = 420;
 const int64_t SENSOR_SAMPLING_RATE = 200000000LL; // 200ms
 const int64_t SENSOR_REPORTING_RATE = 0LL;
 const int64_t HALF_HOUR = 1800 * 1000;
+const int64_t HALF_HOUR_TOLERANCE = 300 * 1000;
 
 const std::string PREVIOUS_STATE = "previous_state";
 const std::string CURRENT_STATE = "current_state";
@@ -101,6 +107,7 @@ const std::string DUMP_DAYTIME_SLEEP_MODE = "daytimesleep";
 const std::string DUMP_NIGHTTIME_SLEEP_MODE = "nighttimesleep";
 const std::string DUMP_DEBUG_SWITCH = "debug";
 const std::string DUMP_RESET_STATE = "--reset_state";
+const std::string DUMP_STATE_RESIDENCY = "--residency";
 const std::string DUMP_DETAIL_CONFIG = "--config";
 const std::string DUMP_STRATGY_DETAIL = "--strategy";
 const std::string DUMP_POWEROFF_STRATEGY = "--poweroff";
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "name_interner.h"
+
+#include <mutex>
+
+namespace OHOS {
+namespace DevStandbyMgr {
+namespace {
+// rough heap cost of a node of std::unordered_map besides its value
+constexpr size_t HASH_NODE_OVERHEAD = 2 * sizeof(void*);
+}
+
+NameInterner::NameInterner()
+{
+    // id 0 is reserved for empty name
+    names_.emplace_back();
+}
+
+NameInterner& NameInterner::GetInstance()
+{
+    static NameInterner instance;
+    return instance;
+}
+
+NameId NameInterner::Intern(std::string_view name)
+{
+    if (name.empty()) {
+        return INVALID_NAME_ID;
+    }
+    {
+        std::shared_lock<std::shared_mutex> readLock(nameMutex_);
+        if (auto iter = nameIdMap_.find(name); iter != nameIdMap_.end()) {
+            return iter->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> writeLock(nameMutex_);
+    if (auto iter = nameIdMap_.find(name); iter != nameIdMap_.end()) {
+        return iter->second;
+    }
+    NameId nameId = static_cast<NameId>(names_.size());
+    names_.emplace_back(name);
+    nameIdMap_.emplace(names_.back(), nameId);
+    return nameId;
+}
+
+NameId NameInterner::Find(std::string_view name) const
+{
+    if (name.empty()) {
+        return INVALID_NAME_ID;
+    }
+    std::shared_lock<std::shared_mutex> readLock(nameMutex_);
+    auto iter = nameIdMap_.find(name);
+    return iter == nameIdMap_.end() ? INVALID_NAME_ID : iter->second;
+}
+
+const std::string& NameInterner::GetName(NameId nameId) const
+{
+    std::shared_lock<std::shared_mutex> readLock(nameMutex_);
+    if (nameId >= names_.size()) {
+        return names_.front();
+    }
+    return names_[nameId];
+}
+
+size_t NameInterner::Size() const
+{
+    std::shared_lock<std::shared_mutex> readLock(nameMutex_);
+    return nameIdMap_.size();
+}
+
+size_t NameInterner::GetMemoryUsage() const
+{
+    std::shared_lock<std::shared_mutex> readLock(nameMutex_);
+    size_t usage = nameIdMap_.bucket_count() * sizeof(void*) +
+        nameIdMap_.size() * (sizeof(std::pair<const std::string_view, NameId>) + HASH_NODE_OVERHEAD);
+    for (const auto& name : names_) {
+        usage += sizeof(std::string);
+        // short names are stored inside std::string itself
+        if (name.capacity() >= sizeof(std::string)) {
+            usage += name.capacity() + 1;
+        }
+    }
+    return usage;
+}
+}  // namespace DevStandbyMgr
+}  // namespace OHOS
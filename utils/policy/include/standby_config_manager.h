@@ -22,10 +22,12 @@
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 
 #include "json_utils.h"
+#include "name_interner.h"
 #include "singleton.h"
 #include "standby_service_errors.h"
 namespace OHOS {
@@ -86,6 +88,15 @@ public:
     bool GetHalfHourSwitch(const std::string& switchName);
     std::shared_ptr<std::vector<DefaultResourceConfig>> GetResCtrlConfig(const std::string& switchName);
     std::vector<std::string> GetStandbyListPara(const std::string& paramName);
+    /**
+     * @brief get list parameter as a prebuilt set of interned names, shared until the config is parsed again.
+     */
+    std::shared_ptr<const NameIdSet> GetStandbyListParaSet(const std::string& paramName);
+    /**
+     * @brief get names whose allow or restrict status differs between day standby and night standby,
+     * precomputed when resource control config is parsed.
+     */
+    std::shared_ptr<const NameIdSet> GetConditionSensitiveNames(const std::string& resCtrlKey);
     const std::vector<TimerResourceConfig>& GetTimerResConfig();
     const std::vector<std::string>& GetStrategyConfigList();
     bool GetStrategyConfigList(const std::string& switchName);
@@ -131,6 +142,8 @@ private:
     bool ParseTimerResCtrlConfig(const nlohmann::json& resConfigArray);
     bool ParseDefaultResCtrlConfig(const std::string& resCtrlKey, const nlohmann::json& resConfigArray);
     bool ParseCommonResCtrlConfig(const nlohmann::json& sigleConfigItem, DefaultResourceConfig& resCtrlConfig);
+    void UpdateConditionSensitiveNames(const std::string& resCtrlKey,
+        const std::vector<DefaultResourceConfig>& resCtrlConfig);
     bool ParsePkgTypeList(const nlohmann::json& standbyPkgTypeList);
     void ParseTimeLimitedConfig(const nlohmann::json& singleConfigItem, const std::string& key,
         std::vector<TimeLtdProcess>& resCtrlConfig);
@@ -169,12 +182,14 @@ private:
     std::vector<std::string> strategyList_;
     std::unordered_map<std::string, bool> halfhourSwitchMap_;
     std::unordered_map<std::string, std::shared_ptr<std::vector<DefaultResourceConfig>>> defaultResourceConfigMap_;
+    std::unordered_map<std::string, std::shared_ptr<const NameIdSet>> conditionSensitiveNameMap_;
     std::vector<TimerResourceConfig> timerResConfigList_;
     std::unordered_map<std::string, std::vector<int32_t>> intervalListMap_;
     std::unordered_map<std::string, std::vector<int32_t>> ladderBatteryListMap_;
     std::unordered_map<std::string, std::vector<std::string>> pkgTypeMap_;
     std::unordered_map<std::string, nlohmann::json> standbyStrategyConfigMap_;
     std::unordered_map<std::string, std::vector<std::string>> standbyListParaMap_;
+    std::unordered_map<std::string, std::shared_ptr<const NameIdSet>> standbyListParaSetMap_;
 
     std::unordered_map<std::string, bool> backStandbySwitchMap_;
     std::unordered_map<std::string, int32_t> backStandbyParaMap_;
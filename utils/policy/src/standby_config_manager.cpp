@@ -15,6 +15,7 @@
 
 #include "standby_config_manager.h"
 
+#include <algorithm>
 #include <functional>
 #include <string>
 #include <sstream>
@@ -408,6 +409,18 @@ std::vector<std::string> StandbyConfigManager::GetStandbyListPara(const std::str
     return GetConfigWithName(paramName, standbyListParaMap_);
 }
 
+std::shared_ptr<const NameIdSet> StandbyConfigManager::GetStandbyListParaSet(
+    const std::string& paramName)
+{
+    return GetConfigWithName(paramName, standbyListParaSetMap_);
+}
+
+std::shared_ptr<const NameIdSet> StandbyConfigManager::GetConditionSensitiveNames(
+    const std::string& resCtrlKey)
+{
+    return GetConfigWithName(resCtrlKey, conditionSensitiveNameMap_);
+}
+
 template<typename T>
 T StandbyConfigManager::GetConfigWithName(const std::string& switchName,
     std::unordered_map<std::string, T>& configMap)
@@ -767,10 +780,47 @@ bool StandbyConfigManager::ParseDefaultResCtrlConfig(const std::string& resCtrlK
         defaultResConfigPtr->emplace_back(std::move(defaultResourceConfig));
     }
     defaultResourceConfigMap_[resCtrlKey] = defaultResConfigPtr;
+    UpdateConditionSensitiveNames(resCtrlKey, *defaultResConfigPtr);
     STANDBYSERVICE_LOGI("succeed to parse the config of %{public}s", resCtrlKey.c_str());
     return true;
 }
 
+void StandbyConfigManager::UpdateConditionSensitiveNames(const std::string& resCtrlKey,
+    const std::vector<DefaultResourceConfig>& resCtrlConfig)
+{
+    const uint32_t standbyConditions[] = {ConditionType::DAY_STANDBY, ConditionType::NIGHT_STANDBY};
+    const uint32_t allStandbyConditions = ConditionType::DAY_STANDBY | ConditionType::NIGHT_STANDBY;
+    // conditions in which the name is eligible, first for allow config and second for restrict config
+    std::unordered_map<std::string, std::pair<uint32_t, uint32_t>> nameConditionMap {};
+    for (const auto& config : resCtrlConfig) {
+        uint32_t eligibleConditions = 0;
+        for (const auto standbyCondition : standbyConditions) {
+            for (const auto configCondition : config.conditions_) {
+                if ((standbyCondition & configCondition) == configCondition) {
+                    eligibleConditions |= standbyCondition;
+                    break;
+                }
+            }
+        }
+        auto markName = [&nameConditionMap, &config, eligibleConditions](const std::string& name) {
+            auto& conditionPair = nameConditionMap[name];
+            (config.isAllow_ ? conditionPair.first : conditionPair.second) |= eligibleConditions;
+        };
+        std::for_each(config.apps_.begin(), config.apps_.end(), markName);
+        std::for_each(config.processes_.begin(), config.processes_.end(), markName);
+    }
+    auto sensitiveNames = std::make_shared<NameIdSet>();
+    for (const auto& [name, conditionPair] : nameConditionMap) {
+        if ((conditionPair.first != 0 && conditionPair.first != allStandbyConditions) ||
+            (conditionPair.second != 0 && conditionPair.second != allStandbyConditions)) {
+            sensitiveNames->emplace(NameInterner::GetInstance().Intern(name));
+        }
+    }
+    STANDBYSERVICE_LOGD("condition sensitive name size of %{public}s is %{public}d", resCtrlKey.c_str(),
+        static_cast<int32_t>(sensitiveNames->size()));
+    conditionSensitiveNameMap_[resCtrlKey] = sensitiveNames;
+}
+
 bool StandbyConfigManager::ParseCommonResCtrlConfig(const nlohmann::json& singleConfigItem,
     DefaultResourceConfig& resCtrlConfig)
 {
@@ -867,12 +917,15 @@ bool StandbyConfigManager::ParseStandbyListParaConfig(const nlohmann::json& stan
             continue;
         }
         std::vector<std::string> standbyList;
+        auto standbyNameSet = std::make_shared<NameIdSet>();
         for (const auto& para : element.value()) {
             if (para.is_string()) {
                 standbyList.push_back(para.get<std::string>());
+                standbyNameSet->emplace(NameInterner::GetInstance().Intern(standbyList.back()));
             }
         }
-        standbyListParaMap_[element.key()] = standbyList;
+        standbyListParaSetMap_[element.key()] = standbyNameSet;
+        standbyListParaMap_[element.key()] = std::move(standbyList);
     }
     return ret;
 }